@@ -0,0 +1,142 @@
+import sys
+import os
+import json
+import argparse
+import subprocess
+
+
+# Runs every benchmark scene in a folder on the headless unix port and
+# prints (or writes) JSON with frame time percentiles per scene and per
+# engine phase (from `engine_debug.last_frame()` after every measured
+# frame, so both cover the same `--frames` frames).
+#
+# Example (from the repository root, after building the unix port):
+#   python3 benchmark.py ../micropython/ports/unix/build-standard/micropython Games/TestGames/benchmarks --output results.json
+#
+# Scenes are paths relative to the `filesystem` folder since the unix port
+# uses the working directory as the filesystem root. Scenes should only
+# create nodes, never call `engine.start()`
+
+
+parser = argparse.ArgumentParser(description="Run headless benchmark scenes and output JSON results")
+parser.add_argument("micropython", help="path to the unix port micropython executable")
+parser.add_argument("scenes", help="folder of benchmark scenes, relative to the `filesystem` folder")
+parser.add_argument("--frames", type=int, default=600, help="number of measured frames per scene")
+parser.add_argument("--warmup", type=int, default=30, help="number of unmeasured frames before measuring")
+parser.add_argument("--dt", type=float, default=1000.0/60.0, help="fixed simulated dt in milliseconds")
+parser.add_argument("--output", default=None, help="file to write JSON results to (stdout otherwise)")
+parser.add_argument("--timeout", type=float, default=120.0, help="seconds a scene may run before it's reported as an error")
+arguments = parser.parse_args()
+
+
+RESULT_PREFIX = "BENCHMARK_RESULT:"
+
+# Code that runs inside micropython for each scene
+runner = """
+import engine_main
+import engine
+import engine_debug
+import time
+import json
+
+engine.disable_fps_limit()
+
+scene_globals = {{}}
+exec(open("{scene}").read(), scene_globals)
+
+for i in range({warmup}):
+    engine.tick()
+
+engine_debug.enable_setting(engine_debug.profiler)
+
+frame_times_us = []
+phase_times_us = {{}}
+for i in range({frames}):
+    before = time.ticks_us()
+    engine.tick()
+    frame_times_us.append(time.ticks_diff(time.ticks_us(), before))
+
+    for phase, us in engine_debug.last_frame().items():
+        if phase not in phase_times_us:
+            phase_times_us[phase] = []
+        phase_times_us[phase].append(us)
+
+print("{prefix}" + json.dumps({{"frame_times_us": frame_times_us, "phase_times_us": phase_times_us}}))
+"""
+
+
+def percentile(sorted_values, percent):
+    # Nearest-rank
+    index = max(0, -(-len(sorted_values) * percent // 100) - 1)
+    return sorted_values[int(index)]
+
+
+filesystem_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "filesystem")
+micropython_path = os.path.abspath(arguments.micropython)
+
+environment = dict(os.environ)
+environment["ENGINE_HEADLESS"] = "1"
+environment["ENGINE_HEADLESS_DT_MS"] = str(arguments.dt)
+
+results = {
+    "frames": arguments.frames,
+    "dt_ms": arguments.dt,
+    "scenes": {}
+}
+
+scene_names = sorted(name for name in os.listdir(os.path.join(filesystem_path, arguments.scenes)) if name.endswith(".py"))
+
+for scene_name in scene_names:
+    scene_path = arguments.scenes + "/" + scene_name
+    print("Running " + scene_path + "...", file=sys.stderr)
+
+    code = runner.format(scene=scene_path, warmup=arguments.warmup, frames=arguments.frames, prefix=RESULT_PREFIX)
+    try:
+        process = subprocess.run([micropython_path, "-c", code], cwd=filesystem_path, env=environment, capture_output=True, text=True, timeout=arguments.timeout)
+    except subprocess.TimeoutExpired:
+        # Most likely a scene that runs its own tick loop
+        print("ERROR: " + scene_path + " did not finish within " + str(arguments.timeout) + " seconds", file=sys.stderr)
+        results["scenes"][scene_name] = {"error": "timeout"}
+        continue
+
+    scene_result = None
+    for line in process.stdout.splitlines():
+        if line.startswith(RESULT_PREFIX):
+            scene_result = json.loads(line[len(RESULT_PREFIX):])
+
+    if process.returncode != 0 or scene_result is None:
+        print("ERROR: " + scene_path + " failed:\n" + process.stdout + process.stderr, file=sys.stderr)
+        results["scenes"][scene_name] = {"error": process.returncode}
+        continue
+
+    frame_times_us = sorted(scene_result["frame_times_us"])
+
+    phases = {}
+    for phase, times_us in scene_result["phase_times_us"].items():
+        times_us = sorted(times_us)
+        phases[phase] = {"min_us": times_us[0], "avg_us": sum(times_us) / len(times_us), "p95_us": percentile(times_us, 95), "max_us": times_us[-1]}
+
+    results["scenes"][scene_name] = {
+        "frame_us": {
+            "min": frame_times_us[0],
+            "avg": sum(frame_times_us) / len(frame_times_us),
+            "p50": percentile(frame_times_us, 50),
+            "p95": percentile(frame_times_us, 95),
+            "p99": percentile(frame_times_us, 99),
+            "max": frame_times_us[-1],
+        },
+        "phases": phases
+    }
+
+
+output = json.dumps(results, indent=4)
+
+if arguments.output is None:
+    print(output)
+else:
+    with open(arguments.output, "w") as output_file:
+        output_file.write(output)
+
+# Non-zero exit so CI notices broken scenes
+if any("error" in scene for scene in results["scenes"].values()):
+    sys.exit(1)
@@ -0,0 +1,27 @@
+# Benchmark scene: an opaque full-screen background sprite under a few
+# moving sprites. The background covers the whole screen so clearing the
+# framebuffer between frames is skipped
+import engine_draw
+from engine_nodes import Sprite2DNode, CameraNode
+from engine_resources import TextureResource
+from engine_math import Vector2
+
+camera = CameraNode()
+background = Sprite2DNode(texture=TextureResource(128, 128, engine_draw.navy))
+texture = TextureResource(16, 16, engine_draw.white)
+
+
+class Bouncer(Sprite2DNode):
+    def __init__(self, x, y):
+        super().__init__(self)
+        self.texture = texture
+        self.position = Vector2(x, y)
+        self.step = 1
+
+    def tick(self, dt):
+        self.position.x += self.step
+        if self.position.x >= 56 or self.position.x <= -56:
+            self.step = -self.step
+
+
+bouncers = [Bouncer(i * 12 - 48, i * 12 - 48) for i in range(8)]
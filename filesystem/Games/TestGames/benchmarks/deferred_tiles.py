@@ -0,0 +1,33 @@
+# Benchmark scene: many overlapping rotating sprites, rectangles and
+# circles drawn with `engine_draw.set_deferred(True)`. Every primitive
+# is recorded and then rasterized one 32x32 tile at a time
+import engine_draw
+from engine_nodes import Sprite2DNode, Rectangle2DNode, Circle2DNode, CameraNode
+from engine_resources import TextureResource
+from engine_math import Vector2
+
+engine_draw.set_deferred(True)
+
+camera = CameraNode()
+texture = TextureResource(24, 24, engine_draw.orange)
+
+
+class Spinner(Sprite2DNode):
+    def __init__(self, x, y):
+        super().__init__(self)
+        self.texture = texture
+        self.position = Vector2(x, y)
+        self.opacity = 0.75
+
+    def tick(self, dt):
+        self.rotation += dt
+
+
+nodes = []
+
+for i in range(36):
+    nodes.append(Spinner((i % 6) * 22 - 55, (i // 6) * 22 - 55))
+
+for i in range(8):
+    nodes.append(Rectangle2DNode(position=Vector2(0, i * 16 - 56), width=128, height=6, color=engine_draw.skyblue, opacity=0.5))
+    nodes.append(Circle2DNode(position=Vector2(i * 16 - 56, 0), radius=10, color=engine_draw.green))
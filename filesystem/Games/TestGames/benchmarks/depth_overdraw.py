@@ -0,0 +1,57 @@
+# Benchmark scene: a stack of textured walls in front of the camera drawn
+# nearest first, like chunks of a voxel world sorted near to far. Every
+# wall behind the first one is hidden, whole 8x8 tiles of them are
+# rejected against the farthest depth stored in the tile instead of
+# testing each pixel. Scenes in this folder only create nodes,
+# `benchmark.py` does the ticking
+import engine_draw
+from engine_nodes import CameraNode, MeshNode
+from engine_math import Vector2, Vector3
+from engine_resources import MeshResource, TextureResource
+import math
+
+
+class SwayingCamera(CameraNode):
+    def __init__(self):
+        super().__init__(self)
+        self.t = 0.0
+
+    def tick(self, dt):
+        # Sway a little so the walls don't line up with the tiles
+        self.t += 0.02
+        self.position.x = math.sin(self.t) * 3
+
+
+camera = SwayingCamera()
+camera.position = Vector3(0, 0, 12)
+
+texture = TextureResource(32, 32, engine_draw.orange)
+
+
+def add_quad(to_add_to, v1, v2, v3, v4, v1uv, v2uv, v3uv, v4uv):
+    to_add_to.vertices.append(v1)
+    to_add_to.uvs.append(v1uv)
+
+    to_add_to.vertices.append(v3)
+    to_add_to.uvs.append(v3uv)
+
+    to_add_to.vertices.append(v2)
+    to_add_to.uvs.append(v2uv)
+
+    to_add_to.vertices.append(v3)
+    to_add_to.uvs.append(v3uv)
+
+    to_add_to.vertices.append(v1)
+    to_add_to.uvs.append(v1uv)
+
+    to_add_to.vertices.append(v4)
+    to_add_to.uvs.append(v4uv)
+
+
+walls = []
+
+for i in range(12):
+    z = -i * 2
+    mesh = MeshResource()
+    add_quad(mesh, Vector3(-12, -12, z), Vector3(12, -12, z), Vector3(12, 12, z), Vector3(-12, 12, z), Vector2(0, 0), Vector2(0, 1), Vector2(1, 1), Vector2(1, 0))
+    walls.append(MeshNode(mesh=mesh, texture=texture))
@@ -0,0 +1,21 @@
+# Draw micro-benchmark: a screen full of unrotated 16x16 sprites, which
+# take the axis aligned fast path. Half of the sprites set a transparent
+# color. Compare the `draw` phase from `benchmark.py` against
+# `blit_16x16_rotated.py`
+import engine_draw
+from engine_nodes import Sprite2DNode, CameraNode
+from engine_resources import TextureResource
+from engine_math import Vector2
+
+camera = CameraNode()
+texture = TextureResource(16, 16, engine_draw.white)
+sprites = []
+
+for i in range(64):
+    sprite = Sprite2DNode(texture=texture, rotation=0)
+    sprite.position = Vector2((i % 8) * 16 - 64 + 8, (i // 8) * 16 - 64 + 8)
+
+    if i % 2 == 0:
+        sprite.transparent_color = engine_draw.black
+
+    sprites.append(sprite)
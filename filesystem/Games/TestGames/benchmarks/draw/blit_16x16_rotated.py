@@ -0,0 +1,19 @@
+# Draw micro-benchmark: same as `blit_16x16_aligned.py` but very slightly
+# rotated so every sprite takes the general rotate/scale path
+import engine_draw
+from engine_nodes import Sprite2DNode, CameraNode
+from engine_resources import TextureResource
+from engine_math import Vector2
+
+camera = CameraNode()
+texture = TextureResource(16, 16, engine_draw.white)
+sprites = []
+
+for i in range(64):
+    sprite = Sprite2DNode(texture=texture, rotation=0.001)
+    sprite.position = Vector2((i % 8) * 16 - 64 + 8, (i // 8) * 16 - 64 + 8)
+
+    if i % 2 == 0:
+        sprite.transparent_color = engine_draw.black
+
+    sprites.append(sprite)
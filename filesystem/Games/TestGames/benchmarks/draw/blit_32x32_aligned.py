@@ -0,0 +1,21 @@
+# Draw micro-benchmark: a screen full of unrotated 32x32 sprites, which
+# take the axis aligned fast path. Half of the sprites set a transparent
+# color. Compare the `draw` phase from `benchmark.py` against
+# `blit_32x32_rotated.py`
+import engine_draw
+from engine_nodes import Sprite2DNode, CameraNode
+from engine_resources import TextureResource
+from engine_math import Vector2
+
+camera = CameraNode()
+texture = TextureResource(32, 32, engine_draw.white)
+sprites = []
+
+for i in range(16):
+    sprite = Sprite2DNode(texture=texture, rotation=0)
+    sprite.position = Vector2((i % 4) * 32 - 64 + 16, (i // 4) * 32 - 64 + 16)
+
+    if i % 2 == 0:
+        sprite.transparent_color = engine_draw.black
+
+    sprites.append(sprite)
@@ -0,0 +1,19 @@
+# Draw micro-benchmark: same as `blit_32x32_aligned.py` but very slightly
+# rotated so every sprite takes the general rotate/scale path
+import engine_draw
+from engine_nodes import Sprite2DNode, CameraNode
+from engine_resources import TextureResource
+from engine_math import Vector2
+
+camera = CameraNode()
+texture = TextureResource(32, 32, engine_draw.white)
+sprites = []
+
+for i in range(16):
+    sprite = Sprite2DNode(texture=texture, rotation=0.001)
+    sprite.position = Vector2((i % 4) * 32 - 64 + 16, (i // 4) * 32 - 64 + 16)
+
+    if i % 2 == 0:
+        sprite.transparent_color = engine_draw.black
+
+    sprites.append(sprite)
@@ -0,0 +1,25 @@
+# Benchmark scene: thick and thin lines at every angle plus outlined and
+# filled circles, many of them hanging off the edges of the screen so
+# they get clipped. Scenes in this folder only create nodes,
+# `benchmark.py` does the ticking
+import engine_draw
+from engine_nodes import Circle2DNode, Line2DNode, CameraNode
+from engine_math import Vector2
+import math
+
+camera = CameraNode()
+nodes = []
+
+for i in range(64):
+    angle = i * math.pi / 32
+    length = 40 + (i % 4) * 20
+    end = Vector2(math.cos(angle) * length, math.sin(angle) * length)
+
+    nodes.append(Line2DNode(start=Vector2(0, 0), end=end, thickness=1 + (i % 3) * 3, color=engine_draw.red))
+    nodes.append(Line2DNode(start=Vector2(0, 0), end=end, thickness=6, color=engine_draw.green, outline=True))
+
+for i in range(48):
+    x = (i % 8) * 24 - 84
+    y = (i // 8) * 24 - 60
+
+    nodes.append(Circle2DNode(position=Vector2(x, y), radius=6 + (i % 5) * 4, color=engine_draw.blue, outline=(i % 2 == 0)))
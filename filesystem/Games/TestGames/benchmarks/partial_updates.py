@@ -0,0 +1,35 @@
+# Benchmark scene: a 2048 style board where one tile slides at a time,
+# drawn with `engine_draw.set_partial_updates(True)`
+import engine_draw
+from engine_nodes import Rectangle2DNode, Text2DNode, CameraNode
+from engine_math import Vector2
+
+engine_draw.set_partial_updates(True)
+
+camera = CameraNode()
+board = Rectangle2DNode(width=120, height=120, color=engine_draw.darkgrey)
+
+tiles = []
+
+for i in range(16):
+    tile = Rectangle2DNode(position=Vector2((i % 4) * 30 - 45, (i // 4) * 30 - 45), width=26, height=26, color=engine_draw.orange)
+    tile.add_child(Text2DNode(text=str(2 ** (i % 11 + 1))))
+    tiles.append(tile)
+
+
+class Slider(Rectangle2DNode):
+    def __init__(self):
+        super().__init__(self)
+        self.width = 26
+        self.height = 26
+        self.color = engine_draw.gold
+        self.position = Vector2(-45, -45)
+        self.step = 1
+
+    def tick(self, dt):
+        self.position.x += self.step
+        if self.position.x >= 45 or self.position.x <= -45:
+            self.step = -self.step
+
+
+slider = Slider()
@@ -0,0 +1,11 @@
+# Benchmark scene: physics circles falling onto a static floor
+from engine_nodes import PhysicsCircle2DNode, PhysicsRectangle2DNode, CameraNode
+from engine_math import Vector2
+
+camera = CameraNode()
+
+floor = PhysicsRectangle2DNode(position=Vector2(0, 60), width=128, height=8, dynamic=False)
+circles = []
+
+for i in range(40):
+    circles.append(PhysicsCircle2DNode(position=Vector2((i % 10) * 10 - 45, (i // 10) * 10 - 50), radius=4))
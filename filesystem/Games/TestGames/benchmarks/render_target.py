@@ -0,0 +1,52 @@
+# Benchmark scene: a HUD panel made of many rectangles and text nodes
+# is rendered into a texture once with `engine_draw.render()` and shown
+# by a single sprite. The panel's nodes sit in a layer that is kept off
+# the screen (along with the camera used to render it) and the panel is
+# only rendered again when its score changes
+import engine
+import engine_draw
+from engine_nodes import Sprite2DNode, Rectangle2DNode, Text2DNode, CameraNode
+from engine_resources import TextureResource
+from engine_math import Vector2, Rectangle
+
+PANEL_LAYER = 1
+
+engine.layer_offscreen(PANEL_LAYER, True)
+
+camera = CameraNode()
+panel_camera = CameraNode(viewport=Rectangle(0, 0, 128, 32), layer=PANEL_LAYER)
+panel_texture = TextureResource(128, 32)
+
+panel_nodes = []
+
+for i in range(32):
+    panel_nodes.append(Rectangle2DNode(position=Vector2((i % 16) * 8 - 60, (i // 16) * 8 - 12), width=6, height=6, color=engine_draw.skyblue, layer=PANEL_LAYER))
+
+score = Text2DNode(position=Vector2(0, 8), text="SCORE 0", layer=PANEL_LAYER)
+panel_nodes.append(score)
+
+panel = Sprite2DNode(position=Vector2(0, -48), texture=panel_texture)
+
+
+class Counter(Rectangle2DNode):
+    def __init__(self):
+        super().__init__(self)
+        self.width = 16
+        self.height = 16
+        self.color = engine_draw.orange
+        self.frames = 0
+        self.points = 0
+        engine_draw.render(panel_texture, panel_camera, PANEL_LAYER, engine_draw.black)
+
+    def tick(self, dt):
+        self.rotation += dt
+        self.frames += 1
+
+        # Only re-render the panel when what it shows changed
+        if self.frames % 30 == 0:
+            self.points += 10
+            score.text = "SCORE " + str(self.points)
+            engine_draw.render(panel_texture, panel_camera, PANEL_LAYER, engine_draw.black)
+
+
+counter = Counter()
@@ -0,0 +1,25 @@
+# Benchmark scene: a 512x512 map of tiles that the camera scrolls across,
+# so most tiles are off screen every frame. Check how many were culled
+# with `engine_debug.draw_stats()`
+import engine_draw
+from engine_nodes import Rectangle2DNode, CameraNode
+from engine_math import Vector2, Vector3
+
+
+class ScrollingCamera(CameraNode):
+    def __init__(self):
+        super().__init__(self)
+
+    def tick(self, dt):
+        self.position.x = (self.position.x + 1) % 384
+        self.position.y = (self.position.y + 0.5) % 384
+
+
+camera = ScrollingCamera()
+camera.position = Vector3(0, 0, 0)
+tiles = []
+
+for y in range(32):
+    for x in range(32):
+        color = engine_draw.green if (x + y) % 2 == 0 else engine_draw.darkgreen
+        tiles.append(Rectangle2DNode(position=Vector2(x * 16, y * 16), width=16, height=16, color=color))
@@ -0,0 +1,42 @@
+# Benchmark scene: overlapping sprites and rectangles using each kind of
+# `engine_draw.Shader` effect (flash, tint, palette swap, additive, dither)
+import engine_draw
+from engine_draw import Shader
+from engine_nodes import Sprite2DNode, Rectangle2DNode, CameraNode
+from engine_resources import TextureResource
+from engine_math import Vector2
+
+camera = CameraNode()
+texture = TextureResource(32, 32, engine_draw.white)
+
+shaders = [
+    Shader().flash(engine_draw.red),
+    Shader().tint(engine_draw.blue, 0.5),
+    Shader().remap(engine_draw.white, engine_draw.orange),
+    Shader().multiply(engine_draw.skyblue).brightness(1.5).additive(),
+    Shader().dither(),
+]
+
+
+class FlashingSprite(Sprite2DNode):
+    def __init__(self, shader):
+        super().__init__(self)
+        self.texture = texture
+        self.shader = shader
+        self.opacity = 0.5
+        self.time = 0
+
+    def tick(self, dt):
+        # Toggle the effect like a hit flash would
+        self.time += dt
+        self.opacity = 0.5 + (self.time % 1.0) * 0.5
+
+
+nodes = []
+
+for i in range(40):
+    nodes.append(FlashingSprite(shaders[i % len(shaders)]))
+    nodes[-1].position = Vector2((i % 8) * 14 - 49, (i // 8) * 24 - 48)
+
+for i in range(5):
+    nodes.append(Rectangle2DNode(position=Vector2(0, i * 24 - 48), width=128, height=16, color=engine_draw.green, opacity=0.5, shader=shaders[i]))
@@ -0,0 +1,19 @@
+# Benchmark scene: many small 2D shapes, no Python callbacks. Scenes in
+# this folder only create nodes, `benchmark.py` does the ticking
+import engine_draw
+from engine_nodes import Rectangle2DNode, Circle2DNode, Line2DNode, CameraNode
+from engine_math import Vector2
+
+camera = CameraNode()
+nodes = []
+
+for i in range(600):
+    x = (i % 24) * 5 - 60
+    y = (i // 24) * 5 - 60
+
+    if i % 3 == 0:
+        nodes.append(Rectangle2DNode(position=Vector2(x, y), width=4, height=4, color=engine_draw.green))
+    elif i % 3 == 1:
+        nodes.append(Circle2DNode(position=Vector2(x, y), radius=2, color=engine_draw.blue))
+    else:
+        nodes.append(Line2DNode(start=Vector2(x, y), end=Vector2(x+4, y+4), color=engine_draw.red))
@@ -0,0 +1,26 @@
+# Benchmark scene: rotated and scaled sprites with Python tick callbacks
+import engine_draw
+from engine_nodes import Sprite2DNode, CameraNode
+from engine_resources import TextureResource
+from engine_math import Vector2
+
+camera = CameraNode()
+texture = TextureResource(32, 32, engine_draw.white)
+
+
+class SpinningSprite(Sprite2DNode):
+    def __init__(self):
+        super().__init__(self)
+        self.texture = texture
+
+    def tick(self, dt):
+        self.rotation += dt
+
+
+sprites = []
+
+for i in range(64):
+    sprite = SpinningSprite()
+    sprite.position = Vector2((i % 8) * 16 - 56, (i // 8) * 16 - 56)
+    sprite.scale = Vector2(0.5, 0.5)
+    sprites.append(sprite)
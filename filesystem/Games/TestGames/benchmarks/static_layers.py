@@ -0,0 +1,51 @@
+# Benchmark scene: a 512x512 map of tiles in a static layer under a
+# player that moves around it. The map is drawn into a cache once and
+# every frame starts from it, moving the camera by whole pixels only
+# draws the edges of the map that scrolled onto the screen
+import engine
+import engine_draw
+from engine_nodes import Rectangle2DNode, CameraNode
+from engine_math import Vector2, Vector3
+
+MAP_LAYER = 0
+PLAYER_LAYER = 1
+
+engine.layer_static(MAP_LAYER, True)
+
+
+class FollowCamera(CameraNode):
+    def __init__(self):
+        super().__init__(self)
+
+    def tick(self, dt):
+        self.position.x = player.position.x
+        self.position.y = player.position.y
+
+
+class Player(Rectangle2DNode):
+    def __init__(self):
+        super().__init__(self)
+        self.width = 10
+        self.height = 10
+        self.color = engine_draw.red
+        self.layer = PLAYER_LAYER
+        self.position = Vector2(64, 64)
+        self.step = 1
+
+    def tick(self, dt):
+        self.position.x += self.step
+        if self.position.x >= 448 or self.position.x <= 64:
+            self.step = -self.step
+            self.position.y = (self.position.y + 16) % 448
+
+
+tiles = []
+
+for y in range(32):
+    for x in range(32):
+        color = engine_draw.green if (x + y) % 2 == 0 else engine_draw.darkgreen
+        tiles.append(Rectangle2DNode(position=Vector2(x * 16, y * 16), width=16, height=16, color=color, layer=MAP_LAYER))
+
+player = Player()
+camera = FollowCamera()
+camera.position = Vector3(64, 64, 0)
@@ -0,0 +1,42 @@
+# Benchmark scene: flat shaded vector art drawn straight into the screen
+# buffer with `engine_draw.triangle()` and `engine_draw.polygon()` from a
+# node's tick. Has a fan of long thin triangles, a few large ones
+# covering most of the screen and a spinning polygon to compare the cost
+# of each kind. Scenes in this folder only create nodes, `benchmark.py`
+# does the ticking
+import engine_draw
+from engine_nodes import EmptyNode
+import math
+
+thin = []
+for i in range(24):
+    angle = i * math.pi / 12
+    thin.append(((64, 64), (64 + 90 * math.cos(angle), 64 + 90 * math.sin(angle)), (64 + 90 * math.cos(angle + 0.02), 64 + 90 * math.sin(angle + 0.02))))
+
+large = [
+    ((-20, -20), (150, -10), (-10, 150)),
+    ((148, -20), (140, 148), (-20, 140)),
+]
+
+
+class VectorArt(EmptyNode):
+    def __init__(self):
+        super().__init__(self)
+        self.angle = 0.0
+
+    def tick(self, dt):
+        for a, b, c in large:
+            engine_draw.triangle(engine_draw.navy, a, b, c, 0.5)
+
+        for a, b, c in thin:
+            engine_draw.triangle(engine_draw.yellow, a, b, c)
+
+        self.angle += 0.02
+        points = []
+        for i in range(6):
+            points.append((64 + 30 * math.cos(self.angle + i * math.pi / 3), 64 + 30 * math.sin(self.angle + i * math.pi / 3)))
+
+        engine_draw.polygon(engine_draw.orange, points)
+
+
+art = VectorArt()
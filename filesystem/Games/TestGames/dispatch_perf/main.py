@@ -0,0 +1,87 @@
+# Measures the per-frame cost of ticking and drawing a large number of
+# mixed node types. Run on builds before/after engine changes and compare
+# the average frame times printed at the end
+import engine_main
+import engine
+import engine_draw
+from engine_nodes import EmptyNode, Sprite2DNode, Rectangle2DNode, Circle2DNode, Text2DNode, Line2DNode, CameraNode
+from engine_math import Vector2
+import time
+import gc
+
+engine.disable_fps_limit()
+
+
+class TickingEmpty(EmptyNode):
+    def __init__(self):
+        super().__init__(self)
+        self.count = 0
+
+    def tick(self, dt):
+        self.count += 1
+
+
+class TickingRectangle(Rectangle2DNode):
+    def __init__(self):
+        super().__init__(self)
+        self.width = 2
+        self.height = 2
+
+    def tick(self, dt):
+        self.rotation += dt
+
+
+camera = CameraNode()
+
+NODE_COUNT = 1200
+nodes = []
+
+for i in range(NODE_COUNT):
+    kind = i % 8
+    x = (i % 32) * 4 - 64
+    y = ((i // 32) % 32) * 4 - 64
+
+    if kind == 0:
+        node = EmptyNode()
+    elif kind == 1:
+        node = TickingEmpty()
+    elif kind == 2:
+        node = Sprite2DNode(position=Vector2(x, y))
+    elif kind == 3:
+        node = Rectangle2DNode(position=Vector2(x, y), width=2, height=2, color=engine_draw.green)
+    elif kind == 4:
+        node = TickingRectangle()
+        node.position = Vector2(x, y)
+    elif kind == 5:
+        node = Circle2DNode(position=Vector2(x, y), radius=1, color=engine_draw.blue)
+    elif kind == 6:
+        node = Line2DNode(start=Vector2(x, y), end=Vector2(x+2, y+2), color=engine_draw.red)
+    else:
+        node = Text2DNode(position=Vector2(x, y), text="a")
+
+    node.layer = i % 4
+    nodes.append(node)
+
+gc.collect()
+
+
+# Warm up a few frames so first-frame work is not measured
+for i in range(10):
+    engine.tick()
+
+
+frames = 300
+frame_total_us = 0
+frame_max_us = 0
+
+for i in range(frames):
+    before = time.ticks_us()
+    engine.tick()
+    frame_us = time.ticks_diff(time.ticks_us(), before)
+
+    frame_total_us += frame_us
+    if frame_us > frame_max_us:
+        frame_max_us = frame_us
+
+
+print("-[dispatch_perf, nodes: " + str(NODE_COUNT) + ", avg. frame: " + str(frame_total_us / frames) + "us, max frame: " + str(frame_max_us) + "us]-")
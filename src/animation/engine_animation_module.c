@@ -22,7 +22,7 @@ void engine_animation_init(){
 }
 
 
-void engine_animation_tick(float dt_ms){
+void engine_animation_tick(mp_obj_t dt_ms_obj){
     linked_list_node *current = animation_list.start;
     mp_obj_t exec[3];
 
@@ -35,20 +35,20 @@ void engine_animation_tick(float dt_ms){
             if(tween->during != mp_const_none && tween->finished == false){
                 exec[0] = tween->during;
                 exec[1] = tween->self;
-                exec[2] = mp_obj_new_float(dt_ms);
+                exec[2] = dt_ms_obj;
                 mp_call_method_n_kw(1, 0, exec);
             }
 
             exec[0] = tween->tick;
             exec[1] = tween->self;
-            exec[2] = mp_obj_new_float(dt_ms);
+            exec[2] = dt_ms_obj;
             mp_call_method_n_kw(1, 0, exec);
         }else{
             delay_class_obj_t *delay = current->object;
 
             exec[0] = delay->tick;
             exec[1] = delay->self;
-            exec[2] = mp_obj_new_float(dt_ms);
+            exec[2] = dt_ms_obj;
 
             mp_call_method_n_kw(1, 0, exec);
         }
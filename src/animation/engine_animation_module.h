@@ -21,7 +21,8 @@ enum engine_animation_ease_types {engine_animation_ease_linear,
 linked_list_node* engine_animation_track(mp_obj_t animation_element);
 void engine_animation_untrack(linked_list_node *list_node);
 void engine_animation_init();
-void engine_animation_tick(float dt);
+// `dt_ms_obj` is the float object shared by all tweens and delays this frame
+void engine_animation_tick(mp_obj_t dt_ms_obj);
 
 
 #endif
\ No newline at end of file
@@ -8,6 +8,8 @@
 #include "math/vector2.h"
 #include "math/vector3.h"
 #include "draw/engine_color.h"
+#include "display/engine_display_damage.h"
+#include "draw/engine_draw_static.h"
 #include <string.h>
 
 #include "../lib/cglm/include/cglm/ease.h"
@@ -106,6 +108,8 @@ void set_value_to_end(tween_class_obj_t *tween){
     }else if(tween->tween_type == tween_type_color){
         color_class_obj_t *value = tweening_value;
         value->value = engine_color_from_rgb_float(tween->end_0, tween->end_1, tween->end_2);
+        engine_display_damage_invalidate();
+        engine_draw_static_invalidate();
     }
 }
 
@@ -249,6 +253,10 @@ static mp_obj_t tween_class_tick(mp_obj_t self_in, mp_obj_t dt_obj){
         // https://www.alanzucconi.com/2016/01/06/colour-interpolation/#:~:text=can%20be%20done-,as%20such,-%3A
         // Lame way of interpolating RGB: TODO
         value->value = engine_color_from_rgb_float(r0 + (r1 - r0) * t, g0 + (g1 - g0) * t, b0 + (b1 - b0) * t);
+
+        // Colors are changed in place, can't tell which nodes use it
+        engine_display_damage_invalidate();
+        engine_draw_static_invalidate();
     }
 
     return mp_const_none;
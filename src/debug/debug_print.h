@@ -16,6 +16,8 @@ void print_binary(uint32_t number, uint32_t bit_count);
 #define DEBUG_SETTING_WARNINGS      1
 #define DEBUG_SETTING_ERRORS        2
 #define DEBUG_SETTING_PERFORMANCE   3
+#define DEBUG_SETTING_PROFILER      4
+#define DEBUG_SETTING_NODE_PROFILER 5
 
 extern bool DEBUG_INFO_ENABLED;
 extern bool DEBUG_WARNINGS_ENABLED;
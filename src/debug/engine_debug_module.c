@@ -1,6 +1,9 @@
 #include "py/obj.h"
 
 #include "debug_print.h"
+#include "engine_debug_profiler.h"
+#include "engine_debug_node_profiler.h"
+#include "nodes/3D/camera_node.h"
 
 
 /*  --- doc ---
@@ -14,6 +17,8 @@ static mp_obj_t engine_debug_disable_all(){
     DEBUG_WARNINGS_ENABLED = false;
     DEBUG_ERRORS_ENABLED = false;
     DEBUG_PERFORMANCE_ENABLED = false;
+    engine_profiler_disable();
+    engine_node_profiler_disable();
     ENGINE_FORCE_PRINTF("Disabled all debug prints");
     return mp_const_none;
 }
@@ -31,6 +36,8 @@ static mp_obj_t engine_debug_enable_all(){
     DEBUG_WARNINGS_ENABLED = true;
     DEBUG_ERRORS_ENABLED = true;
     DEBUG_PERFORMANCE_ENABLED = true;
+    engine_profiler_enable();
+    engine_node_profiler_enable();
     ENGINE_FORCE_PRINTF("Enabled all debug prints");
     return mp_const_none;
 }
@@ -41,7 +48,7 @@ MP_DEFINE_CONST_FUN_OBJ_0(engine_debug_enable_all_obj, engine_debug_enable_all);
     NAME: enable_setting
     ID: enable_setting
     DESC: Enables a debug level/output
-    PARAM: [type=enum/int]   [name=debug_setting]   [value=enum/int 0 ~ 3]
+    PARAM: [type=enum/int]   [name=debug_setting]   [value=enum/int 0 ~ 5]
     RETURN: None
 */ 
 static mp_obj_t engine_debug_enable_setting(mp_obj_t debug_setting){
@@ -65,6 +72,14 @@ static mp_obj_t engine_debug_enable_setting(mp_obj_t debug_setting){
             DEBUG_PERFORMANCE_ENABLED = true;
             ENGINE_FORCE_PRINTF("Enabled performance debug prints");
         break;
+        case DEBUG_SETTING_PROFILER:
+            engine_profiler_enable();
+            ENGINE_FORCE_PRINTF("Enabled frame profiler");
+        break;
+        case DEBUG_SETTING_NODE_PROFILER:
+            engine_node_profiler_enable();
+            ENGINE_FORCE_PRINTF("Enabled node profiler");
+        break;
     }
 
     return mp_const_none;
@@ -72,6 +87,64 @@ static mp_obj_t engine_debug_enable_setting(mp_obj_t debug_setting){
 MP_DEFINE_CONST_FUN_OBJ_1(engine_debug_enable_setting_obj, engine_debug_enable_setting);
 
 
+/*  --- doc ---
+    NAME: frame_stats
+    ID: frame_stats
+    DESC: Gets timing stats of the last 64 frames for each phase of the engine tick, recorded while the `profiler` setting is enabled (see {ref_link:enable_setting}). Returns a dict with a `frames` count and, per phase (`physics`, `io`, `animation`, `tick`, `delete`, `draw`, `gui`, `display`, `depth_clear` and `frame` for the total), a tuple of (min, avg, p95, max) in microseconds
+    RETURN: dict
+*/ 
+static mp_obj_t engine_debug_frame_stats(){
+    return engine_profiler_get_stats();
+}
+MP_DEFINE_CONST_FUN_OBJ_0(engine_debug_frame_stats_obj, engine_debug_frame_stats);
+
+
+/*  --- doc ---
+    NAME: last_frame
+    ID: last_frame
+    DESC: Gets how long each phase of the engine tick took in the last frame recorded while the `profiler` setting is enabled (see {ref_link:enable_setting}). Call it after every {ref_link:engine_tick} to collect more frames than the 64 {ref_link:frame_stats} covers. Returns a dict of the same phases as {ref_link:frame_stats} to times in microseconds, empty if no frame was recorded yet
+    RETURN: dict
+*/ 
+static mp_obj_t engine_debug_last_frame(){
+    return engine_profiler_get_last_frame();
+}
+MP_DEFINE_CONST_FUN_OBJ_0(engine_debug_last_frame_obj, engine_debug_last_frame);
+
+
+/*  --- doc ---
+    NAME: node_stats
+    ID: node_stats
+    DESC: Gets the most expensive nodes over the last second, recorded while the `node_profiler` setting is enabled (see {ref_link:enable_setting}). Returns a list of (class name, node type, layer, tick time, draw time) tuples, times in microseconds, sorted by total time (most expensive first), and how many tick/draw samples were dropped over that second because more than 192 nodes were timed. At most 16 nodes are kept
+    PARAM: [type=int (optional)] [name=count] [value=max number of nodes to return, default 10]
+    RETURN: tuple of (list, dropped)
+*/ 
+static mp_obj_t engine_debug_node_stats(size_t n_args, const mp_obj_t *args){
+    uint16_t count = 10;
+
+    if(n_args == 1){
+        count = mp_obj_get_int(args[0]);
+    }
+
+    return engine_node_profiler_get_report(count);
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(engine_debug_node_stats_obj, 0, 1, engine_debug_node_stats);
+
+
+/*  --- doc ---
+    NAME: draw_stats
+    ID: draw_stats
+    DESC: Gets how many 2D node draws were culled for being entirely off screen during the last frame. Each node is counted once per camera. Always recorded, no setting needs to be enabled
+    RETURN: tuple of (drawn, culled)
+*/ 
+static mp_obj_t engine_debug_draw_stats(){
+    mp_obj_t stats[2];
+    stats[0] = mp_obj_new_int(engine_camera_get_drawn_count());
+    stats[1] = mp_obj_new_int(engine_camera_get_culled_count());
+    return mp_obj_new_tuple(2, stats);
+}
+MP_DEFINE_CONST_FUN_OBJ_0(engine_debug_draw_stats_obj, engine_debug_draw_stats);
+
+
 /*  --- doc ---
     NAME: engine_debug
     ID: engine_debug
@@ -79,20 +152,32 @@ MP_DEFINE_CONST_FUN_OBJ_1(engine_debug_enable_setting_obj, engine_debug_enable_s
     ATTR: [type=function]   [name={ref_link:enable_all}]        [value=function] 
     ATTR: [type=function]   [name={ref_link:disable_all}]       [value=function]
     ATTR: [type=function]   [name={ref_link:enable_setting}]    [value=function]
+    ATTR: [type=function]   [name={ref_link:frame_stats}]       [value=function]
+    ATTR: [type=function]   [name={ref_link:last_frame}]        [value=function]
+    ATTR: [type=function]   [name={ref_link:node_stats}]        [value=function]
+    ATTR: [type=function]   [name={ref_link:draw_stats}]        [value=function]
     ATTR: [type=enum/int]   [name=info]                         [value=0]
     ATTR: [type=enum/int]   [name=warnings]                     [value=1]
     ATTR: [type=enum/int]   [name=errors]                       [value=2]
     ATTR: [type=enum/int]   [name=performance]                  [value=3]
+    ATTR: [type=enum/int]   [name=profiler]                     [value=4]
+    ATTR: [type=enum/int]   [name=node_profiler]                [value=5]
 */ 
 static const mp_rom_map_elem_t engine_debug_globals_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR___name__), MP_OBJ_NEW_QSTR(MP_QSTR_engine_debug) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_enable_all), (mp_obj_t)&engine_debug_enable_all_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_disable_all), (mp_obj_t)&engine_debug_disable_all_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_enable_setting), (mp_obj_t)&engine_debug_enable_setting_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_frame_stats), (mp_obj_t)&engine_debug_frame_stats_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_last_frame), (mp_obj_t)&engine_debug_last_frame_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_node_stats), (mp_obj_t)&engine_debug_node_stats_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_draw_stats), (mp_obj_t)&engine_debug_draw_stats_obj },
     { MP_ROM_QSTR(MP_QSTR_info), MP_ROM_INT(DEBUG_SETTING_INFO) },
     { MP_ROM_QSTR(MP_QSTR_warnings), MP_ROM_INT(DEBUG_SETTING_WARNINGS) },
     { MP_ROM_QSTR(MP_QSTR_errors), MP_ROM_INT(DEBUG_SETTING_ERRORS) },
     { MP_ROM_QSTR(MP_QSTR_performance), MP_ROM_INT(DEBUG_SETTING_PERFORMANCE) },
+    { MP_ROM_QSTR(MP_QSTR_profiler), MP_ROM_INT(DEBUG_SETTING_PROFILER) },
+    { MP_ROM_QSTR(MP_QSTR_node_profiler), MP_ROM_INT(DEBUG_SETTING_NODE_PROFILER) },
 };
 
 // Module init
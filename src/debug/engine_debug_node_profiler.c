@@ -0,0 +1,206 @@
+#include "engine_debug_node_profiler.h"
+#include "debug_print.h"
+#include "utility/engine_time.h"
+
+#include "py/obj.h"
+#include "py/objtuple.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+typedef struct{
+    engine_node_base_t *node_base;  // NULL if this slot is unused
+    qstr class_name;                // Stored so the report doesn't touch (possibly deleted) nodes
+    uint8_t type;
+    uint8_t layer;
+    uint32_t tick_us;
+    uint32_t draw_us;
+}engine_node_profiler_entry_t;
+
+
+bool DEBUG_NODE_PROFILER_ENABLED = false;
+
+// Open addressing table keyed by node pointer, only
+// allocated while the node profiler is enabled
+engine_node_profiler_entry_t *engine_node_profiler_entries = NULL;
+uint16_t engine_node_profiler_entry_count = 0;
+
+// Tick and draw samples not added for not fitting in the table, for
+// the current window and for the last finished one
+uint32_t engine_node_profiler_dropped = 0;
+uint32_t engine_node_profiler_top_dropped = 0;
+
+// Most expensive nodes from the last finished window, sorted
+engine_node_profiler_entry_t engine_node_profiler_top[ENGINE_NODE_PROFILER_TOP_COUNT];
+uint16_t engine_node_profiler_top_count = 0;
+
+uint32_t engine_node_profiler_window_start_ms = 0;
+
+
+void engine_node_profiler_enable(){
+    if(engine_node_profiler_entries == NULL){
+        engine_node_profiler_entries = calloc(ENGINE_NODE_PROFILER_CAPACITY, sizeof(engine_node_profiler_entry_t));
+
+        if(engine_node_profiler_entries == NULL){
+            ENGINE_ERROR_PRINTF("Node profiler: Could not allocate node cost table, not enabling");
+            return;
+        }
+    }
+
+    // Enabling again while enabled starts over
+    memset(engine_node_profiler_entries, 0, sizeof(engine_node_profiler_entry_t) * ENGINE_NODE_PROFILER_CAPACITY);
+    engine_node_profiler_entry_count = 0;
+    engine_node_profiler_dropped = 0;
+    engine_node_profiler_top_count = 0;
+    engine_node_profiler_top_dropped = 0;
+    engine_node_profiler_window_start_ms = millis();
+    DEBUG_NODE_PROFILER_ENABLED = true;
+}
+
+
+void engine_node_profiler_disable(){
+    DEBUG_NODE_PROFILER_ENABLED = false;
+
+    free(engine_node_profiler_entries);
+    engine_node_profiler_entries = NULL;
+}
+
+
+static inline uint32_t engine_node_profiler_entry_total(engine_node_profiler_entry_t *entry){
+    return entry->tick_us + entry->draw_us;
+}
+
+
+// Returns the entry for `node_base`, creating it if needed, or NULL if the table is full
+// (counted as dropped) or gone (a callback that was just timed can disable the profiler
+// and free the table)
+static engine_node_profiler_entry_t *engine_node_profiler_get_entry(engine_node_base_t *node_base){
+    if(engine_node_profiler_entries == NULL){
+        return NULL;
+    }
+
+    // Nodes are at least word aligned, drop the low bits before hashing
+    uint32_t index = (((uintptr_t)node_base) >> 3) % ENGINE_NODE_PROFILER_CAPACITY;
+
+    // Never more than `ENGINE_NODE_PROFILER_MAX_TRACKED` slots are used,
+    // the probe always ends at the node's slot or an unused one
+    while(true){
+        engine_node_profiler_entry_t *entry = &engine_node_profiler_entries[index];
+
+        if(entry->node_base == node_base){
+            return entry;
+        }else if(entry->node_base == NULL){
+            if(engine_node_profiler_entry_count == ENGINE_NODE_PROFILER_MAX_TRACKED){
+                engine_node_profiler_dropped++;
+                return NULL;
+            }
+
+            engine_node_profiler_entry_count++;
+            entry->node_base = node_base;
+            entry->class_name = mp_obj_get_type(node_base->attr_accessor)->name;
+            entry->type = node_base->type;
+            entry->layer = node_base->layer;
+            entry->tick_us = 0;
+            entry->draw_us = 0;
+            return entry;
+        }
+
+        index = (index + 1) % ENGINE_NODE_PROFILER_CAPACITY;
+    }
+}
+
+
+void engine_node_profiler_add_tick(engine_node_base_t *node_base, uint32_t us){
+    engine_node_profiler_entry_t *entry = engine_node_profiler_get_entry(node_base);
+
+    if(entry != NULL){
+        entry->tick_us += us;
+    }
+}
+
+
+void engine_node_profiler_add_draw(engine_node_base_t *node_base, uint32_t us){
+    engine_node_profiler_entry_t *entry = engine_node_profiler_get_entry(node_base);
+
+    if(entry != NULL){
+        entry->draw_us += us;
+    }
+}
+
+
+void engine_node_profiler_window_check(){
+    if(millis_diff(millis(), engine_node_profiler_window_start_ms) < ENGINE_NODE_PROFILER_WINDOW_MS){
+        return;
+    }
+
+    engine_node_profiler_window_start_ms = millis();
+    engine_node_profiler_top_count = 0;
+    engine_node_profiler_top_dropped = engine_node_profiler_dropped;
+
+    // Keep the most expensive entries sorted by insertion
+    for(uint16_t iex=0; iex<ENGINE_NODE_PROFILER_CAPACITY; iex++){
+        engine_node_profiler_entry_t *entry = &engine_node_profiler_entries[iex];
+
+        if(entry->node_base == NULL){
+            continue;
+        }
+
+        uint32_t total = engine_node_profiler_entry_total(entry);
+
+        int16_t itx = engine_node_profiler_top_count - 1;
+
+        // Not more expensive than any of the kept entries and no room left
+        if(engine_node_profiler_top_count == ENGINE_NODE_PROFILER_TOP_COUNT && total <= engine_node_profiler_entry_total(&engine_node_profiler_top[itx])){
+            continue;
+        }
+
+        if(engine_node_profiler_top_count < ENGINE_NODE_PROFILER_TOP_COUNT){
+            engine_node_profiler_top_count++;
+            itx++;
+        }
+
+        // Shift cheaper entries down (dropping the last if full)
+        while(itx > 0 && engine_node_profiler_entry_total(&engine_node_profiler_top[itx-1]) < total){
+            engine_node_profiler_top[itx] = engine_node_profiler_top[itx-1];
+            itx--;
+        }
+
+        engine_node_profiler_top[itx] = *entry;
+    }
+
+    // Start the next window fresh
+    memset(engine_node_profiler_entries, 0, sizeof(engine_node_profiler_entry_t) * ENGINE_NODE_PROFILER_CAPACITY);
+    engine_node_profiler_entry_count = 0;
+    engine_node_profiler_dropped = 0;
+}
+
+
+mp_obj_t engine_node_profiler_get_report(uint16_t count){
+    if(count > engine_node_profiler_top_count){
+        count = engine_node_profiler_top_count;
+    }
+
+    mp_obj_t report = mp_obj_new_list(0, NULL);
+
+    for(uint16_t itx=0; itx<count; itx++){
+        engine_node_profiler_entry_t *entry = &engine_node_profiler_top[itx];
+
+        mp_obj_t node_stats[5] = {
+            MP_OBJ_NEW_QSTR(entry->class_name),
+            mp_obj_new_int(entry->type),
+            mp_obj_new_int(entry->layer),
+            mp_obj_new_int(entry->tick_us),
+            mp_obj_new_int(entry->draw_us),
+        };
+
+        mp_obj_list_append(report, mp_obj_new_tuple(5, node_stats));
+    }
+
+    mp_obj_t result[2] = {
+        report,
+        mp_obj_new_int(engine_node_profiler_top_dropped)
+    };
+
+    return mp_obj_new_tuple(2, result);
+}
@@ -0,0 +1,44 @@
+#ifndef ENGINE_DEBUG_NODE_PROFILER_H
+#define ENGINE_DEBUG_NODE_PROFILER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "py/obj.h"
+#include "nodes/node_base.h"
+
+// Number of slots in the per-node cost table
+#define ENGINE_NODE_PROFILER_CAPACITY       256
+
+// Max number of distinct nodes tracked per window, samples of nodes past
+// this are dropped. Kept below the capacity so that there is always an
+// unused slot to end a lookup at instead of probing the whole table
+#define ENGINE_NODE_PROFILER_MAX_TRACKED    (ENGINE_NODE_PROFILER_CAPACITY / 4 * 3)
+
+// Max number of nodes kept from the last window for the report
+#define ENGINE_NODE_PROFILER_TOP_COUNT      16
+
+// How long costs are accumulated before the report is updated
+#define ENGINE_NODE_PROFILER_WINDOW_MS      1000
+
+extern bool DEBUG_NODE_PROFILER_ENABLED;
+
+
+// Allocates/frees the per-node cost table
+void engine_node_profiler_enable();
+void engine_node_profiler_disable();
+
+// Call once per frame before ticking nodes, finishes the
+// current window if `ENGINE_NODE_PROFILER_WINDOW_MS` passed
+void engine_node_profiler_window_check();
+
+// Adds time spent in a node's tick or draw to the current window
+void engine_node_profiler_add_tick(engine_node_base_t *node_base, uint32_t us);
+void engine_node_profiler_add_draw(engine_node_base_t *node_base, uint32_t us);
+
+// Returns a tuple of a list of up to `count` (class name, node type,
+// layer, tick us, draw us) tuples from the last window, most expensive
+// first, and how many samples of untracked nodes were dropped in it
+mp_obj_t engine_node_profiler_get_report(uint16_t count);
+
+
+#endif  // ENGINE_DEBUG_NODE_PROFILER_H
@@ -0,0 +1,158 @@
+#include "engine_debug_profiler.h"
+#include "debug_print.h"
+#include "utility/engine_time.h"
+
+#include "py/obj.h"
+#include "py/objtuple.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+bool DEBUG_PROFILER_ENABLED = false;
+
+// Ring buffer of the last `ENGINE_PROFILER_FRAME_COUNT` frames, only
+// allocated while the profiler is enabled
+uint32_t (*engine_profiler_frames)[ENGINE_PROFILER_PHASE_COUNT] = NULL;
+uint16_t engine_profiler_frame_index = 0;
+uint16_t engine_profiler_frames_recorded = 0;
+
+// Phase timings of the frame being recorded. Phases can be ended
+// more than once per frame (physics runs for every `engine_tick()`
+// but frames are only recorded when the FPS limit allows)
+uint32_t engine_profiler_current_frame[ENGINE_PROFILER_PHASE_COUNT] = {0};
+uint32_t engine_profiler_phase_start_us = 0;
+
+static const qstr engine_profiler_phase_names[ENGINE_PROFILER_PHASE_COUNT] = {
+    [ENGINE_PROFILER_PHASE_PHYSICS]      = MP_QSTR_physics,
+    [ENGINE_PROFILER_PHASE_IO]           = MP_QSTR_io,
+    [ENGINE_PROFILER_PHASE_ANIMATION]    = MP_QSTR_animation,
+    [ENGINE_PROFILER_PHASE_NODE_TICK]    = MP_QSTR_tick,
+    [ENGINE_PROFILER_PHASE_DELETE]       = MP_QSTR_delete,
+    [ENGINE_PROFILER_PHASE_NODE_DRAW]    = MP_QSTR_draw,
+    [ENGINE_PROFILER_PHASE_GUI]          = MP_QSTR_gui,
+    [ENGINE_PROFILER_PHASE_DISPLAY_SEND] = MP_QSTR_display,
+    [ENGINE_PROFILER_PHASE_DEPTH_CLEAR]  = MP_QSTR_depth_clear,
+    [ENGINE_PROFILER_PHASE_FRAME]        = MP_QSTR_frame,
+};
+
+
+void engine_profiler_enable(){
+    if(engine_profiler_frames == NULL){
+        engine_profiler_frames = malloc(sizeof(uint32_t) * ENGINE_PROFILER_PHASE_COUNT * ENGINE_PROFILER_FRAME_COUNT);
+
+        if(engine_profiler_frames == NULL){
+            ENGINE_ERROR_PRINTF("Profiler: Could not allocate frame timings, not enabling");
+            return;
+        }
+    }
+
+    engine_profiler_frame_index = 0;
+    engine_profiler_frames_recorded = 0;
+    engine_profiler_phase_start_us = micros();
+    memset(engine_profiler_current_frame, 0, sizeof(engine_profiler_current_frame));
+
+    DEBUG_PROFILER_ENABLED = true;
+}
+
+
+void engine_profiler_disable(){
+    DEBUG_PROFILER_ENABLED = false;
+
+    free(engine_profiler_frames);
+    engine_profiler_frames = NULL;
+    engine_profiler_frames_recorded = 0;
+}
+
+
+void engine_profiler_phase_start(){
+    engine_profiler_phase_start_us = micros();
+}
+
+
+void engine_profiler_phase_end(uint8_t phase){
+    uint32_t now = micros();
+    engine_profiler_current_frame[phase] += micros_diff(now, engine_profiler_phase_start_us);
+    engine_profiler_phase_start_us = now;
+}
+
+
+void engine_profiler_frame_end(){
+    uint32_t *frame = engine_profiler_frames[engine_profiler_frame_index];
+
+    uint32_t frame_total_us = 0;
+    for(uint8_t phase=0; phase<ENGINE_PROFILER_PHASE_FRAME; phase++){
+        frame[phase] = engine_profiler_current_frame[phase];
+        frame_total_us += frame[phase];
+    }
+    frame[ENGINE_PROFILER_PHASE_FRAME] = frame_total_us;
+
+    memset(engine_profiler_current_frame, 0, sizeof(engine_profiler_current_frame));
+
+    engine_profiler_frame_index = (engine_profiler_frame_index + 1) % ENGINE_PROFILER_FRAME_COUNT;
+
+    if(engine_profiler_frames_recorded < ENGINE_PROFILER_FRAME_COUNT){
+        engine_profiler_frames_recorded++;
+    }
+}
+
+
+mp_obj_t engine_profiler_get_stats(){
+    mp_obj_t stats = mp_obj_new_dict(ENGINE_PROFILER_PHASE_COUNT + 1);
+    mp_obj_dict_store(stats, MP_OBJ_NEW_QSTR(MP_QSTR_frames), mp_obj_new_int(engine_profiler_frames_recorded));
+
+    if(engine_profiler_frames == NULL || engine_profiler_frames_recorded == 0){
+        return stats;
+    }
+
+    uint16_t count = engine_profiler_frames_recorded;
+    uint32_t sorted[ENGINE_PROFILER_FRAME_COUNT];
+
+    for(uint8_t phase=0; phase<ENGINE_PROFILER_PHASE_COUNT; phase++){
+        uint64_t total = 0;
+
+        // Insertion sort, only ever a few dozen samples
+        for(uint16_t ifx=0; ifx<count; ifx++){
+            uint32_t sample = engine_profiler_frames[ifx][phase];
+            total += sample;
+
+            int16_t isx = ifx - 1;
+            while(isx >= 0 && sorted[isx] > sample){
+                sorted[isx+1] = sorted[isx];
+                isx--;
+            }
+            sorted[isx+1] = sample;
+        }
+
+        // Nearest-rank 95th percentile
+        uint16_t p95_index = (count * 95 + 99) / 100 - 1;
+
+        mp_obj_t phase_stats[4] = {
+            mp_obj_new_int(sorted[0]),
+            mp_obj_new_float((float)total / (float)count),
+            mp_obj_new_int(sorted[p95_index]),
+            mp_obj_new_int(sorted[count-1]),
+        };
+
+        mp_obj_dict_store(stats, MP_OBJ_NEW_QSTR(engine_profiler_phase_names[phase]), mp_obj_new_tuple(4, phase_stats));
+    }
+
+    return stats;
+}
+
+
+mp_obj_t engine_profiler_get_last_frame(){
+    mp_obj_t frame_stats = mp_obj_new_dict(ENGINE_PROFILER_PHASE_COUNT);
+
+    if(engine_profiler_frames == NULL || engine_profiler_frames_recorded == 0){
+        return frame_stats;
+    }
+
+    uint32_t *frame = engine_profiler_frames[(engine_profiler_frame_index + ENGINE_PROFILER_FRAME_COUNT - 1) % ENGINE_PROFILER_FRAME_COUNT];
+
+    for(uint8_t phase=0; phase<ENGINE_PROFILER_PHASE_COUNT; phase++){
+        mp_obj_dict_store(frame_stats, MP_OBJ_NEW_QSTR(engine_profiler_phase_names[phase]), mp_obj_new_int(frame[phase]));
+    }
+
+    return frame_stats;
+}
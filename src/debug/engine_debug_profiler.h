@@ -0,0 +1,68 @@
+#ifndef ENGINE_DEBUG_PROFILER_H
+#define ENGINE_DEBUG_PROFILER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "py/obj.h"
+
+// Phases of `engine_tick()` that get timed. `FRAME` is the
+// time of all the phases together
+#define ENGINE_PROFILER_PHASE_PHYSICS       0
+#define ENGINE_PROFILER_PHASE_IO            1
+#define ENGINE_PROFILER_PHASE_ANIMATION     2
+#define ENGINE_PROFILER_PHASE_NODE_TICK     3
+#define ENGINE_PROFILER_PHASE_DELETE        4
+#define ENGINE_PROFILER_PHASE_NODE_DRAW     5
+#define ENGINE_PROFILER_PHASE_GUI           6
+#define ENGINE_PROFILER_PHASE_DISPLAY_SEND  7
+#define ENGINE_PROFILER_PHASE_DEPTH_CLEAR   8
+#define ENGINE_PROFILER_PHASE_FRAME         9
+#define ENGINE_PROFILER_PHASE_COUNT         10
+
+// How many of the most recent frames are kept for stats
+#define ENGINE_PROFILER_FRAME_COUNT         64
+
+extern bool DEBUG_PROFILER_ENABLED;
+
+
+// Allocates/frees the ring buffer of frame timings
+void engine_profiler_enable();
+void engine_profiler_disable();
+
+// Starts timing the next phase, the previous one (if any) ends at this point
+void engine_profiler_phase_start();
+
+// Ends timing of the current phase and adds it to the current frame
+void engine_profiler_phase_end(uint8_t phase);
+
+// Commits the current frame's phase timings to the ring buffer
+void engine_profiler_frame_end();
+
+// Returns a dict of phase names to (min, avg, p95, max) tuples in microseconds
+mp_obj_t engine_profiler_get_stats();
+
+// Returns a dict of phase names to microseconds of the last recorded frame
+// (empty if none), for collecting every frame instead of the last 64
+mp_obj_t engine_profiler_get_last_frame();
+
+
+// These only cost a bool check when the profiler is disabled
+#define ENGINE_PROFILER_PHASE_START()           \
+    if(DEBUG_PROFILER_ENABLED){                 \
+        engine_profiler_phase_start();          \
+    }
+
+
+#define ENGINE_PROFILER_PHASE_END(phase)        \
+    if(DEBUG_PROFILER_ENABLED){                 \
+        engine_profiler_phase_end(phase);       \
+    }
+
+
+#define ENGINE_PROFILER_FRAME_END()             \
+    if(DEBUG_PROFILER_ENABLED){                 \
+        engine_profiler_frame_end();            \
+    }
+
+
+#endif  // ENGINE_DEBUG_PROFILER_H
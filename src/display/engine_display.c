@@ -1,5 +1,6 @@
 #include "engine_display.h"
 #include "engine_display_common.h"
+#include "engine_display_damage.h"
 #include "draw/engine_display_draw.h"
 #include "debug/debug_print.h"
 #include "py/obj.h"
@@ -15,6 +16,7 @@
     });
 #elif defined(__unix__)
     #include "engine_display_driver_unix_sdl.h"
+    #include "engine_main.h"
 #elif defined(__arm__)
     #include "engine_display_driver_rp2_gc9107.h"
 #else
@@ -34,7 +36,9 @@ void engine_display_init(){
     #if defined(__EMSCRIPTEN__)
 
     #elif defined(__unix__)
-        engine_display_sdl_init();
+        if(!engine_headless){
+            engine_display_sdl_init();
+        }
     #elif defined(__arm__)
         engine_display_gc9107_init();
     #endif
@@ -63,25 +67,45 @@ float engine_display_get_brightness(){
 
 
 void engine_display_send(){
-    // Send the screen buffer to the display
-    // Send the screen buffer to the display
-    #if defined(__EMSCRIPTEN__)
-        engine_display_web_update_screen(active_screen_buffer);
-    #elif defined(__unix__)
-        engine_display_sdl_update_screen(active_screen_buffer);
-    #elif defined(__arm__)
-        engine_display_gc9107_update(active_screen_buffer);
-    #endif
+    // Send the screen buffer (or only the damaged parts of it) to the display
+    if(engine_display_damage_is_partial()){
+        #if defined(__EMSCRIPTEN__)
+            // Never partial (see 'engine_display_damage_end_measure()')
+        #elif defined(__unix__)
+            if(!engine_headless){
+                uint8_t rect_count = 0;
+                const engine_display_rect_t *rects = engine_display_damage_get_rects(&rect_count);
+                engine_display_sdl_update_screen_rects(active_screen_buffer, rects, rect_count);
+            }
+        #elif defined(__arm__)
+            uint8_t rect_count = 0;
+            const engine_display_rect_t *rects = engine_display_damage_get_rects(&rect_count);
+            engine_display_gc9107_update_rects(active_screen_buffer, rects, rect_count);
+        #endif
+    }else{
+        #if defined(__EMSCRIPTEN__)
+            engine_display_web_update_screen(active_screen_buffer);
+        #elif defined(__unix__)
+            if(!engine_headless){
+                engine_display_sdl_update_screen(active_screen_buffer);
+            }
+        #elif defined(__arm__)
+            engine_display_gc9107_update(active_screen_buffer);
+        #endif
+    }
 
+    engine_display_damage_frame_sent();
     engine_switch_active_screen_buffer();
 
-    uint16_t *engine_fill_background = engine_display_get_background();
+    // When tracking damage, what needs clearing isn't known
+    // until the next draw pass measures the nodes (clears then)
+    if(engine_display_damage_is_enabled()){
+        return;
+    }
 
-    // Clear the new active screen buffer
-    if(engine_fill_background != NULL){
-        engine_draw_fill_buffer(engine_fill_background, active_screen_buffer);
-    }else{
-        uint16_t engine_fill_color = engine_display_get_color();
-        engine_draw_fill_color(engine_fill_color, active_screen_buffer);
+    // Clear the new active screen buffer unless something opaque
+    // will be drawn over all of it anyway
+    if(engine_display_fill_skippable() == false){
+        engine_display_fill_active_buffer();
     }
 }
@@ -1,11 +1,14 @@
 #include "engine_display_common.h"
+#include "engine_display_damage.h"
 #include "draw/engine_display_draw.h"
+#include "draw/engine_draw_static.h"
 #include "debug/debug_print.h"
 #include "utility/engine_defines.h"
 #include "utility/engine_mp.h"
 #include "resources/engine_resource_manager.h"
 #include "py/misc.h"
 #include <stdlib.h>
+#include <string.h>
 #include "py/objarray.h"
 
 // The current screen buffer that should be getting drawn to (the other
@@ -14,10 +17,29 @@ uint16_t *screen_buffers[2];
 uint16_t *active_screen_buffer;
 uint16_t *depth_buffer;
 
+// Nothing stored in a depth tile since it was cleared, something was
+// (its max depth has to be found again) or its max depth is known
+#define ENGINE_DISPLAY_DEPTH_TILE_CLEAR 0
+#define ENGINE_DISPLAY_DEPTH_TILE_STALE 1
+#define ENGINE_DISPLAY_DEPTH_TILE_VALID 2
+
+// One byte each so that tiles can be written from
+// different threads (when rasterizing deferred tiles)
+static uint8_t depth_tile_state[ENGINE_DISPLAY_DEPTH_TILES_X*ENGINE_DISPLAY_DEPTH_TILES_Y];
+static uint16_t depth_tile_max[ENGINE_DISPLAY_DEPTH_TILES_X*ENGINE_DISPLAY_DEPTH_TILES_Y];
+
 // Used to clear the screen
 uint16_t engine_fill_color = 0x0000;
 uint16_t *engine_fill_background = NULL;
 
+// Set by games that cover every frame with something opaque the
+// engine can't detect (see 'engine_draw_is_covered()') on their own
+static bool engine_fill_covered = false;
+
+// Set when the last clear was skipped only because the frame before was
+// covered, the draw pass checks that this frame was covered as well
+static bool engine_fill_skipped = false;
+
 // The current index of the 'active_screen_buffer' in 'dual_screen_buffers'
 // (gets switched when the screen buffer is sent out over DMA)
 static uint8_t active_screen_buffer_index = 0;
@@ -25,15 +47,67 @@ static uint8_t active_screen_buffer_index = 0;
 
 void engine_display_set_fill_color(uint16_t color){
     engine_fill_color = color;
+    engine_display_damage_invalidate();
+    engine_draw_static_invalidate();
 }
 
 void engine_display_set_fill_background(uint16_t *data){
     engine_fill_background = data;
+    engine_display_damage_invalidate();
+    engine_draw_static_invalidate();
+}
+
+void engine_display_set_fill_covered(bool covered){
+    engine_fill_covered = covered;
 }
 
 void engine_display_reset_fills(){
     engine_fill_color = 0x0000;
     engine_fill_background = NULL;
+    engine_fill_covered = false;
+    engine_fill_skipped = false;
+    engine_display_damage_invalidate();
+    engine_draw_static_invalidate();
+}
+
+
+bool engine_display_fill_skippable(){
+    if(engine_fill_covered){
+        return true;
+    }
+
+    engine_fill_skipped = engine_draw_is_covered();
+    return engine_fill_skipped;
+}
+
+
+bool engine_display_take_fill_skipped(){
+    bool skipped = engine_fill_skipped;
+    engine_fill_skipped = false;
+    return skipped;
+}
+
+
+uint16_t *engine_display_get_fill_buffer(){
+    // The background with the static layers already drawn on it
+    uint16_t *static_buffer = engine_draw_static_get_buffer();
+
+    if(static_buffer != NULL){
+        return static_buffer;
+    }
+
+    return engine_fill_background;
+}
+
+
+void engine_display_fill_active_buffer(){
+    uint16_t *fill_buffer = engine_display_get_fill_buffer();
+
+    if(fill_buffer != NULL){
+        engine_draw_fill_buffer(fill_buffer, active_screen_buffer);
+    }else{
+        engine_draw_fill_color(engine_fill_color, active_screen_buffer);
+    }
 }
 
 
@@ -118,14 +192,49 @@ void engine_switch_active_screen_buffer(){
 
 
 void ENGINE_FAST_FUNCTION(engine_display_clear_depth_buffer)(){
-    if(depth_buffer != NULL) engine_draw_fill_color(UINT16_MAX, depth_buffer);
+    if(depth_buffer == NULL){
+        return;
+    }
+
+    for(uint8_t ity=0; ity<ENGINE_DISPLAY_DEPTH_TILES_Y; ity++){
+        uint8_t *row_state = depth_tile_state + ity*ENGINE_DISPLAY_DEPTH_TILES_X;
+        uint8_t stored_count = 0;
+
+        for(uint8_t itx=0; itx<ENGINE_DISPLAY_DEPTH_TILES_X; itx++){
+            if(row_state[itx] != ENGINE_DISPLAY_DEPTH_TILE_CLEAR){
+                stored_count++;
+            }
+        }
+
+        if(stored_count == 0){
+            continue;
+        }
+
+        int32_t y = ity*ENGINE_DISPLAY_DEPTH_TILE_SIZE;
+
+        // Whole rows of the buffer are one long fill
+        if(stored_count == ENGINE_DISPLAY_DEPTH_TILES_X){
+            engine_draw_fill_color_rect(UINT16_MAX, depth_buffer, 0, y, SCREEN_WIDTH, ENGINE_DISPLAY_DEPTH_TILE_SIZE);
+        }else{
+            for(uint8_t itx=0; itx<ENGINE_DISPLAY_DEPTH_TILES_X; itx++){
+                if(row_state[itx] != ENGINE_DISPLAY_DEPTH_TILE_CLEAR){
+                    engine_draw_fill_color_rect(UINT16_MAX, depth_buffer, itx*ENGINE_DISPLAY_DEPTH_TILE_SIZE, y, ENGINE_DISPLAY_DEPTH_TILE_SIZE, ENGINE_DISPLAY_DEPTH_TILE_SIZE);
+                }
+            }
+        }
+
+        memset(row_state, ENGINE_DISPLAY_DEPTH_TILE_CLEAR, ENGINE_DISPLAY_DEPTH_TILES_X);
+    }
 }
 
 
 void engine_display_check_depth_buffer_created(){
     if(depth_buffer == NULL){
         depth_buffer = m_tracked_calloc(1, SCREEN_BUFFER_SIZE_BYTES);
-        engine_display_clear_depth_buffer();
+
+        // Every tile is cleared from here on
+        engine_draw_fill_color(UINT16_MAX, depth_buffer);
+        memset(depth_tile_state, ENGINE_DISPLAY_DEPTH_TILE_CLEAR, sizeof(depth_tile_state));
     }
 }
 
@@ -141,6 +250,10 @@ void engine_display_free_depth_buffer(){
 bool ENGINE_FAST_FUNCTION(engine_display_store_check_depth_index)(uint16_t index, uint16_t depth){
     if(depth < depth_buffer[index]){
         depth_buffer[index] = depth;
+
+        uint16_t tile_x = (index % SCREEN_WIDTH) >> ENGINE_DISPLAY_DEPTH_TILE_SHIFT;
+        uint16_t tile_y = (index / SCREEN_WIDTH) >> ENGINE_DISPLAY_DEPTH_TILE_SHIFT;
+        depth_tile_state[tile_y*ENGINE_DISPLAY_DEPTH_TILES_X + tile_x] = ENGINE_DISPLAY_DEPTH_TILE_STALE;
         return true;
     }
 
@@ -154,6 +267,37 @@ bool ENGINE_FAST_FUNCTION(engine_display_store_check_depth)(uint8_t sx, uint8_t
 }
 
 
+uint16_t ENGINE_FAST_FUNCTION(engine_display_get_depth_tile_max)(uint8_t tile_x, uint8_t tile_y){
+    uint16_t tile = tile_y*ENGINE_DISPLAY_DEPTH_TILES_X + tile_x;
+
+    if(depth_tile_state[tile] == ENGINE_DISPLAY_DEPTH_TILE_CLEAR){
+        return UINT16_MAX;
+    }
+
+    // Only looked for when asked, tiles get stored
+    // to many times before anything asks again
+    if(depth_tile_state[tile] == ENGINE_DISPLAY_DEPTH_TILE_STALE){
+        uint16_t *row = depth_buffer + (tile_y*SCREEN_WIDTH + tile_x) * ENGINE_DISPLAY_DEPTH_TILE_SIZE;
+        uint16_t max_depth = 0;
+
+        for(uint8_t iy=0; iy<ENGINE_DISPLAY_DEPTH_TILE_SIZE; iy++){
+            for(uint8_t ix=0; ix<ENGINE_DISPLAY_DEPTH_TILE_SIZE; ix++){
+                if(row[ix] > max_depth){
+                    max_depth = row[ix];
+                }
+            }
+
+            row += SCREEN_WIDTH;
+        }
+
+        depth_tile_max[tile] = max_depth;
+        depth_tile_state[tile] = ENGINE_DISPLAY_DEPTH_TILE_VALID;
+    }
+
+    return depth_tile_max[tile];
+}
+
+
 uint16_t *engine_display_get_depth_buffer(){
     return depth_buffer;
 }
\ No newline at end of file
@@ -30,11 +30,31 @@ MP_REGISTER_ROOT_POINTER(mp_obj_t front_fb);
 
 void engine_display_set_fill_color(uint16_t color);
 void engine_display_set_fill_background(uint16_t *data);
+void engine_display_set_fill_covered(bool covered);
 void engine_display_reset_fills();
 
+// Returns true if clearing the active screen buffer can be skipped since
+// an opaque draw will cover it: either the game said so or the frame
+// before was covered (checked again by 'engine_display_take_fill_skipped()')
+bool engine_display_fill_skippable();
+
+// Returns true once after 'engine_display_fill_skippable()' skipped the
+// clear based on the frame before, the caller has to make sure the new
+// frame was covered too and otherwise clear and draw it again
+bool engine_display_take_fill_skipped();
+
+// Clears the whole active screen buffer to the background color or texture
+// (or the cache of static layers, see 'draw/engine_draw_static.h')
+void engine_display_fill_active_buffer();
+
 uint16_t *engine_display_get_background();
 uint16_t engine_display_get_color();
 
+// Returns the screen sized buffer frames are cleared to: the static layer
+// cache if there is one, otherwise the background texture (can be NULL,
+// frames are cleared to the background color then)
+uint16_t *engine_display_get_fill_buffer();
+
 void engine_display_init_framebuffers();
 
 void engine_init_screen_buffers();
@@ -42,7 +62,16 @@ void engine_init_screen_buffers();
 // Switches active screen buffer
 void engine_switch_active_screen_buffer();
 
-// Resets all elements to 0x0000
+// The depth buffer is split into square tiles. Each one tracks if
+// anything was stored in it since it was cleared (only those get
+// cleared) and the farthest depth stored in it (nothing behind that
+// is visible there, see 'engine_display_get_depth_tile_max()')
+#define ENGINE_DISPLAY_DEPTH_TILE_SHIFT 3
+#define ENGINE_DISPLAY_DEPTH_TILE_SIZE (1 << ENGINE_DISPLAY_DEPTH_TILE_SHIFT)
+#define ENGINE_DISPLAY_DEPTH_TILES_X (SCREEN_WIDTH / ENGINE_DISPLAY_DEPTH_TILE_SIZE)
+#define ENGINE_DISPLAY_DEPTH_TILES_Y (SCREEN_HEIGHT / ENGINE_DISPLAY_DEPTH_TILE_SIZE)
+
+// Resets all elements stored since the last clear to 0xFFFF
 void engine_display_clear_depth_buffer();
 
 // Checks that the depth buffer has been created, if not, creates it
@@ -59,4 +88,10 @@ uint16_t *engine_display_get_depth_buffer();
 bool engine_display_store_check_depth_index(uint16_t index, uint16_t depth);
 bool engine_display_store_check_depth(uint8_t sx, uint8_t sy, uint16_t depth);
 
+// Returns the farthest depth stored in the tile at 'tile_x' and 'tile_y',
+// anything at or behind it is hidden everywhere in the tile. Tiles are
+// found from depth buffer indices as if drawing to the screen, only
+// useful for targets as wide as the screen
+uint16_t engine_display_get_depth_tile_max(uint8_t tile_x, uint8_t tile_y);
+
 #endif  // ENGINE_DISPLAY_COMMON
\ No newline at end of file
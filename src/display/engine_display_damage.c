@@ -0,0 +1,291 @@
+#include "engine_display_damage.h"
+#include "engine_display_common.h"
+#include "draw/engine_display_draw.h"
+#include "debug/debug_print.h"
+#include "math/engine_math.h"
+#include <math.h>
+
+// Defined in engine_display_common.c
+extern uint16_t *active_screen_buffer;
+
+static bool damage_enabled = false;
+static bool damage_measuring = false;
+
+// Damage collected since the last measuring pass. Starts (and stays)
+// full until something is measured so that the first frame is full
+static bool pending_full = true;
+static engine_display_rect_t pending_rects[ENGINE_DISPLAY_DAMAGE_MAX_RECTS];
+static uint8_t pending_rect_count = 0;
+
+// What the frame being drawn covers, only used if `frame_partial`
+static bool frame_partial = false;
+static engine_display_rect_t frame_rects[ENGINE_DISPLAY_DAMAGE_MAX_RECTS];
+static uint8_t frame_rect_count = 0;
+
+// Union of what the node being measured reported for every camera
+static engine_display_rect_t node_bounds;
+
+
+bool engine_display_rect_is_empty(engine_display_rect_t rect){
+    return rect.x0 >= rect.x1 || rect.y0 >= rect.y1;
+}
+
+
+bool engine_display_rect_equal(engine_display_rect_t a, engine_display_rect_t b){
+    return a.x0 == b.x0 && a.y0 == b.y0 && a.x1 == b.x1 && a.y1 == b.y1;
+}
+
+
+static int32_t engine_display_rect_area(engine_display_rect_t rect){
+    return (rect.x1 - rect.x0) * (rect.y1 - rect.y0);
+}
+
+
+static engine_display_rect_t engine_display_rect_union(engine_display_rect_t a, engine_display_rect_t b){
+    if(a.x0 > b.x0) a.x0 = b.x0;
+    if(a.y0 > b.y0) a.y0 = b.y0;
+    if(a.x1 < b.x1) a.x1 = b.x1;
+    if(a.y1 < b.y1) a.y1 = b.y1;
+    return a;
+}
+
+
+// Overlapping or sharing an edge (merging those costs nothing)
+static bool engine_display_rect_touches(engine_display_rect_t a, engine_display_rect_t b){
+    return a.x0 <= b.x1 && b.x0 <= a.x1 && a.y0 <= b.y1 && b.y0 <= a.y1;
+}
+
+
+// Converts a box from the float corners the draw callbacks work with to
+// the whole pixels it covers on screen (can be empty if off screen)
+static engine_display_rect_t engine_display_rect_from_box(float x0, float y0, float x1, float y1){
+    engine_display_rect_t rect;
+    rect.x0 = (int16_t)engine_math_clamp(floorf(x0), 0.0f, SCREEN_WIDTH);
+    rect.y0 = (int16_t)engine_math_clamp(floorf(y0), 0.0f, SCREEN_HEIGHT);
+    rect.x1 = (int16_t)engine_math_clamp(ceilf(x1) + 1.0f, 0.0f, SCREEN_WIDTH);
+    rect.y1 = (int16_t)engine_math_clamp(ceilf(y1) + 1.0f, 0.0f, SCREEN_HEIGHT);
+    return rect;
+}
+
+
+// Adds `rect` to `rects` keeping them from touching each other. When all
+// `ENGINE_DISPLAY_DAMAGE_MAX_RECTS` are used, `rect` is merged into the
+// one that grows the least
+static void engine_display_rects_insert(engine_display_rect_t *rects, uint8_t *rect_count, engine_display_rect_t rect){
+    // Absorb every rectangle that touches the new one, the grown
+    // rectangle can then touch others so start over each time
+    uint8_t irx = 0;
+    while(irx < *rect_count){
+        if(engine_display_rect_touches(rects[irx], rect)){
+            rect = engine_display_rect_union(rect, rects[irx]);
+            rects[irx] = rects[*rect_count - 1];
+            *rect_count -= 1;
+            irx = 0;
+        }else{
+            irx++;
+        }
+    }
+
+    if(*rect_count < ENGINE_DISPLAY_DAMAGE_MAX_RECTS){
+        rects[*rect_count] = rect;
+        *rect_count += 1;
+        return;
+    }
+
+    uint8_t best_index = 0;
+    int32_t best_growth = INT32_MAX;
+    for(irx=0; irx<*rect_count; irx++){
+        int32_t growth = engine_display_rect_area(engine_display_rect_union(rects[irx], rect)) - engine_display_rect_area(rects[irx]);
+        if(growth < best_growth){
+            best_growth = growth;
+            best_index = irx;
+        }
+    }
+
+    rect = engine_display_rect_union(rect, rects[best_index]);
+    rects[best_index] = rects[*rect_count - 1];
+    *rect_count -= 1;
+
+    engine_display_rects_insert(rects, rect_count, rect);
+}
+
+
+void engine_display_damage_set_enabled(bool enabled){
+    if(enabled == damage_enabled){
+        return;
+    }
+
+    damage_enabled = enabled;
+
+    if(enabled){
+        // Nothing was measured while disabled
+        engine_display_damage_invalidate();
+    }else{
+        // The last send left the clearing to the next draw pass
+        // but it is back to happening right after sending, do it now
+        engine_display_damage_clear_frame();
+    }
+}
+
+
+bool engine_display_damage_is_enabled(){
+    return damage_enabled;
+}
+
+
+void engine_display_damage_invalidate(){
+    pending_full = true;
+    pending_rect_count = 0;
+}
+
+
+void engine_display_damage_add(engine_display_rect_t rect){
+    if(pending_full || engine_display_rect_is_empty(rect)){
+        return;
+    }
+
+    engine_display_rects_insert(pending_rects, &pending_rect_count, rect);
+}
+
+
+void engine_display_damage_begin_measure(){
+    damage_measuring = true;
+}
+
+
+void engine_display_damage_end_measure(){
+    damage_measuring = false;
+
+    frame_partial = !pending_full;
+    frame_rect_count = 0;
+
+    // The web port only ever sends full frames
+    #if defined(__EMSCRIPTEN__)
+        frame_partial = false;
+    #endif
+
+    int32_t damaged_area = 0;
+
+    for(uint8_t irx=0; irx<pending_rect_count && frame_partial; irx++){
+        engine_display_rect_t rect = pending_rects[irx];
+
+        // DMA can only send contiguous memory so the GC9107 gets
+        // whole rows and all of each row is cleared and redrawn
+        #if defined(__arm__)
+            rect.x0 = 0;
+            rect.x1 = SCREEN_WIDTH;
+        #endif
+
+        engine_display_rects_insert(frame_rects, &frame_rect_count, rect);
+    }
+
+    for(uint8_t irx=0; irx<frame_rect_count; irx++){
+        damaged_area += engine_display_rect_area(frame_rects[irx]);
+    }
+
+    if(damaged_area > ENGINE_DISPLAY_DAMAGE_MAX_AREA){
+        frame_partial = false;
+    }
+
+    pending_full = false;
+    pending_rect_count = 0;
+}
+
+
+bool engine_display_damage_is_measuring(){
+    return damage_measuring;
+}
+
+
+void engine_display_damage_begin_node(){
+    node_bounds = (engine_display_rect_t){0, 0, 0, 0};
+}
+
+
+void engine_display_damage_report(float x0, float y0, float x1, float y1){
+    engine_display_rect_t rect = engine_display_rect_from_box(x0, y0, x1, y1);
+
+    if(engine_display_rect_is_empty(rect)){
+        return;
+    }
+
+    if(engine_display_rect_is_empty(node_bounds)){
+        node_bounds = rect;
+    }else{
+        node_bounds = engine_display_rect_union(node_bounds, rect);
+    }
+}
+
+
+engine_display_rect_t engine_display_damage_end_node(){
+    return node_bounds;
+}
+
+
+static void engine_display_damage_clear_rect(engine_display_rect_t rect){
+    uint16_t *fill_buffer = engine_display_get_fill_buffer();
+
+    if(fill_buffer != NULL){
+        engine_draw_fill_buffer_rect(fill_buffer, active_screen_buffer, rect.x0, rect.y0, rect.x1 - rect.x0, rect.y1 - rect.y0);
+    }else{
+        engine_draw_fill_color_rect(engine_display_get_color(), active_screen_buffer, rect.x0, rect.y0, rect.x1 - rect.x0, rect.y1 - rect.y0);
+    }
+}
+
+
+void engine_display_damage_clear_frame(){
+    if(engine_display_fill_skippable()){
+        return;
+    }
+
+    if(frame_partial == false){
+        engine_display_fill_active_buffer();
+        return;
+    }
+
+    for(uint8_t irx=0; irx<frame_rect_count; irx++){
+        engine_display_damage_clear_rect(frame_rects[irx]);
+    }
+}
+
+
+bool engine_display_damage_is_partial(){
+    return frame_partial;
+}
+
+
+const engine_display_rect_t *engine_display_damage_get_rects(uint8_t *rect_count){
+    *rect_count = frame_rect_count;
+    return frame_rects;
+}
+
+
+bool engine_display_damage_intersects(float x0, float y0, float x1, float y1){
+    if(frame_partial == false){
+        return true;
+    }
+
+    engine_display_rect_t rect = engine_display_rect_from_box(x0, y0, x1, y1);
+
+    for(uint8_t irx=0; irx<frame_rect_count; irx++){
+        engine_display_rect_t damaged = frame_rects[irx];
+
+        if(rect.x0 < damaged.x1 && damaged.x0 < rect.x1 && rect.y0 < damaged.y1 && damaged.y0 < rect.y1){
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void engine_display_damage_cancel(){
+    damage_measuring = false;
+    frame_partial = false;
+    engine_display_damage_invalidate();
+}
+
+
+void engine_display_damage_frame_sent(){
+    frame_partial = false;
+}
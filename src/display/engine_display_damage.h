@@ -0,0 +1,73 @@
+#ifndef ENGINE_DISPLAY_DAMAGE_H
+#define ENGINE_DISPLAY_DAMAGE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Dirty rectangle tracking for partial display updates. When enabled, the
+// draw pass first runs the draw callback of every node that moved or had
+// an attribute set (every node if a camera changed) without rasterizing so
+// that `engine_camera_2d_is_on_screen()` can report where it is on screen. Nodes that moved, changed size or opacity, had an attribute set,
+// or were removed damage the area they covered last frame and this frame.
+// Only the damaged rectangles are then cleared, redrawn and sent, unless
+// too much of the screen is damaged in which case the frame is full again
+
+#define ENGINE_DISPLAY_DAMAGE_MAX_RECTS 4                                      // Damaged areas are merged together when there are more than this
+#define ENGINE_DISPLAY_DAMAGE_MAX_AREA (SCREEN_BUFFER_SIZE_PIXELS / 2)         // Frames damaging more pixels than this are full frames
+
+// Area of the screen from `(x0, y0)` up to but not including `(x1, y1)`
+typedef struct{
+    int16_t x0;
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+}engine_display_rect_t;
+
+
+void engine_display_damage_set_enabled(bool enabled);
+bool engine_display_damage_is_enabled();
+
+// Makes the next frame a full frame (background changed, a node type that
+// doesn't report its bounds drew, a shared `Color` or `Shader` changed, etc.)
+void engine_display_damage_invalidate();
+
+// Adds `rect` to the damage of the next frame
+void engine_display_damage_add(engine_display_rect_t rect);
+
+// Start and end the measuring pass (see `engine_invoke_all_node_draw_callbacks()`).
+// Ending it decides if the frame is partial and which rectangles it covers
+void engine_display_damage_begin_measure();
+void engine_display_damage_end_measure();
+bool engine_display_damage_is_measuring();
+
+// Collects what the draw callbacks of one node report while measuring
+void engine_display_damage_begin_node();
+void engine_display_damage_report(float x0, float y0, float x1, float y1);
+engine_display_rect_t engine_display_damage_end_node();
+
+// Clears the damaged rectangles of the active screen buffer (or all of
+// it for full frames) to the background color or texture (or the static
+// layer cache, see 'engine_display_get_fill_buffer()'), unless an
+// opaque draw will cover it (see 'engine_display_fill_skippable()')
+void engine_display_damage_clear_frame();
+
+// True between measuring and sending a frame that only covers the
+// rectangles returned by `engine_display_damage_get_rects()`
+bool engine_display_damage_is_partial();
+const engine_display_rect_t *engine_display_damage_get_rects(uint8_t *rect_count);
+
+// Returns false if the box between the corners does not touch any of the
+// damaged rectangles of the current partial frame (drawing can skip it)
+bool engine_display_damage_intersects(float x0, float y0, float x1, float y1);
+
+// Called if a draw callback raised so that the next frame is full
+void engine_display_damage_cancel();
+
+// Called after sending a frame so that anything sent outside of a
+// normal `engine_tick()` (fault screens) is sent in full
+void engine_display_damage_frame_sent();
+
+bool engine_display_rect_is_empty(engine_display_rect_t rect);
+bool engine_display_rect_equal(engine_display_rect_t a, engine_display_rect_t b);
+
+#endif  // ENGINE_DISPLAY_DAMAGE_H
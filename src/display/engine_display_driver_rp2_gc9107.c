@@ -101,14 +101,20 @@ static void gc9107_write_cmd(uint8_t cmd, const uint8_t* data, size_t length){
 }
 
 
-void gc9107_reset_window(){
+// Sets the columns and rows (inclusive) that sent pixels fill
+static void gc9107_set_window(uint16_t x1, uint16_t x2, uint16_t y1, uint16_t y2){
     gc9107_write_cmd(0x36, (uint8_t[]){ 0x00 }, 1);
-    gc9107_write_cmd(0x2a, (uint8_t[]){ WINDOW_ADDR_X1>>8, WINDOW_ADDR_X1, WINDOW_ADDR_X2>>8, WINDOW_ADDR_X2 }, 4);
-    gc9107_write_cmd(0x2b, (uint8_t[]){ WINDOW_ADDR_Y1>>8, WINDOW_ADDR_Y1, WINDOW_ADDR_Y2>>8, WINDOW_ADDR_Y2 }, 4);
+    gc9107_write_cmd(0x2a, (uint8_t[]){ x1>>8, x1, x2>>8, x2 }, 4);
+    gc9107_write_cmd(0x2b, (uint8_t[]){ y1>>8, y1, y2>>8, y2 }, 4);
     gc9107_write_cmd(0x2c, NULL, 0);
 }
 
 
+void gc9107_reset_window(){
+    gc9107_set_window(WINDOW_ADDR_X1, WINDOW_ADDR_X2, WINDOW_ADDR_Y1, WINDOW_ADDR_Y2);
+}
+
+
 void engine_display_gc9107_apply_brightness(float brightness){
     pio_pwm_set_level(pio, sm, (uint32_t)(255.0f*brightness));
 }
@@ -254,7 +260,9 @@ void engine_display_gc9107_init(){
 }
 
 
-void engine_display_gc9107_update(uint16_t *screen_buffer_to_render){
+// Waits for the DMA transfer of the last frame (or band of it) to finish
+// so that the window can be changed and the next transfer can start
+static void gc9107_wait_for_transfer(){
     if(dma_channel_is_busy(dma_tx)){
         ENGINE_WARNING_PRINTF("Waiting on previous DMA transfer to complete. Could have done more last frame!");
         dma_channel_wait_for_finish_blocking(dma_tx);
@@ -264,12 +272,12 @@ void engine_display_gc9107_update(uint16_t *screen_buffer_to_render){
     // https://github.com/Bodmer/TFT_eSPI/blob/5162af0a0e13e0d4bc0e4c792ed28d38599a1f23/Processors/TFT_eSPI_RP2040.c#L600-L602
     while (spi_get_hw(spi0)->sr & SPI_SSPSR_BSY_BITS) {};
     hw_write_masked(&spi_get_hw(spi0)->cr0, (16 - 1) << SPI_SSPCR0_DSS_LSB, SPI_SSPCR0_DSS_BITS);
+}
 
-    // Point DMA to active screen buffer that should be
-    // sent now that the last frame is finished sending
-    txbuf = screen_buffer_to_render;
 
-    gc9107_reset_window();
+// Starts sending `pixel_count` pixels from `pixels` into the window set last
+static void gc9107_start_transfer(uint16_t *pixels, uint32_t pixel_count){
+    txbuf = pixels;
 
     gpio_put(PIN_GP17_SPI0_CSn__TO__CS, 0);
     gpio_put(PIN_GP16__TO__DC,          1);
@@ -278,6 +286,29 @@ void engine_display_gc9107_update(uint16_t *screen_buffer_to_render){
     dma_channel_configure(dma_tx, &dma_config,
                           &spi_get_hw(spi0)->dr,        // write address
                           txbuf,                        // read address
-                          SCREEN_BUFFER_SIZE_PIXELS,    // element count (each element is of size DMA_SIZE_16)
+                          pixel_count,                  // element count (each element is of size DMA_SIZE_16)
                           true);                        // don't start yet, need to set active frame buffer later
 }
+
+
+void engine_display_gc9107_update(uint16_t *screen_buffer_to_render){
+    gc9107_wait_for_transfer();
+
+    // Point DMA to active screen buffer that should be
+    // sent now that the last frame is finished sending
+    gc9107_reset_window();
+    gc9107_start_transfer(screen_buffer_to_render, SCREEN_BUFFER_SIZE_PIXELS);
+}
+
+
+void engine_display_gc9107_update_rects(uint16_t *screen_buffer_to_render, const engine_display_rect_t *rects, uint8_t rect_count){
+    // Each rectangle spans whole rows (see `engine_display_damage_end_measure()`)
+    // so it is contiguous in the screen buffer and can be sent in one transfer.
+    // Only the last one is left sending while the next frame is drawn
+    for(uint8_t irx=0; irx<rect_count; irx++){
+        gc9107_wait_for_transfer();
+        gc9107_set_window(WINDOW_ADDR_X1, WINDOW_ADDR_X2, WINDOW_ADDR_Y1 + rects[irx].y0, WINDOW_ADDR_Y1 + rects[irx].y1 - 1);
+
+        gc9107_start_transfer(screen_buffer_to_render + rects[irx].y0*SCREEN_WIDTH, (rects[irx].y1 - rects[irx].y0)*SCREEN_WIDTH);
+    }
+}
@@ -2,6 +2,7 @@
 #define ENGINE_DISPLAY_DRIVER_RP2_GC9107_H
 
 #include <stdint.h>
+#include "engine_display_damage.h"
 
 // Driver reference implementation: https://www.buydisplay.com/0-85-inch-128x128-ips-tft-lcd-display-4-wire-spi-gc9107-controller (8051 Interfacing Demo Code)
 //                                  https://www.buydisplay.com/8051/ER-TFT0.85-1_8051_Tutorial.zip
@@ -9,4 +10,7 @@ void engine_display_gc9107_apply_brightness(float brightness);
 void engine_display_gc9107_init();
 void engine_display_gc9107_update(uint16_t *screen_buffer_to_render);
 
+// Only sends the rows covered by `rects` (each must span the full width)
+void engine_display_gc9107_update_rects(uint16_t *screen_buffer_to_render, const engine_display_rect_t *rects, uint8_t rect_count);
+
 #endif  // ENGINE_DISPLAY_DRIVER_RP2_GC9107_H
@@ -15,14 +15,35 @@
     // Defined in engine_display_common.c
     extern uint16_t *active_screen_buffer;
 
-    void engine_display_sdl_update_screen(uint16_t *screen_buffer_to_render){
-        SDL_UpdateTexture(window_frame_buffer , NULL, screen_buffer_to_render, SCREEN_WIDTH*sizeof(uint16_t));
+    static void engine_display_sdl_present(){
         SDL_RenderClear(window_renderer);
         SDL_RenderCopy(window_renderer, window_frame_buffer, NULL, NULL);
         SDL_RenderPresent(window_renderer);
     }
 
 
+    void engine_display_sdl_update_screen(uint16_t *screen_buffer_to_render){
+        SDL_UpdateTexture(window_frame_buffer , NULL, screen_buffer_to_render, SCREEN_WIDTH*sizeof(uint16_t));
+        engine_display_sdl_present();
+    }
+
+
+    void engine_display_sdl_update_screen_rects(uint16_t *screen_buffer_to_render, const engine_display_rect_t *rects, uint8_t rect_count){
+        // Nothing changed, the texture still has the last frame
+        if(rect_count == 0){
+            return;
+        }
+
+        // The texture keeps what was outside the rectangles from previous frames
+        for(uint8_t irx=0; irx<rect_count; irx++){
+            SDL_Rect rect = {rects[irx].x0, rects[irx].y0, rects[irx].x1 - rects[irx].x0, rects[irx].y1 - rects[irx].y0};
+            SDL_UpdateTexture(window_frame_buffer, &rect, screen_buffer_to_render + rect.y*SCREEN_WIDTH + rect.x, SCREEN_WIDTH*sizeof(uint16_t));
+        }
+
+        engine_display_sdl_present();
+    }
+
+
     void engine_display_sdl_init(){
         // https://dev.to/noah11012/using-sdl2-opening-a-window-79c
         if(SDL_Init(SDL_INIT_VIDEO) < 0){
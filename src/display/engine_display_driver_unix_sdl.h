@@ -2,9 +2,13 @@
 #define ENGINE_DISPLAY_DRIVER_UNIX_SDL_H
 
 #include <stdint.h>
+#include "engine_display_damage.h"
 
 void engine_display_sdl_init();
 void engine_display_sdl_update_screen(uint16_t *screen_buffer_to_render);
 
+// Only updates the parts of the window covered by `rects`
+void engine_display_sdl_update_screen_rects(uint16_t *screen_buffer_to_render, const engine_display_rect_t *rects, uint8_t rect_count);
+
 
 #endif  // ENGINE_DISPLAY_DRIVER_UNIX_SDL_H
\ No newline at end of file
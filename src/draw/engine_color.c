@@ -1,7 +1,10 @@
 #include "engine_color.h"
+#include "engine_color_blend.h"
 #include "debug/debug_print.h"
 #include "utility/engine_defines.h"
 #include "math/engine_math.h"
+#include "display/engine_display_damage.h"
+#include "draw/engine_draw_static.h"
 
 const uint16_t bitmask_5_bit = 0b0000000000011111;
 const uint16_t bitmask_6_bit = 0b0000000000111111;
@@ -31,31 +34,80 @@ static inline void engine_color_split_u16(uint16_t color, uint16_t *r, uint16_t
     *b = (color >>  0) & bitmask_5_bit;
 }
 
-// https://stackoverflow.com/a/29321264
+// https://stackoverflow.com/a/29321264 (blends the squared channels with a
+// 16-bit fixed-point `amount` so everything is integer math)
 uint16_t ENGINE_FAST_FUNCTION(engine_color_blend)(uint16_t from, uint16_t to, float amount){
-    uint16_t from_r, from_g, from_b;
-    engine_color_split_u16(from, &from_r, &from_g, &from_b);
-    uint16_t to_r, to_g, to_b;
-    engine_color_split_u16(to, &to_r, &to_g, &to_b);
+    return engine_color_blend_rgb565(from, to, engine_color_blend_amount(amount));
+}
 
-    const uint16_t out_r = clamp_int(round_float(sqrtf((1.0f - amount) * (from_r*from_r) + amount * (to_r*to_r))), bitmask_5_bit);
-    const uint16_t out_g = clamp_int(round_float(sqrtf((1.0f - amount) * (from_g*from_g) + amount * (to_g*to_g))), bitmask_6_bit);
-    const uint16_t out_b = clamp_int(round_float(sqrtf((1.0f - amount) * (from_b*from_b) + amount * (to_b*to_b))), bitmask_5_bit);
 
-    return (out_r << 11) | (out_g << 5) | (out_b << 0);
+// https://stackoverflow.com/a/19060243 (with `alpha` rounded to 5-bits and
+// all channels blended at once, at most 1 off per channel from float math)
+uint16_t ENGINE_FAST_FUNCTION(engine_color_alpha_blend)(uint16_t background, uint16_t foreground, float alpha){
+    return engine_color_swar_alpha_blend(background, foreground, engine_color_swar_alpha(alpha));
 }
 
 
-// https://stackoverflow.com/a/19060243
-uint16_t ENGINE_FAST_FUNCTION(engine_color_alpha_blend)(uint16_t background, uint16_t foreground, float alpha){
+void ENGINE_FAST_FUNCTION(engine_color_alpha_blend_span)(uint16_t *dst, const uint16_t *src, uint32_t count, float alpha){
+    const uint32_t a = engine_color_swar_alpha(alpha);
+
+    for(uint32_t i=0; i<count; i++){
+        dst[i] = engine_color_swar_alpha_blend(dst[i], src[i], a);
+    }
+}
+
+
+void ENGINE_FAST_FUNCTION(engine_color_alpha_blend_fill)(uint16_t *dst, uint16_t color, uint32_t count, float alpha){
+    const uint32_t a = engine_color_swar_alpha(alpha);
+    const uint32_t inverse_a = 32 - a;
+
+    // The foreground is the same for every pixel, scale it once
+    const uint32_t fg_scaled = engine_color_swar_spread(color) * a + ENGINE_COLOR_SWAR_HALF;
+
+    for(uint32_t i=0; i<count; i++){
+        dst[i] = engine_color_swar_pack((fg_scaled + engine_color_swar_spread(dst[i]) * inverse_a) >> 5);
+    }
+}
+
+
+// Saturating add of `foreground` scaled by `alpha` onto `background`
+uint16_t ENGINE_FAST_FUNCTION(engine_color_additive_blend)(uint16_t background, uint16_t foreground, float alpha){
     uint16_t bg_r, bg_g, bg_b;
     engine_color_split_u16(background, &bg_r, &bg_g, &bg_b);
     uint16_t fg_r, fg_g, fg_b;
     engine_color_split_u16(foreground, &fg_r, &fg_g, &fg_b);
 
-    const uint16_t out_r = round_float((fg_r * alpha + bg_r * (1.0f-alpha)));
-    const uint16_t out_g = round_float((fg_g * alpha + bg_g * (1.0f-alpha)));
-    const uint16_t out_b = round_float((fg_b * alpha + bg_b * (1.0f-alpha)));
+    const uint16_t out_r = clamp_int(bg_r + round_float(fg_r * alpha), bitmask_5_bit);
+    const uint16_t out_g = clamp_int(bg_g + round_float(fg_g * alpha), bitmask_6_bit);
+    const uint16_t out_b = clamp_int(bg_b + round_float(fg_b * alpha), bitmask_5_bit);
+
+    return (out_r << 11) | (out_g << 5) | (out_b << 0);
+}
+
+
+// Multiplies each channel of `color` by the same channel of `by` (as 0.0 ~ 1.0)
+uint16_t ENGINE_FAST_FUNCTION(engine_color_multiply)(uint16_t color, uint16_t by){
+    uint16_t r, g, b;
+    engine_color_split_u16(color, &r, &g, &b);
+    uint16_t by_r, by_g, by_b;
+    engine_color_split_u16(by, &by_r, &by_g, &by_b);
+
+    const uint16_t out_r = (r * by_r + bitmask_5_bit/2) / bitmask_5_bit;
+    const uint16_t out_g = (g * by_g + bitmask_6_bit/2) / bitmask_6_bit;
+    const uint16_t out_b = (b * by_b + bitmask_5_bit/2) / bitmask_5_bit;
+
+    return (out_r << 11) | (out_g << 5) | (out_b << 0);
+}
+
+
+// Scales each channel of `color` by `amount` (> 1.0 brightens, < 1.0 darkens)
+uint16_t ENGINE_FAST_FUNCTION(engine_color_brightness)(uint16_t color, float amount){
+    uint16_t r, g, b;
+    engine_color_split_u16(color, &r, &g, &b);
+
+    const uint16_t out_r = engine_math_clamp(r * amount + 0.5f, 0.0f, bitmask_5_bit);
+    const uint16_t out_g = engine_math_clamp(g * amount + 0.5f, 0.0f, bitmask_6_bit);
+    const uint16_t out_b = engine_math_clamp(b * amount + 0.5f, 0.0f, bitmask_5_bit);
 
     return (out_r << 11) | (out_g << 5) | (out_b << 0);
 }
@@ -178,6 +230,10 @@ uint16_t engine_color_16_from_24_bit_rgb(uint8_t r, uint8_t g, uint8_t b){
 static mp_obj_t engine_color_set(size_t n_args, const mp_obj_t *args) {
     color_class_obj_t *self = MP_OBJ_TO_PTR(args[0]);
     self->value = engine_color_from_rgb_float(mp_obj_get_float(args[1]), mp_obj_get_float(args[2]), mp_obj_get_float(args[3]));
+
+    // Any number of nodes could be using this color
+    engine_display_damage_invalidate();
+    engine_draw_static_invalidate();
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(engine_color_set_obj, 4, 4, engine_color_set);
@@ -228,8 +284,10 @@ static void color_class_attr(mp_obj_t self_in, qstr attribute, mp_obj_t *destina
                 return; // Fail
         }
 
-        // Success
+        // Success, any number of nodes could be using this color
         destination[0] = MP_OBJ_NULL;
+        engine_display_damage_invalidate();
+        engine_draw_static_invalidate();
     }
 }
 
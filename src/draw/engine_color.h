@@ -44,4 +44,13 @@ mp_obj_t color_class_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw,
 uint16_t ENGINE_FAST_FUNCTION(engine_color_blend)(uint16_t from, uint16_t to, float amount);
 uint16_t ENGINE_FAST_FUNCTION(engine_color_alpha_blend)(uint16_t background, uint16_t foreground, float alpha);
 
+// Same as 'engine_color_alpha_blend' for 'count' pixels in a row, blending
+// 'src' (or a single 'color') over 'dst' in place
+void ENGINE_FAST_FUNCTION(engine_color_alpha_blend_span)(uint16_t *dst, const uint16_t *src, uint32_t count, float alpha);
+void ENGINE_FAST_FUNCTION(engine_color_alpha_blend_fill)(uint16_t *dst, uint16_t color, uint32_t count, float alpha);
+
+uint16_t ENGINE_FAST_FUNCTION(engine_color_additive_blend)(uint16_t background, uint16_t foreground, float alpha);
+uint16_t ENGINE_FAST_FUNCTION(engine_color_multiply)(uint16_t color, uint16_t by);
+uint16_t ENGINE_FAST_FUNCTION(engine_color_brightness)(uint16_t color, float amount);
+
 #endif  /// ENGINE_COLOR_H
@@ -0,0 +1,93 @@
+#ifndef ENGINE_COLOR_BLEND_H
+#define ENGINE_COLOR_BLEND_H
+
+// Integer RGB565 blending kernels behind `engine_color_blend()` and
+// `engine_color_alpha_blend()`. Only standard headers are included so
+// `engine_color_blend_check.c` can build them on the host and compare
+// them against the float math they replaced. The RP2350's Cortex-M33
+// has a single precision FPU, but blending three channels in floats
+// still costs int/float conversions and a float multiply per channel
+// for every pixel, here it's one 32-bit integer multiply
+
+#include <stdint.h>
+
+
+// RGB565 spread over 32-bits as -----GGGGGG-----RRRRR------BBBBB so that
+// all three channels can be multiplied by a 5-bit alpha (0 ~ 32) in one
+// 32-bit multiply without overflowing into each other (SWAR)
+#define ENGINE_COLOR_SWAR_MASK 0x07E0F81F
+#define ENGINE_COLOR_SWAR_HALF 0x02008010   // 16 (half of 32) in each channel, for rounding
+
+static inline uint32_t engine_color_swar_spread(uint16_t color){
+    return (color | ((uint32_t)color << 16)) & ENGINE_COLOR_SWAR_MASK;
+}
+
+static inline uint16_t engine_color_swar_pack(uint32_t spread){
+    spread &= ENGINE_COLOR_SWAR_MASK;
+    return (uint16_t)(spread | (spread >> 16));
+}
+
+static inline uint32_t engine_color_swar_alpha(float alpha){
+    if(alpha <= 0.0f) return 0;
+    if(alpha >= 1.0f) return 32;
+    return (uint32_t)(alpha * 32.0f + 0.5f);
+}
+
+// Blends all three channels at once with a 5-bit `alpha` from `engine_color_swar_alpha()`
+static inline uint16_t engine_color_swar_alpha_blend(uint16_t background, uint16_t foreground, uint32_t alpha){
+    const uint32_t bg = engine_color_swar_spread(background);
+    const uint32_t fg = engine_color_swar_spread(foreground);
+
+    return engine_color_swar_pack((fg * alpha + bg * (32 - alpha) + ENGINE_COLOR_SWAR_HALF) >> 5);
+}
+
+
+// Smallest squared value that rounds to each 6-bit channel value when
+// square rooted (k*k - k + 1), so going from squared back to a channel
+// value is a search through this table instead of `sqrtf`
+static const uint16_t engine_color_round_sqrt_table[64] = {
+       0,    1,    3,    7,   13,   21,   31,   43,
+      57,   73,   91,  111,  133,  157,  183,  211,
+     241,  273,  307,  343,  381,  421,  463,  507,
+     553,  601,  651,  703,  757,  813,  871,  931,
+     993, 1057, 1123, 1191, 1261, 1333, 1407, 1483,
+    1561, 1641, 1723, 1807, 1893, 1981, 2071, 2163,
+    2257, 2353, 2451, 2551, 2653, 2757, 2863, 2971,
+    3081, 3193, 3307, 3423, 3541, 3661, 3783, 3907,
+};
+
+static inline uint16_t engine_color_round_sqrt(uint32_t value){
+    uint16_t result = 0;
+
+    // Binary search for the largest entry <= `value` (never indexes past 63)
+    for(uint16_t step=32; step>0; step>>=1){
+        if(engine_color_round_sqrt_table[result + step] <= value){
+            result += step;
+        }
+    }
+
+    return result;
+}
+
+// Blends squared channels with a 16-bit fixed-point `amount` (0 ~ 65536)
+static inline uint16_t engine_color_blend_channel(uint16_t from, uint16_t to, uint32_t amount){
+    return engine_color_round_sqrt(((65536 - amount) * (from*from) + amount * (to*to) + 32768) >> 16);
+}
+
+// `amount` (0.0 ~ 1.0, clamped) in the fixed-point `engine_color_blend_channel()` takes
+static inline uint32_t engine_color_blend_amount(float amount){
+    if(amount <= 0.0f) return 0;
+    if(amount >= 1.0f) return 65536;
+    return (uint32_t)(amount * 65536.0f + 0.5f);
+}
+
+static inline uint16_t engine_color_blend_rgb565(uint16_t from, uint16_t to, uint32_t amount){
+    const uint16_t out_r = engine_color_blend_channel((from >> 11) & 0x1F, (to >> 11) & 0x1F, amount);
+    const uint16_t out_g = engine_color_blend_channel((from >>  5) & 0x3F, (to >>  5) & 0x3F, amount);
+    const uint16_t out_b = engine_color_blend_channel((from >>  0) & 0x1F, (to >>  0) & 0x1F, amount);
+
+    return (out_r << 11) | (out_g << 5) | (out_b << 0);
+}
+
+
+#endif  // ENGINE_COLOR_BLEND_H
@@ -0,0 +1,130 @@
+// Host-side check of the integer blending kernels in `engine_color_blend.h`
+// against the float math they replaced. Not part of the firmware build,
+// run it from the repository root after changing the kernels:
+//
+//     cc -O2 -I src src/draw/engine_color_blend_check.c -lm -o color_blend_check && ./color_blend_check
+//
+// Exits non-zero if any channel is more than 1 off from the float result
+// or if the square root table disagrees with `sqrtf` anywhere
+
+#include "draw/engine_color_blend.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+
+#define ENGINE_COLOR_BLEND_CHECK_MAX_ERROR 1
+#define ENGINE_COLOR_BLEND_CHECK_RANDOM_COUNT 4000000
+
+
+static uint16_t round_float(float value){
+    return (uint16_t)(value + 0.5f);
+}
+
+static uint16_t clamp_int(uint16_t value, uint16_t max){
+    if(value > 0x1FFF) return 0;
+    if(value > max) return max;
+    return value;
+}
+
+// What `engine_color_alpha_blend()` did before it was integer math
+static uint16_t float_alpha_blend(uint16_t background, uint16_t foreground, float alpha){
+    const uint16_t bg_r = (background >> 11) & 0x1F, bg_g = (background >> 5) & 0x3F, bg_b = background & 0x1F;
+    const uint16_t fg_r = (foreground >> 11) & 0x1F, fg_g = (foreground >> 5) & 0x3F, fg_b = foreground & 0x1F;
+
+    const uint16_t out_r = round_float((fg_r * alpha + bg_r * (1.0f-alpha)));
+    const uint16_t out_g = round_float((fg_g * alpha + bg_g * (1.0f-alpha)));
+    const uint16_t out_b = round_float((fg_b * alpha + bg_b * (1.0f-alpha)));
+
+    return (out_r << 11) | (out_g << 5) | (out_b << 0);
+}
+
+// What `engine_color_blend()` did before it was integer math
+static uint16_t float_blend(uint16_t from, uint16_t to, float amount){
+    const uint16_t from_r = (from >> 11) & 0x1F, from_g = (from >> 5) & 0x3F, from_b = from & 0x1F;
+    const uint16_t to_r = (to >> 11) & 0x1F, to_g = (to >> 5) & 0x3F, to_b = to & 0x1F;
+
+    const uint16_t out_r = clamp_int(round_float(sqrtf((1.0f - amount) * (from_r*from_r) + amount * (to_r*to_r))), 0x1F);
+    const uint16_t out_g = clamp_int(round_float(sqrtf((1.0f - amount) * (from_g*from_g) + amount * (to_g*to_g))), 0x3F);
+    const uint16_t out_b = clamp_int(round_float(sqrtf((1.0f - amount) * (from_b*from_b) + amount * (to_b*to_b))), 0x1F);
+
+    return (out_r << 11) | (out_g << 5) | (out_b << 0);
+}
+
+// Largest difference between any channel of two colors
+static int channel_error(uint16_t a, uint16_t b){
+    int error_r = abs(((a >> 11) & 0x1F) - ((b >> 11) & 0x1F));
+    int error_g = abs(((a >>  5) & 0x3F) - ((b >>  5) & 0x3F));
+    int error_b = abs(((a >>  0) & 0x1F) - ((b >>  0) & 0x1F));
+
+    int error = error_r;
+    if(error_g > error) error = error_g;
+    if(error_b > error) error = error_b;
+    return error;
+}
+
+
+static uint32_t random_state = 12345;
+
+static uint32_t random_next(){
+    random_state = random_state * 1664525 + 1013904223;
+    return random_state;
+}
+
+
+static int max_alpha_error = 0;
+static int max_blend_error = 0;
+static uint32_t failures = 0;
+
+static void check_pair(uint16_t background, uint16_t foreground, float alpha){
+    int alpha_error = channel_error(engine_color_swar_alpha_blend(background, foreground, engine_color_swar_alpha(alpha)), float_alpha_blend(background, foreground, alpha));
+    int blend_error = channel_error(engine_color_blend_rgb565(background, foreground, engine_color_blend_amount(alpha)), float_blend(background, foreground, alpha));
+
+    if(alpha_error > max_alpha_error) max_alpha_error = alpha_error;
+    if(blend_error > max_blend_error) max_blend_error = blend_error;
+
+    if(alpha_error > ENGINE_COLOR_BLEND_CHECK_MAX_ERROR || blend_error > ENGINE_COLOR_BLEND_CHECK_MAX_ERROR){
+        if(failures < 10){
+            printf("0x%04x over 0x%04x at %f: alpha blend off by %d, blend off by %d\n", foreground, background, (double)alpha, alpha_error, blend_error);
+        }
+
+        failures++;
+    }
+}
+
+
+int main(){
+    // Every value the squared channels can take
+    for(uint32_t value=0; value<=63*63; value++){
+        if(engine_color_round_sqrt(value) != round_float(sqrtf((float)value))){
+            printf("square root of %lu is %u, not %u\n", (unsigned long)value, engine_color_round_sqrt(value), round_float(sqrtf((float)value)));
+            failures++;
+        }
+    }
+
+    // Every pair of channel values (channels don't interact) at a sweep of alphas
+    for(uint32_t step=0; step<=256; step++){
+        float alpha = step / 256.0f;
+
+        for(uint16_t from=0; from<64; from++){
+            for(uint16_t to=0; to<64; to++){
+                uint16_t background = ((from >> 1) << 11) | (from << 5) | ((63 - from) >> 1);
+                uint16_t foreground = ((to >> 1) << 11) | (to << 5) | ((63 - to) >> 1);
+                check_pair(background, foreground, alpha);
+            }
+        }
+    }
+
+    // Random colors and alphas
+    for(uint32_t i=0; i<ENGINE_COLOR_BLEND_CHECK_RANDOM_COUNT; i++){
+        uint16_t background = random_next() >> 16;
+        uint16_t foreground = random_next() >> 16;
+        float alpha = (random_next() >> 8) / 16777216.0f;
+        check_pair(background, foreground, alpha);
+    }
+
+    printf("alpha blend max channel error %d, blend max channel error %d, %lu failures\n", max_alpha_error, max_blend_error, (unsigned long)failures);
+
+    return (failures == 0) ? 0 : 1;
+}
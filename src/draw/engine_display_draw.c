@@ -11,77 +11,569 @@
 #include "math/engine_math.h"
 #include "draw/engine_color.h"
 #include "draw/engine_shader.h"
+#include "draw/engine_draw_deferred.h"
 
 #include "py/objstr.h"
+#include "py/objarray.h"
 #include "py/objtype.h"
 
 // Defined in engine_display_common.c
 extern uint16_t *active_screen_buffer;
 
+// Tiles are rasterized on worker threads on the unix
+// port, each of them needs its own clip
+#if defined(ENGINE_DRAW_DEFERRED_MAX_WORKERS)
+    #define ENGINE_DRAW_THREAD_LOCAL __thread
+#else
+    #define ENGINE_DRAW_THREAD_LOCAL
+#endif
+
+// Clip used when not rasterizing a tile. Its 'covered' is set when something
+// opaque was drawn over every pixel of the screen buffer since the last
+// 'engine_draw_reset_covered()'
+static engine_draw_clip_t engine_draw_screen_clip = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, false};
+static ENGINE_DRAW_THREAD_LOCAL engine_draw_clip_t *engine_draw_clip = &engine_draw_screen_clip;
+
+// Offscreen buffer set by 'engine_draw_set_target()' (NULL when drawing
+// to 'active_screen_buffer') and the clip used while drawing into it so
+// that the screen's 'covered' isn't touched
+static uint16_t *engine_draw_offscreen_buffer = NULL;
+static engine_draw_clip_t engine_draw_offscreen_clip = {0, 0, 0, 0, false};
+static int32_t engine_draw_target_width = SCREEN_WIDTH;
+
+// Cleared when something was drawn that might not come out exactly the
+// same, moved by whole pixels, when drawn at a position moved by whole
+// pixels (rotated or scaled, or not at a whole pixel position)
+static ENGINE_DRAW_THREAD_LOCAL bool engine_draw_shift_exact = true;
+
+
+static inline uint16_t *engine_draw_target_buffer(){
+    return (engine_draw_offscreen_buffer != NULL) ? engine_draw_offscreen_buffer : active_screen_buffer;
+}
+
+
+void engine_draw_set_target(uint16_t *buffer, int32_t width, int32_t height){
+    engine_draw_offscreen_buffer = buffer;
+
+    if(buffer == NULL){
+        engine_draw_target_width = SCREEN_WIDTH;
+        engine_draw_clip = &engine_draw_screen_clip;
+    }else{
+        engine_draw_target_width = width;
+        engine_draw_offscreen_clip = (engine_draw_clip_t){0, 0, width, height, false};
+        engine_draw_clip = &engine_draw_offscreen_clip;
+    }
+}
+
+
+bool engine_draw_is_offscreen(){
+    return engine_draw_offscreen_buffer != NULL;
+}
+
+
+uint16_t *engine_draw_get_target(){
+    return engine_draw_target_buffer();
+}
+
+
+int32_t engine_draw_get_target_width(){
+    return engine_draw_target_width;
+}
+
+
+void engine_draw_set_clip(engine_draw_clip_t *clip){
+    if(clip != NULL){
+        engine_draw_clip = clip;
+    }else if(engine_draw_offscreen_buffer != NULL){
+        engine_draw_clip = &engine_draw_offscreen_clip;
+    }else{
+        engine_draw_clip = &engine_draw_screen_clip;
+    }
+}
+
+
+const engine_draw_clip_t *engine_draw_get_clip(){
+    return engine_draw_clip;
+}
+
+
+void engine_draw_reset_covered(){
+    engine_draw_screen_clip.covered = false;
+}
+
+
+void engine_draw_set_covered(){
+    engine_draw_screen_clip.covered = true;
+}
+
+
+bool engine_draw_is_covered(){
+    return engine_draw_screen_clip.covered;
+}
+
+
+void engine_draw_reset_shift_exact(){
+    engine_draw_shift_exact = true;
+}
+
+
+void engine_draw_set_not_shift_exact(){
+    engine_draw_shift_exact = false;
+}
+
+
+bool engine_draw_is_shift_exact(){
+    return engine_draw_shift_exact;
+}
+
+
+static inline bool engine_draw_is_whole(float value){
+    return value == floorf(value);
+}
+
+
+// Called by the axis aligned paths below with the area they wrote to
+// and whether every pixel in it was replaced without blending
+static inline void engine_draw_check_covered(int32_t x_start, int32_t x_end, int32_t y_start, int32_t y_end, bool opaque){
+    engine_draw_clip_t *clip = engine_draw_clip;
+
+    if(opaque && x_start == clip->x0 && y_start == clip->y0 && x_end == clip->x1 && y_end == clip->y1){
+        clip->covered = true;
+    }
+}
+
+
 void ENGINE_FAST_FUNCTION(engine_draw_fill_color)(uint16_t color, uint16_t *screen_buffer){
-    uint16_t *buf = screen_buffer;
-    uint16_t count = SCREEN_BUFFER_SIZE_PIXELS;
+    // Two pixels per write, screen buffers are word aligned (malloc)
+    uint32_t *buf = (uint32_t*)screen_buffer;
+    uint32_t color_pair = ((uint32_t)color << 16) | color;
+    uint32_t count = SCREEN_BUFFER_SIZE_PIXELS / 2;
 
-    while(count--) *buf++ = color;
+    while(count--) *buf++ = color_pair;
 }
 
 
 void ENGINE_FAST_FUNCTION(engine_draw_fill_buffer)(uint16_t* src_buffer, uint16_t *screen_buffer){
-    uint16_t index = 0;
+    memcpy(screen_buffer, src_buffer, SCREEN_BUFFER_SIZE_BYTES);
+}
+
+
+void ENGINE_FAST_FUNCTION(engine_draw_fill_color_rect)(uint16_t color, uint16_t *screen_buffer, int32_t x, int32_t y, int32_t width, int32_t height){
+    uint16_t *row = screen_buffer + y*SCREEN_WIDTH + x;
 
-    while(index < SCREEN_BUFFER_SIZE_PIXELS){
-        screen_buffer[index] = src_buffer[index];
-        index++;
+    while(height--){
+        uint16_t *buf = row;
+        int32_t count = width;
+
+        while(count--) *buf++ = color;
+
+        row += SCREEN_WIDTH;
+    }
+}
+
+
+void ENGINE_FAST_FUNCTION(engine_draw_fill_buffer_rect)(uint16_t* src_buffer, uint16_t *screen_buffer, int32_t x, int32_t y, int32_t width, int32_t height){
+    uint32_t offset = y*SCREEN_WIDTH + x;
+
+    while(height--){
+        memcpy(screen_buffer + offset, src_buffer + offset, width*sizeof(uint16_t));
+        offset += SCREEN_WIDTH;
     }
 }
 
 
 void ENGINE_FAST_FUNCTION(engine_draw_pixel)(uint16_t color, int32_t x, int32_t y, float alpha, engine_shader_t *shader){
-    if((x >= 0 && x < SCREEN_WIDTH) && (y >= 0 && y < SCREEN_HEIGHT)){
-        uint16_t index = y * SCREEN_WIDTH + x;
+    // Single pixels are not worth recording, draw
+    // them after whatever was recorded before them
+    if(engine_draw_deferred_is_recording()){
+        engine_draw_deferred_flush();
+    }
+
+    const engine_draw_clip_t *clip = engine_draw_clip;
 
-        active_screen_buffer[index] = shader->execute(active_screen_buffer[index], color, alpha, shader);
+    if((x >= clip->x0 && x < clip->x1) && (y >= clip->y0 && y < clip->y1)){
+        uint16_t *target = engine_draw_target_buffer();
+        uint16_t index = y * engine_draw_target_width + x;
+
+        target[index] = shader->execute(target[index], color, alpha, shader);
     }
 }
 
 
 void ENGINE_FAST_FUNCTION(engine_draw_pixel_no_check)(uint16_t color, int32_t x, int32_t y, float alpha, engine_shader_t *shader){
-    uint16_t index = y * SCREEN_WIDTH + x;
-    active_screen_buffer[index] = shader->execute(active_screen_buffer[index], color, alpha, shader);
+    uint16_t *target = engine_draw_target_buffer();
+    uint16_t index = y * engine_draw_target_width + x;
+    target[index] = shader->execute(target[index], color, alpha, shader);
+}
+
+
+// Coordinates further out than this are clamped before being converted
+// to integers for 'engine_draw_line()', keeps every product it makes of
+// them well inside 64 bits
+#define ENGINE_DRAW_LINE_MAX_COORDINATE 268435456.0f
+
+
+static inline int32_t engine_draw_line_coordinate(float value){
+    if(!(value > -ENGINE_DRAW_LINE_MAX_COORDINATE)) return (int32_t)-ENGINE_DRAW_LINE_MAX_COORDINATE;
+    if(value > ENGINE_DRAW_LINE_MAX_COORDINATE) return (int32_t)ENGINE_DRAW_LINE_MAX_COORDINATE;
+    return (int32_t)floorf(value);
+}
+
+
+// Ceil division for a positive 'denominator'
+static inline int64_t engine_draw_ceil_div(int64_t numerator, int64_t denominator){
+    int64_t quotient = numerator / denominator;
+    if(numerator % denominator != 0 && numerator > 0) quotient++;
+    return quotient;
+}
+
+
+// Narrows the steps '[*k_start, *k_end]' of a line to the ones where
+// 'start + sign*offset' is inside '[clip_start, clip_end)'
+static inline void engine_draw_line_clip_offsets(int64_t *offset_start, int64_t *offset_end, int32_t start, int32_t sign, int32_t clip_start, int32_t clip_end){
+    int64_t first, last;
+
+    if(sign > 0){
+        first = (int64_t)clip_start - start;
+        last = (int64_t)clip_end - 1 - start;
+    }else{
+        first = (int64_t)start - (clip_end - 1);
+        last = (int64_t)start - clip_start;
+    }
+
+    if(first > *offset_start) *offset_start = first;
+    if(last < *offset_end) *offset_end = last;
 }
 
 
-// https://en.wikipedia.org/wiki/Digital_differential_analyzer_(graphics_algorithm)
+// Integer Bresenham from the pixel the start is in to the pixel the end
+// is in, not including the start pixel (lines that share an endpoint,
+// like the sides of an outline, don't blend it twice). Step 'k' along
+// the major axis is 'k*minor/major' rounded along the minor axis so the
+// steps inside the clip are solved for up front and only those are
+// walked, each written straight to the target. Rows of an x-major line
+// are filled as spans
 void engine_draw_line(uint16_t color, float x_start, float y_start, float x_end, float y_end, mp_obj_t camera_node_base_in, float alpha, engine_shader_t *shader){
-    // Distance difference between endpoints
-    float dx = x_end - x_start;
-    float dy = y_end - y_start;
-
-    // See which axis requires most steps to draw complete line, store it
-    float step_count = 0.0f;
-    if(abs((int)dx) >= abs((int)dy)){
-        step_count = abs((int)dx);
+    if(engine_draw_deferred_is_recording()){
+        engine_draw_deferred_record_line(color, x_start, y_start, x_end, y_end, alpha, shader);
+        return;
+    }
+
+    int32_t x0 = engine_draw_line_coordinate(x_start);
+    int32_t y0 = engine_draw_line_coordinate(y_start);
+    int32_t x1 = engine_draw_line_coordinate(x_end);
+    int32_t y1 = engine_draw_line_coordinate(y_end);
+
+    int32_t sx = (x1 >= x0) ? 1 : -1;
+    int32_t sy = (y1 >= y0) ? 1 : -1;
+    int64_t adx = (int64_t)(x1 - (int64_t)x0) * sx;
+    int64_t ady = (int64_t)(y1 - (int64_t)y0) * sy;
+
+    // Major axis 'a' is stepped every pixel, minor axis 'b' only when
+    // the rounded offset along it changes
+    bool x_major = adx >= ady;
+    int64_t major = x_major ? adx : ady;
+    int64_t minor = x_major ? ady : adx;
+
+    if(major == 0){
+        return;
+    }
+
+    const engine_draw_clip_t *clip = engine_draw_clip;
+
+    int32_t a0 = x_major ? x0 : y0;
+    int32_t b0 = x_major ? y0 : x0;
+    int32_t sa = x_major ? sx : sy;
+    int32_t sb = x_major ? sy : sx;
+
+    // Steps inside the clip along the major axis
+    int64_t k_start = 1;
+    int64_t k_end = major;
+    if(x_major){
+        engine_draw_line_clip_offsets(&k_start, &k_end, a0, sa, clip->x0, clip->x1);
+    }else{
+        engine_draw_line_clip_offsets(&k_start, &k_end, a0, sa, clip->y0, clip->y1);
+    }
+
+    // Minor offset of step 'k' is 'm(k) = floor((2*k*minor + major) / (2*major))'
+    // which only grows with 'k', turn the offsets inside the clip along
+    // the minor axis into steps too
+    int64_t m_start = 0;
+    int64_t m_end = minor;
+    if(x_major){
+        engine_draw_line_clip_offsets(&m_start, &m_end, b0, sb, clip->y0, clip->y1);
+    }else{
+        engine_draw_line_clip_offsets(&m_start, &m_end, b0, sb, clip->x0, clip->x1);
+    }
+
+    if(m_start > m_end){
+        return;
+    }
+
+    if(minor > 0){
+        // First 'k' with 'm(k) >= m_start' and last with 'm(k) <= m_end'
+        int64_t first = engine_draw_ceil_div((2*m_start - 1) * major, 2*minor);
+        int64_t last = engine_draw_ceil_div((2*m_end + 1) * major, 2*minor) - 1;
+        if(first > k_start) k_start = first;
+        if(last < k_end) k_end = last;
+    }
+
+    if(k_start > k_end){
+        return;
+    }
+
+    // Error term of the first step inside the clip, from here on it's
+    // plain Bresenham
+    int64_t numerator = 2*k_start*minor + major;
+    int32_t m = (int32_t)(numerator / (2*major));
+    int32_t error = (int32_t)(numerator % (2*major));
+    int32_t error_step = (int32_t)(2*minor);
+    int32_t error_wrap = (int32_t)(2*major);
+
+    int32_t width = engine_draw_target_width;
+    int32_t x = x_major ? a0 + sa*(int32_t)k_start : b0 + sb*m;
+    int32_t y = x_major ? b0 + sb*m : a0 + sa*(int32_t)k_start;
+
+    uint16_t *target = engine_draw_target_buffer();
+    uint16_t *pixel = target + y*width + x;
+    int32_t count = (int32_t)(k_end - k_start) + 1;
+
+    if(x_major){
+        int32_t row_step = sb * width;
+        uint16_t *run_first = pixel;
+        uint32_t run_count = 0;
+
+        while(count--){
+            run_count++;
+
+            error += error_step;
+            if(error >= error_wrap){
+                error -= error_wrap;
+
+                // Spans are filled from their left-most pixel
+                shader->execute_fill((sa > 0) ? run_first : pixel, color, run_count, alpha, shader);
+                pixel += row_step;
+                run_count = 0;
+                run_first = pixel + sa;
+            }
+
+            pixel += sa;
+        }
+
+        if(run_count > 0){
+            shader->execute_fill((sa > 0) ? run_first : pixel - sa, color, run_count, alpha, shader);
+        }
     }else{
-        step_count = abs((int)dy);
+        int32_t row_step = sa * width;
+
+        while(count--){
+            *pixel = shader->execute(*pixel, color, alpha, shader);
+
+            error += error_step;
+            if(error >= error_wrap){
+                error -= error_wrap;
+                pixel += sb;
+            }
+
+            pixel += row_step;
+        }
     }
+}
 
-    // Calculate how much to increment each axis each step
-    float slope_x = dx / step_count;
-    float slope_y = dy / step_count;
 
-    float line_x = x_start;
-    float line_y = y_start;
 
-    // Draw the line
-    for(uint32_t step=0; step<step_count; step++){
-        line_x = line_x + slope_x;
-        line_y = line_y + slope_y;
+// Passes a collected run of 'count' colors that start at 'dest_offset' in
+// the target to the shader and starts a new run
+static inline void engine_draw_flush_span(uint32_t dest_offset, const uint16_t *colors, uint32_t *count, float alpha, engine_shader_t *shader){
+    if(*count > 0){
+        shader->execute_span(engine_draw_target_buffer()+dest_offset, colors, *count, alpha, shader);
+        *count = 0;
+    }
+}
 
-        engine_draw_pixel(color, (int32_t)line_x, (int32_t)line_y, alpha, shader);
+
+// Same as above but the whole run is the same 'color'
+static inline void engine_draw_flush_fill(uint32_t dest_offset, uint16_t color, uint32_t *count, float alpha, engine_shader_t *shader){
+    if(*count > 0){
+        shader->execute_fill(engine_draw_target_buffer()+dest_offset, color, *count, alpha, shader);
+        *count = 0;
     }
 }
 
 
+// Clips the destination span '[start, end)' of an axis aligned draw to
+// '[clip_start, clip_end)' of the clip and to the '[box_start, box_start+dim)'
+// bounding square the general rotating paths below are limited to. Returns
+// 'false' if empty
+static bool engine_draw_clip_axis_aligned_span(int32_t *start, int32_t *end, int32_t box_start, int32_t dim, int32_t clip_start, int32_t clip_end){
+    if(*start < box_start) *start = box_start;
+    if(*end > box_start + dim) *end = box_start + dim;
+    if(*start < clip_start) *start = clip_start;
+    if(*end > clip_end) *end = clip_end;
+
+    return *start < *end;
+}
+
+
+// Blit for when rotation is 0 and scale is a positive whole number. Fills
+// exactly the pixels the general path in 'engine_draw_blit' would, but
+// walks destination rows with integer steps instead of per-pixel float
+// math and passes whole rows (or runs between 'transparent_color'
+// pixels) to the shader. Unscaled RGB565 rows are passed straight from
+// the texture (a memcpy with the empty shader)
+static void engine_draw_blit_axis_aligned(texture_resource_class_obj_t *texture, uint32_t offset, float center_x, float center_y, int32_t window_width, int32_t window_height, uint32_t pixels_stride, int32_t x_scale, int32_t y_scale, uint16_t transparent_color, float alpha, engine_shader_t *shader){
+    float scaled_window_width = (float)(window_width * x_scale);
+    float scaled_window_height = (float)(window_height * y_scale);
+
+    // Same bounding square as the general path
+    int32_t dim = (int32_t)sqrtf((scaled_window_width*scaled_window_width) + (scaled_window_height*scaled_window_height));
+    float dim_half = (dim / 2.0f);
+
+    int32_t top_left_x = (int32_t)floorf(center_x - dim_half);
+    int32_t top_left_y = (int32_t)floorf(center_y - dim_half);
+
+    // Where the unrotated bitmap starts inside that square
+    int32_t left = top_left_x - (int32_t)floorf(scaled_window_width*0.5f - dim_half);
+    int32_t top = top_left_y - (int32_t)floorf(scaled_window_height*0.5f - dim_half);
+
+    int32_t x_start = left;
+    int32_t x_end = left + window_width*x_scale;
+    int32_t y_start = top;
+    int32_t y_end = top + window_height*y_scale;
+
+    const engine_draw_clip_t *clip = engine_draw_clip;
+
+    if(engine_draw_clip_axis_aligned_span(&x_start, &x_end, top_left_x, dim, clip->x0, clip->x1) == false ||
+       engine_draw_clip_axis_aligned_span(&y_start, &y_end, top_left_y, dim, clip->y0, clip->y1) == false){
+        return;
+    }
+
+    bool direct_rgb565 = (texture->get_pixel == texture_resource_get_16bit_rgb565 && x_scale == 1);
+    bool no_transparency = (transparent_color == ENGINE_NO_TRANSPARENCY_COLOR);
+    uint16_t *pixels = (uint16_t*)((mp_obj_array_t*)texture->data)->items;
+
+    // Stays true unless a pixel is skipped or blended
+    bool opaque = (texture->alpha_mask == 0 && shader->blend == ENGINE_SHADER_NO_BLEND);
+
+    // Source column of the first drawn destination pixel and how many
+    // destination pixels are left before moving to the next column
+    int32_t first_src_x = (x_start - left) / x_scale;
+    int32_t first_repeat_x = x_scale - ((x_start - left) % x_scale);
+    int32_t count = x_end - x_start;
+
+    // Decoded (and scaled) source row for when the texture
+    // can't be passed to the shader directly
+    uint16_t row_colors[SCREEN_WIDTH];
+
+    for(int32_t dest_y=y_start; dest_y<y_end; dest_y++){
+        uint32_t src_offset = offset + ((dest_y - top) / y_scale) * pixels_stride + first_src_x;
+        uint16_t *dest = engine_draw_target_buffer() + dest_y*engine_draw_target_width + x_start;
+        int32_t repeat = first_repeat_x;
+
+        // Textures with per-pixel alpha still go one pixel at a time
+        if(texture->alpha_mask != 0){
+            for(int32_t i=0; i<count; i++){
+                float src_alpha = 1.0f;
+                uint16_t src_color = texture->get_pixel(texture, src_offset, &src_alpha);
+
+                if(src_color != transparent_color || src_color == ENGINE_NO_TRANSPARENCY_COLOR){
+                    dest[i] = shader->execute(dest[i], src_color, alpha*src_alpha, shader);
+                }
+
+                if(--repeat == 0){
+                    src_offset++;
+                    repeat = x_scale;
+                }
+            }
+
+            continue;
+        }
+
+        const uint16_t *src = pixels + src_offset;
+
+        if(direct_rgb565 == false){
+            // Only decode each source pixel once, even when scaled up
+            float src_alpha = 1.0f;
+            uint16_t src_color = texture->get_pixel(texture, src_offset, &src_alpha);
+
+            for(int32_t i=0; i<count; i++){
+                row_colors[i] = src_color;
+
+                if(--repeat == 0){
+                    src_offset++;
+                    repeat = x_scale;
+
+                    if(i+1 < count){
+                        src_color = texture->get_pixel(texture, src_offset, &src_alpha);
+                    }
+                }
+            }
+
+            src = row_colors;
+        }
+
+        if(no_transparency){
+            shader->execute_span(dest, src, count, alpha, shader);
+        }else{
+            // Skip runs of transparent pixels, shade runs of the rest
+            int32_t i = 0;
+            while(i < count){
+                int32_t skip_start = i;
+                while(i < count && src[i] == transparent_color) i++;
+                if(i > skip_start) opaque = false;
+
+                int32_t run_start = i;
+                while(i < count && src[i] != transparent_color) i++;
+
+                if(i > run_start){
+                    shader->execute_span(dest+run_start, src+run_start, i-run_start, alpha, shader);
+                }
+            }
+        }
+    }
+
+    engine_draw_check_covered(x_start, x_end, y_start, y_end, opaque);
+}
+
+
+// Rect for when rotation is 0 and scale is positive. Fills exactly the
+// pixels the general path in 'engine_draw_rect' would, as row spans
+static void engine_draw_rect_axis_aligned(uint16_t color, float center_x, float center_y, int32_t width, int32_t height, float x_scale, float y_scale, float alpha, engine_shader_t *shader){
+    float scaled_width = width * x_scale;
+    float scaled_height = height * y_scale;
+
+    // Same bounding square as the general path
+    int32_t dim = (int32_t)sqrtf((scaled_width*scaled_width) + (scaled_height*scaled_height));
+    float dim_half = (dim / 2.0f);
+
+    int32_t top_left_x = (int32_t)floorf(center_x - dim_half);
+    int32_t top_left_y = (int32_t)floorf(center_y - dim_half);
+
+    // The general path fills destination 'x' where
+    // '0 <= x + offset_x < scaled_width' (same for y)
+    float offset_x = scaled_width*0.5f - dim_half - top_left_x;
+    float offset_y = scaled_height*0.5f - dim_half - top_left_y;
+
+    int32_t x_start = (int32_t)ceilf(-offset_x);
+    int32_t x_end = (int32_t)ceilf(scaled_width - offset_x);
+    int32_t y_start = (int32_t)ceilf(-offset_y);
+    int32_t y_end = (int32_t)ceilf(scaled_height - offset_y);
+
+    const engine_draw_clip_t *clip = engine_draw_clip;
+
+    if(engine_draw_clip_axis_aligned_span(&x_start, &x_end, top_left_x, dim, clip->x0, clip->x1) == false ||
+       engine_draw_clip_axis_aligned_span(&y_start, &y_end, top_left_y, dim, clip->y0, clip->y1) == false){
+        return;
+    }
+
+    int32_t count = x_end - x_start;
+
+    for(int32_t dest_y=y_start; dest_y<y_end; dest_y++){
+        shader->execute_fill(engine_draw_target_buffer() + dest_y*engine_draw_target_width + x_start, color, count, alpha, shader);
+    }
+
+    engine_draw_check_covered(x_start, x_end, y_start, y_end, shader->blend == ENGINE_SHADER_NO_BLEND);
+}
 
 
 void engine_draw_blit(texture_resource_class_obj_t *texture, uint32_t offset, float center_x, float center_y, int32_t window_width, int32_t window_height, uint32_t pixels_stride, float x_scale, float y_scale, float rotation_radians, uint16_t transparent_color, float alpha, engine_shader_t *shader){
@@ -105,6 +597,21 @@ void engine_draw_blit(texture_resource_class_obj_t *texture, uint32_t offset, fl
         The displacements are performed twice on the x-axis and once on the y axis in x y x order.
     */
 
+    if(!(engine_math_compare_floats(rotation_radians, 0.0f) && x_scale >= 1.0f && y_scale >= 1.0f && engine_draw_is_whole(x_scale) && engine_draw_is_whole(y_scale) && engine_draw_is_whole(center_x) && engine_draw_is_whole(center_y))){
+        engine_draw_shift_exact = false;
+    }
+
+    if(engine_draw_deferred_is_recording()){
+        engine_draw_deferred_record_blit(texture, offset, center_x, center_y, window_width, window_height, pixels_stride, x_scale, y_scale, rotation_radians, transparent_color, alpha, shader);
+        return;
+    }
+
+    // Most sprites are not rotated and drawn at whole number scales
+    if(engine_math_compare_floats(rotation_radians, 0.0f) && x_scale >= 1.0f && y_scale >= 1.0f && x_scale == floorf(x_scale) && y_scale == floorf(y_scale)){
+        engine_draw_blit_axis_aligned(texture, offset, center_x, center_y, window_width, window_height, pixels_stride, (int32_t)x_scale, (int32_t)y_scale, transparent_color, alpha, shader);
+        return;
+    }
+
     // ENGINE_PERFORMANCE_CYCLES_START();
     float inverse_x_scale = 1.0f / x_scale;
     float inverse_y_scale = 1.0f / y_scale;
@@ -134,12 +641,16 @@ void engine_draw_blit(texture_resource_class_obj_t *texture, uint32_t offset, fl
     int32_t top_left_x = (int32_t)floorf(center_x - dim_half);
     int32_t top_left_y = (int32_t)floorf(center_y - dim_half);
 
-    // If the top-left is above the viewport but
+    // The viewport unless rasterizing a tile
+    const engine_draw_clip_t *clip = engine_draw_clip;
+    uint16_t *target = engine_draw_target_buffer();
+
+    // If the top-left is above the clip but
     // the bitmap may eventually showup, clip the
     // top of the destination rectangle
     int32_t j_start = 0;
-    if(top_left_y < 0){
-        j_start = abs(top_left_y);
+    if(top_left_y < clip->y0){
+        j_start = clip->y0 - top_left_y;
     }
 
     // If the top-left is left of the viewport
@@ -150,25 +661,26 @@ void engine_draw_blit(texture_resource_class_obj_t *texture, uint32_t offset, fl
         i_start = abs(top_left_x);
     }
 
-    // 1D index into the screen buffer of where the bitmap will go
-    const uint32_t center_pixel_offset = (top_left_y+j_start) * SCREEN_WIDTH + (top_left_x+i_start);
-
-    // Used for tracking where we are in the screen_buffer
-    uint32_t dest_offset = center_pixel_offset;
-
-    // The stride to the next row usually consists of just the
-    // screen width, however, subtract the dimensions of the 
-    // destination rect so that we end up at the next row
-    // in the rect. Also proceed forward on the next row
-    // by the amount we are left clipping the dest rect
-    uint32_t next_dest_row_offset = SCREEN_WIDTH - dim + i_start;
+    // Rows always start traversing the source at the left of the
+    // viewport and step over the pixels left of the clip, this way
+    // a tile gets exactly the pixels drawing in one go would
+    int32_t i_clip_start = i_start;
+    if(top_left_x+i_clip_start < clip->x0){
+        i_clip_start = clip->x0 - top_left_x;
+    }
 
     int32_t i, j;
 
+    // Runs of neighboring opaque pixels on a row are collected
+    // here and passed to the shader together
+    uint16_t span_colors[SCREEN_WIDTH];
+    uint32_t span_dest_offset = 0;
+    uint32_t span_count = 0;
+
     // Start from clipped top and go until max destination rectangle
     // height (bounding-box) or until the start drawing out of bounds
     // (clip bottom)
-    for(j=j_start; j<dim && top_left_y+j < SCREEN_HEIGHT; j++){
+    for(j=j_start; j<dim && top_left_y+j < clip->y1; j++){
         // Center inside destination rectangle.
         // Offset where we are in the src bitmap
         // by left-clip amount ('i_start')
@@ -181,52 +693,62 @@ void engine_draw_blit(texture_resource_class_obj_t *texture, uint32_t offset, fl
         float x = (half_scaled_window_width + deltaX * cos_angle + deltaY * sin_angle) * inverse_x_scale;
         float y = (half_scaled_window_height - deltaX * sin_angle + deltaY * cos_angle) * inverse_y_scale;
 
-        for(i=i_start; i<dim; i++){
-            // Check if drawing to draw out of bounds to the right,
-            // if so, stop drawing the destination row early and
-            // move on to the next
-            if(top_left_x+i < SCREEN_WIDTH){
-                // Uncomment to see background. Drawing
-                // sprites that are thin could be optimized
-                // screen_buffer[dest_offset] = 0b11111000000000;
-
-                // Floor these otherwise get artifacts (don't exactly know why).
-                // Floor + int seems to be faster than comparing floats
-                int32_t rotX = (int32_t)floorf(x);
-                int32_t rotY = (int32_t)floorf(y);
-
-                // If statements are expensive! Don't need to check if withing screen
-                // bounds since those dimensions are clipped (destination rect)
-                if((rotX >= 0 && rotX < window_width) && (rotY >= 0 && rotY < window_height)){
-                    uint32_t src_offset = rotY * pixels_stride + rotX;
-                    // uint16_t src_color = pixels[src_offset];
-                    float src_alpha = 1.0f;
-                    uint16_t src_color = texture->get_pixel(texture, offset+src_offset, &src_alpha);
-
-                    if(src_color != transparent_color || src_color == ENGINE_NO_TRANSPARENCY_COLOR){
-                        // active_screen_buffer[dest_offset] = shader->execute(active_screen_buffer[dest_offset], src_color, alpha, shader);
-                        active_screen_buffer[dest_offset] = shader->execute(active_screen_buffer[dest_offset], src_color, alpha*src_alpha, shader);
-                    }
-                }
+        // Step over the pixels left of the clip
+        for(i=i_start; i<i_clip_start; i++){
+            x += cos_angle_inv_scaled;
+            y -= sin_angle_inv_scaled;
+        }
 
-                // While in row, keep traversing about rotation
-                x += cos_angle_inv_scaled;
-                y -= sin_angle_inv_scaled;
+        // Used for tracking where we are in the screen_buffer
+        uint32_t dest_offset = (top_left_y+j) * engine_draw_target_width + (top_left_x+i_clip_start);
+
+        // Go until the max destination rectangle width or
+        // until drawing out of bounds to the right (clip right)
+        for(i=i_clip_start; i<dim && top_left_x+i < clip->x1; i++){
+            // Uncomment to see background. Drawing
+            // sprites that are thin could be optimized
+            // screen_buffer[dest_offset] = 0b11111000000000;
+
+            // Floor these otherwise get artifacts (don't exactly know why).
+            // Floor + int seems to be faster than comparing floats
+            int32_t rotX = (int32_t)floorf(x);
+            int32_t rotY = (int32_t)floorf(y);
+
+            // If statements are expensive! Don't need to check if withing screen
+            // bounds since those dimensions are clipped (destination rect)
+            if((rotX >= 0 && rotX < window_width) && (rotY >= 0 && rotY < window_height)){
+                uint32_t src_offset = rotY * pixels_stride + rotX;
+                // uint16_t src_color = pixels[src_offset];
+                float src_alpha = 1.0f;
+                uint16_t src_color = texture->get_pixel(texture, offset+src_offset, &src_alpha);
+
+                if(src_color != transparent_color || src_color == ENGINE_NO_TRANSPARENCY_COLOR){
+                    if(src_alpha == 1.0f){
+                        if(span_count == 0){
+                            span_dest_offset = dest_offset;
+                        }
 
-                // Go to next pixel next time to set it
-                dest_offset += 1;
+                        span_colors[span_count++] = src_color;
+                    }else{
+                        engine_draw_flush_span(span_dest_offset, span_colors, &span_count, alpha, shader);
+                        target[dest_offset] = shader->execute(target[dest_offset], src_color, alpha*src_alpha, shader);
+                    }
+                }else{
+                    engine_draw_flush_span(span_dest_offset, span_colors, &span_count, alpha, shader);
+                }
             }else{
-                // After this will be a subtraction by 'dim'
-                // but we need to be at the end of the row
-                // for that to work, set 'dest_offset' to end
-                // See 'next_dest_row_offset'
-                dest_offset += dim-i;
-                break;
+                engine_draw_flush_span(span_dest_offset, span_colors, &span_count, alpha, shader);
             }
+
+            // While in row, keep traversing about rotation
+            x += cos_angle_inv_scaled;
+            y -= sin_angle_inv_scaled;
+
+            // Go to next pixel next time to set it
+            dest_offset += 1;
         }
 
-        // Go to next row but at the left of it (SCREEN_WIDTH - dim)
-        dest_offset += next_dest_row_offset;
+        engine_draw_flush_span(span_dest_offset, span_colors, &span_count, alpha, shader);
     }
 
     // ENGINE_PERFORMANCE_CYCLES_STOP();
@@ -254,6 +776,14 @@ void engine_draw_blit_depth(texture_resource_class_obj_t *texture, uint32_t offs
         The displacements are performed twice on the x-axis and once on the y axis in x y x order.
     */
 
+    // Drawn at positions and depths that depend on the camera
+    engine_draw_shift_exact = false;
+
+    if(engine_draw_deferred_is_recording()){
+        engine_draw_deferred_record_blit_depth(texture, offset, center_x, center_y, window_width, window_height, pixels_stride, x_scale, y_scale, rotation_radians, transparent_color, alpha, depth, shader);
+        return;
+    }
+
     // ENGINE_PERFORMANCE_CYCLES_START();
     float inverse_x_scale = 1.0f / x_scale;
     float inverse_y_scale = 1.0f / y_scale;
@@ -283,12 +813,16 @@ void engine_draw_blit_depth(texture_resource_class_obj_t *texture, uint32_t offs
     int32_t top_left_x = (int32_t)floorf(center_x - dim_half);
     int32_t top_left_y = (int32_t)floorf(center_y - dim_half);
 
-    // If the top-left is above the viewport but
+    // The viewport unless rasterizing a tile
+    const engine_draw_clip_t *clip = engine_draw_clip;
+    uint16_t *target = engine_draw_target_buffer();
+
+    // If the top-left is above the clip but
     // the bitmap may eventually showup, clip the
     // top of the destination rectangle
     int32_t j_start = 0;
-    if(top_left_y < 0){
-        j_start = abs(top_left_y);
+    if(top_left_y < clip->y0){
+        j_start = clip->y0 - top_left_y;
     }
 
     // If the top-left is left of the viewport
@@ -299,25 +833,20 @@ void engine_draw_blit_depth(texture_resource_class_obj_t *texture, uint32_t offs
         i_start = abs(top_left_x);
     }
 
-    // 1D index into the screen buffer of where the bitmap will go
-    const uint32_t center_pixel_offset = (top_left_y+j_start) * SCREEN_WIDTH + (top_left_x+i_start);
-
-    // Used for tracking where we are in the screen_buffer
-    uint32_t dest_offset = center_pixel_offset;
-
-    // The stride to the next row usually consists of just the
-    // screen width, however, subtract the dimensions of the 
-    // destination rect so that we end up at the next row
-    // in the rect. Also proceed forward on the next row
-    // by the amount we are left clipping the dest rect
-    uint32_t next_dest_row_offset = SCREEN_WIDTH - dim + i_start;
+    // Rows always start traversing the source at the left of the
+    // viewport and step over the pixels left of the clip, this way
+    // a tile gets exactly the pixels drawing in one go would
+    int32_t i_clip_start = i_start;
+    if(top_left_x+i_clip_start < clip->x0){
+        i_clip_start = clip->x0 - top_left_x;
+    }
 
     int32_t i, j;
 
     // Start from clipped top and go until max destination rectangle
     // height (bounding-box) or until the start drawing out of bounds
     // (clip bottom)
-    for(j=j_start; j<dim && top_left_y+j < SCREEN_HEIGHT; j++){
+    for(j=j_start; j<dim && top_left_y+j < clip->y1; j++){
         // Center inside destination rectangle.
         // Offset where we are in the src bitmap
         // by left-clip amount ('i_start')
@@ -330,53 +859,49 @@ void engine_draw_blit_depth(texture_resource_class_obj_t *texture, uint32_t offs
         float x = (half_scaled_window_width + deltaX * cos_angle + deltaY * sin_angle) * inverse_x_scale;
         float y = (half_scaled_window_height - deltaX * sin_angle + deltaY * cos_angle) * inverse_y_scale;
 
-        for(i=i_start; i<dim; i++){
-            // Check if drawing to draw out of bounds to the right,
-            // if so, stop drawing the destination row early and
-            // move on to the next
-            if(top_left_x+i < SCREEN_WIDTH){
-                // Uncomment to see background. Drawing
-                // sprites that are thin could be optimized
-                // screen_buffer[dest_offset] = 0b11111000000000;
-
-                // Floor these otherwise get artifacts (don't exactly know why).
-                // Floor + int seems to be faster than comparing floats
-                int32_t rotX = (int32_t)floorf(x);
-                int32_t rotY = (int32_t)floorf(y);
-
-                // If statements are expensive! Don't need to check if withing screen
-                // bounds since those dimensions are clipped (destination rect)
-                if((rotX >= 0 && rotX < window_width) && (rotY >= 0 && rotY < window_height)){
-                    uint32_t src_offset = rotY * pixels_stride + rotX;
-                    // uint16_t src_color = pixels[src_offset];
-                    float src_alpha = 1.0f;
-                    uint16_t src_color = texture->get_pixel(texture, offset+src_offset, &src_alpha);
-
-                    if(src_color != transparent_color || src_color == ENGINE_NO_TRANSPARENCY_COLOR){
-                        if(engine_display_store_check_depth_index(dest_offset, depth)){
-                            active_screen_buffer[dest_offset] = shader->execute(active_screen_buffer[dest_offset], src_color, alpha*src_alpha, shader);
-                        }
+        // Step over the pixels left of the clip
+        for(i=i_start; i<i_clip_start; i++){
+            x += cos_angle_inv_scaled;
+            y -= sin_angle_inv_scaled;
+        }
+
+        // Used for tracking where we are in the screen_buffer
+        uint32_t dest_offset = (top_left_y+j) * engine_draw_target_width + (top_left_x+i_clip_start);
+
+        // Go until the max destination rectangle width or
+        // until drawing out of bounds to the right (clip right)
+        for(i=i_clip_start; i<dim && top_left_x+i < clip->x1; i++){
+            // Uncomment to see background. Drawing
+            // sprites that are thin could be optimized
+            // screen_buffer[dest_offset] = 0b11111000000000;
+
+            // Floor these otherwise get artifacts (don't exactly know why).
+            // Floor + int seems to be faster than comparing floats
+            int32_t rotX = (int32_t)floorf(x);
+            int32_t rotY = (int32_t)floorf(y);
+
+            // If statements are expensive! Don't need to check if withing screen
+            // bounds since those dimensions are clipped (destination rect)
+            if((rotX >= 0 && rotX < window_width) && (rotY >= 0 && rotY < window_height)){
+                uint32_t src_offset = rotY * pixels_stride + rotX;
+                // uint16_t src_color = pixels[src_offset];
+                float src_alpha = 1.0f;
+                uint16_t src_color = texture->get_pixel(texture, offset+src_offset, &src_alpha);
+
+                if(src_color != transparent_color || src_color == ENGINE_NO_TRANSPARENCY_COLOR){
+                    if(engine_display_store_check_depth_index(dest_offset, depth)){
+                        target[dest_offset] = shader->execute(target[dest_offset], src_color, alpha*src_alpha, shader);
                     }
                 }
+            }
 
-                // While in row, keep traversing about rotation
-                x += cos_angle_inv_scaled;
-                y -= sin_angle_inv_scaled;
+            // While in row, keep traversing about rotation
+            x += cos_angle_inv_scaled;
+            y -= sin_angle_inv_scaled;
 
-                // Go to next pixel next time to set it
-                dest_offset += 1;
-            }else{
-                // After this will be a subtraction by 'dim'
-                // but we need to be at the end of the row
-                // for that to work, set 'dest_offset' to end
-                // See 'next_dest_row_offset'
-                dest_offset += dim-i;
-                break;
-            }
+            // Go to next pixel next time to set it
+            dest_offset += 1;
         }
-
-        // Go to next row but at the left of it (SCREEN_WIDTH - dim)
-        dest_offset += next_dest_row_offset;
     }
 
     // ENGINE_PERFORMANCE_CYCLES_STOP();
@@ -404,6 +929,21 @@ void engine_draw_rect(uint16_t color, float center_x, float center_y, int32_t wi
         The displacements are performed twice on the x-axis and once on the y axis in x y x order.
     */
 
+    if(!(engine_math_compare_floats(rotation_radians, 0.0f) && engine_draw_is_whole(center_x) && engine_draw_is_whole(center_y))){
+        engine_draw_shift_exact = false;
+    }
+
+    if(engine_draw_deferred_is_recording()){
+        engine_draw_deferred_record_rect(color, center_x, center_y, width, height, x_scale, y_scale, rotation_radians, alpha, shader);
+        return;
+    }
+
+    // UI and most other rectangles are not rotated
+    if(engine_math_compare_floats(rotation_radians, 0.0f) && x_scale > 0.0f && y_scale > 0.0f){
+        engine_draw_rect_axis_aligned(color, center_x, center_y, width, height, x_scale, y_scale, alpha, shader);
+        return;
+    }
+
     // ENGINE_PERFORMANCE_CYCLES_START();
     float inverse_x_scale = 1.0f / x_scale;
     float inverse_y_scale = 1.0f / y_scale;
@@ -433,12 +973,15 @@ void engine_draw_rect(uint16_t color, float center_x, float center_y, int32_t wi
     int32_t top_left_x = (int32_t)floorf(center_x - dim_half);
     int32_t top_left_y = (int32_t)floorf(center_y - dim_half);
 
-    // If the top-left is above the viewport but
+    // The viewport unless rasterizing a tile
+    const engine_draw_clip_t *clip = engine_draw_clip;
+
+    // If the top-left is above the clip but
     // the bitmap may eventually showup, clip the
     // top of the destination rectangle
     int32_t j_start = 0;
-    if(top_left_y < 0){
-        j_start = abs(top_left_y);
+    if(top_left_y < clip->y0){
+        j_start = clip->y0 - top_left_y;
     }
 
     // If the top-left is left of the viewport
@@ -449,25 +992,24 @@ void engine_draw_rect(uint16_t color, float center_x, float center_y, int32_t wi
         i_start = abs(top_left_x);
     }
 
-    // 1D index into the screen buffer of where the bitmap will go
-    const uint32_t center_pixel_offset = (top_left_y+j_start) * SCREEN_WIDTH + (top_left_x+i_start);
-
-    // Used for tracking where we are in the screen_buffer
-    uint32_t dest_offset = center_pixel_offset;
-
-    // The stride to the next row usually consists of just the
-    // screen width, however, subtract the dimensions of the 
-    // destination rect so that we end up at the next row
-    // in the rect. Also proceed forward on the next row
-    // by the amount we are left clipping the dest rect
-    uint32_t next_dest_row_offset = SCREEN_WIDTH - dim + i_start;
+    // Rows always start traversing the source at the left of the
+    // viewport and step over the pixels left of the clip, this way
+    // a tile gets exactly the pixels drawing in one go would
+    int32_t i_clip_start = i_start;
+    if(top_left_x+i_clip_start < clip->x0){
+        i_clip_start = clip->x0 - top_left_x;
+    }
 
     int32_t i, j;
 
+    // Neighboring pixels on a row are filled together
+    uint32_t span_dest_offset = 0;
+    uint32_t span_count = 0;
+
     // Start from clipped top and go until max destination rectangle
     // height (bounding-box) or until the start drawing out of bounds
     // (clip bottom)
-    for(j=j_start; j<dim && top_left_y+j < SCREEN_HEIGHT; j++){
+    for(j=j_start; j<dim && top_left_y+j < clip->y1; j++){
         // Center inside destination rectangle.
         // Offset where we are in the src bitmap
         // by left-clip amount ('i_start')
@@ -480,97 +1022,202 @@ void engine_draw_rect(uint16_t color, float center_x, float center_y, int32_t wi
         float x = (half_scaled_width + deltaX * cos_angle + deltaY * sin_angle) * inverse_x_scale;
         float y = (half_scaled_height - deltaX * sin_angle + deltaY * cos_angle) * inverse_y_scale;
 
-        for(i=i_start; i<dim; i++){
-            // Check if drawing to draw out of bounds to the right,
-            // if so, stop drawing the destination row early and
-            // move on to the next
-            if(top_left_x+i < SCREEN_WIDTH){
-                // Uncomment to see background. Drawing
-                // sprites that are thin could be optimized
-                // screen_buffer[dest_offset] = 0b11111000000000;
-
-                // Floor these otherwise get artifacts (don't exactly know why).
-                // Floor + int seems to be faster than comparing floats
-                int32_t rotX = (int32_t)floorf(x);
-                int32_t rotY = (int32_t)floorf(y);
-
-                // If statements are expensive! Don't need to check if withing screen
-                // bounds since those dimensions are clipped (destination rect)
-                if((rotX >= 0 && rotX < width) && (rotY >= 0 && rotY < height)){
-                    active_screen_buffer[dest_offset] = shader->execute(active_screen_buffer[dest_offset], color, alpha, shader);
-                }
+        // Step over the pixels left of the clip
+        for(i=i_start; i<i_clip_start; i++){
+            x += cos_angle_inv_scaled;
+            y -= sin_angle_inv_scaled;
+        }
 
-                // While in row, keep traversing about rotation
-                x += cos_angle_inv_scaled;
-                y -= sin_angle_inv_scaled;
+        // Used for tracking where we are in the screen_buffer
+        uint32_t dest_offset = (top_left_y+j) * engine_draw_target_width + (top_left_x+i_clip_start);
+
+        // Go until the max destination rectangle width or
+        // until drawing out of bounds to the right (clip right)
+        for(i=i_clip_start; i<dim && top_left_x+i < clip->x1; i++){
+            // Uncomment to see background. Drawing
+            // sprites that are thin could be optimized
+            // screen_buffer[dest_offset] = 0b11111000000000;
+
+            // Floor these otherwise get artifacts (don't exactly know why).
+            // Floor + int seems to be faster than comparing floats
+            int32_t rotX = (int32_t)floorf(x);
+            int32_t rotY = (int32_t)floorf(y);
+
+            // If statements are expensive! Don't need to check if withing screen
+            // bounds since those dimensions are clipped (destination rect)
+            if((rotX >= 0 && rotX < width) && (rotY >= 0 && rotY < height)){
+                if(span_count == 0){
+                    span_dest_offset = dest_offset;
+                }
 
-                // Go to next pixel next time to set it
-                dest_offset += 1;
+                span_count++;
             }else{
-                // After this will be a subtraction by 'dim'
-                // but we need to be at the end of the row
-                // for that to work, set 'dest_offset' to end
-                // See 'next_dest_row_offset'
-                dest_offset += dim-i;
-                break;
+                engine_draw_flush_fill(span_dest_offset, color, &span_count, alpha, shader);
             }
+
+            // While in row, keep traversing about rotation
+            x += cos_angle_inv_scaled;
+            y -= sin_angle_inv_scaled;
+
+            // Go to next pixel next time to set it
+            dest_offset += 1;
         }
 
-        // Go to next row but at the left of it (SCREEN_WIDTH - dim)
-        dest_offset += next_dest_row_offset;
+        engine_draw_flush_fill(span_dest_offset, color, &span_count, alpha, shader);
     }
 
     // ENGINE_PERFORMANCE_CYCLES_STOP();
 }
 
 
+// Writes the pixels '(center_x +/- a, center_y +/- b)' of an outline
+// circle, once each when 'a' or 'b' is zero. Only checks them against
+// the clip if the circle is not completely inside it
+static inline void engine_draw_circle_points(uint16_t *center, int32_t center_x, int32_t center_y, int32_t a, int32_t b, bool checked, uint16_t color, float alpha, engine_shader_t *shader){
+    const engine_draw_clip_t *clip = engine_draw_clip;
+    int32_t width = engine_draw_target_width;
+
+    int32_t xs[2] = {a, -a};
+    int32_t ys[2] = {b, -b};
+    int32_t x_count = (a == 0) ? 1 : 2;
+    int32_t y_count = (b == 0) ? 1 : 2;
+
+    for(int32_t iy=0; iy<y_count; iy++){
+        for(int32_t ix=0; ix<x_count; ix++){
+            int32_t x = xs[ix];
+            int32_t y = ys[iy];
+
+            if(checked && !(center_x+x >= clip->x0 && center_x+x < clip->x1 && center_y+y >= clip->y0 && center_y+y < clip->y1)){
+                continue;
+            }
+
+            uint16_t *pixel = center + y*width + x;
+            *pixel = shader->execute(*pixel, color, alpha, shader);
+        }
+    }
+}
+
+
+// Midpoint circle: walks one octant with an integer error term and
+// mirrors every pixel into the other seven. Circles completely outside
+// the clip are skipped and circles completely inside it are written
+// without checking each pixel
 void engine_draw_outline_circle(uint16_t color, float center_x, float center_y, float radius, float alpha, engine_shader_t *shader){
-    // https://stackoverflow.com/a/58629898
-    float distance = radius;
-    float angle_increment = acosf(1 - 1/distance) * 2.0f;   // Multiply by 2.0 since care about speed and not accuracy as much
+    if(engine_draw_deferred_is_recording()){
+        engine_draw_deferred_record_outline_circle(color, center_x, center_y, radius, alpha, shader);
+        return;
+    }
 
-    for(float angle = 0; angle <= 90; angle += angle_increment){
-        float cx = distance * cosf(angle);
-        float cy = distance * sinf(angle);
-        
-        // Bottom right quadrant of the circle
-        int brx = (int)(center_x+cx);
-        int bry = (int)(center_y+cy);
+    int32_t r = (int32_t)radius;
+    int32_t cx = (int32_t)floorf(center_x);
+    int32_t cy = (int32_t)floorf(center_y);
 
-        // Bottom left quadrant of the circle
-        int blx = (int)(center_x-cx);
-        int bly = (int)(center_y+cy);
+    if(r <= 0){
+        return;
+    }
+
+    const engine_draw_clip_t *clip = engine_draw_clip;
+
+    if(cx + r < clip->x0 || cx - r >= clip->x1 || cy + r < clip->y0 || cy - r >= clip->y1){
+        return;
+    }
+
+    bool checked = !(cx - r >= clip->x0 && cx + r < clip->x1 && cy - r >= clip->y0 && cy + r < clip->y1);
 
-        // Top right quadrant of the circle
-        int trx = (int)(center_x+cx);
-        int try = (int)(center_y-cy);
+    // Not dereferenced unless the center offset by a point of the
+    // circle lands inside the clip
+    uint16_t *center = engine_draw_target_buffer() + cy*engine_draw_target_width + cx;
 
-        // Top left quadrant of the circle
-        int tlx = (int)(center_x-cx);
-        int tly = (int)(center_y-cy);
+    int32_t x = r;
+    int32_t y = 0;
+    int32_t error = 1 - r;
 
-        engine_draw_pixel(color, brx, bry, alpha, shader);
-        engine_draw_pixel(color, blx, bly, alpha, shader);
-        engine_draw_pixel(color, trx, try, alpha, shader);
-        engine_draw_pixel(color, tlx, tly, alpha, shader);
+    while(x >= y){
+        engine_draw_circle_points(center, cx, cy, x, y, checked, color, alpha, shader);
+
+        // On the diagonal both octants are the same pixels
+        if(x != y){
+            engine_draw_circle_points(center, cx, cy, y, x, checked, color, alpha, shader);
+        }
+
+        y++;
+        if(error < 0){
+            error += 2*y + 1;
+        }else{
+            x--;
+            error += 2*(y - x) + 1;
+        }
     }
 }
 
 
+// Fills rows of a circle with spans: a pixel 'e' columns and 'n' rows away
+// from the center column and row is inside if 'e*e + n*n <= radius*radius'
+// (counting rows below the center from one, the old per-column fill did).
+// The widest column offset of each row is found by walking it from the
+// previous row instead of taking a square root per row
 void engine_draw_filled_circle(uint16_t color, float center_x, float center_y, float radius, float alpha, engine_shader_t *shader){
-    float radius_sqr = radius * radius;
-    int x_min = (int)(-radius);
-    int x_max = (int)radius;
+    if(engine_draw_deferred_is_recording()){
+        engine_draw_deferred_record_filled_circle(color, center_x, center_y, radius, alpha, shader);
+        return;
+    }
+
+    int32_t r = (int32_t)radius;
+
+    if(r <= 0){
+        return;
+    }
+
+    int64_t radius_sqr = (int64_t)floorf(radius * radius);
+    int32_t cx = (int32_t)floorf(center_x);
+    int32_t cy = (int32_t)floorf(center_y);
+
+    const engine_draw_clip_t *clip = engine_draw_clip;
+
+    // Columns span '-r <= e < r' and rows '-half_height <= dy < half_height'
+    if(cx + r <= clip->x0 || cx - r >= clip->x1){
+        return;
+    }
+
+    int32_t half_height = (int32_t)sqrtf((float)radius_sqr);
+    while((int64_t)half_height*half_height > radius_sqr) half_height--;
+    while((int64_t)(half_height+1)*(half_height+1) <= radius_sqr) half_height++;
+
+    int32_t dy_start = -half_height;
+    int32_t dy_end = half_height;
+    if(cy + dy_start < clip->y0) dy_start = clip->y0 - cy;
+    if(cy + dy_end > clip->y1) dy_end = clip->y1 - cy;
+
+    if(dy_start >= dy_end){
+        return;
+    }
+
+    // Estimate for the first row, corrected exactly by the walks below
+    int32_t first_needed = (dy_start >= 0) ? dy_start+1 : -dy_start;
+    float first_extent_sqr = (float)(radius_sqr - (int64_t)first_needed*first_needed);
+    int32_t extent = (first_extent_sqr > 0.0f) ? (int32_t)sqrtf(first_extent_sqr) : 0;
+
+    uint16_t *row = engine_draw_target_buffer() + (cy+dy_start)*engine_draw_target_width;
+
+    for(int32_t dy=dy_start; dy<dy_end; dy++){
+        int64_t needed = (dy >= 0) ? dy+1 : -dy;
+        int64_t extent_sqr = radius_sqr - needed*needed;
+
+        // Rows only get wider up to the center and narrower after it
+        while(extent > 0 && (int64_t)extent*extent > extent_sqr) extent--;
+        while((int64_t)(extent+1)*(extent+1) <= extent_sqr) extent++;
+
+        int32_t x_start = cx - extent;
+        int32_t x_end = cx + ((extent+1 < r) ? extent+1 : r);
 
-    // https://stackoverflow.com/a/59211338
-    for(int x=x_min; x<x_max; x++){
-        int hh = (int)sqrt(radius_sqr - x * x);
-        int rx = (int)center_x + x;
-        int ph = (int)center_y + hh;
+        if(x_start < clip->x0) x_start = clip->x0;
+        if(x_end > clip->x1) x_end = clip->x1;
 
-        for(int y=(int)center_y-hh; y<ph; y++){
-            engine_draw_pixel(color, rx, y, alpha, shader);
+        if(x_start < x_end){
+            shader->execute_fill(row + x_start, color, x_end - x_start, alpha, shader);
         }
+
+        row += engine_draw_target_width;
     }
 }
 
@@ -579,8 +1226,19 @@ void engine_draw_text(font_resource_class_obj_t *font, mp_obj_t text, float cent
     float sin_angle = sinf(rotation_radians);
     float cos_angle = cosf(rotation_radians);
 
-    float sin_angle_perp = sinf(rotation_radians + HALF_PI);
-    float cos_angle_perp = cosf(rotation_radians + HALF_PI);
+    // Rotated a quarter turn further, 'cosf(HALF_PI)' isn't exactly zero
+    // and would move unrotated text off by a bit
+    float sin_angle_perp = cos_angle;
+    float cos_angle_perp = -sin_angle;
+
+    // Glyph positions are floored after adding all of these up, that only
+    // moves by whole pixels with the text if they're all whole (halves added
+    // up stay exact)
+    if(!(engine_math_compare_floats(rotation_radians, 0.0f) && engine_draw_is_whole(center_x) && engine_draw_is_whole(center_y) &&
+         engine_draw_is_whole(text_box_width) && engine_draw_is_whole(text_box_height) &&
+         engine_draw_is_whole(letter_spacing) && engine_draw_is_whole(line_spacing))){
+        engine_draw_shift_exact = false;
+    }
 
     // Since sprites are centered by default and the text box height includes the
     // height of the first line, get rid of one line's worth of height to center
@@ -679,60 +1337,247 @@ float edge_function(float x0, float y0, float x1, float y1, float x2, float y2){
 }
 
 
-// https://fgiesen.wordpress.com/2013/02/08/triangle-rasterization-in-practice/#:~:text=trivial%20to%20traverse.-,This%20gives%3A,-void%20drawTri(const
-// https://fgiesen.wordpress.com/2013/02/10/optimizing-the-basic-rasterizer/#:~:text=In%20our%20basic%20triangle%20rasterization%20loop
+// Floor division for a positive 'denominator' (C division truncates towards zero)
+static inline int64_t engine_draw_floor_div(int64_t numerator, int64_t denominator){
+    int64_t quotient = numerator / denominator;
+    if(numerator % denominator != 0 && numerator < 0) quotient--;
+    return quotient;
+}
+
+
+// First row (or column) whose pixel center is at or after 'position' in
+// 24.8 fixed point, 'ceil(position - 0.5)'
+#define ENGINE_DRAW_POLYGON_FIRST_PIXEL(position) (((position) + 127) >> 8)
+
+
+// Scanline rasterizer: walks each edge down the rows whose pixel centers
+// it spans with an exact integer step (whole part plus remainder, like
+// Bresenham) and keeps the left-most and right-most crossing of each row.
+// A pixel is filled if its center is inside '[left, right)' and inside
+// '[top, bottom)' of the polygon so that polygons sharing an edge don't
+// overlap (top-left rule). Every row is stepped to the same position no
+// matter where the clip starts so tiles rasterize it exactly the same
+void engine_draw_filled_polygon(uint16_t color, const float *xs, const float *ys, uint8_t vertex_count, float alpha, engine_shader_t *shader){
+    if(vertex_count < 3 || vertex_count > ENGINE_DRAW_POLYGON_MAX_VERTICES){
+        return;
+    }
+
+    for(uint8_t ivx=0; ivx<vertex_count; ivx++){
+        if(!(engine_draw_is_whole(xs[ivx]) && engine_draw_is_whole(ys[ivx]))){
+            engine_draw_shift_exact = false;
+            break;
+        }
+    }
+
+    // Any number of vertices doesn't fit in a recorded command, draw
+    // it after whatever was recorded before it
+    if(engine_draw_deferred_is_recording()){
+        engine_draw_deferred_flush();
+    }
+
+    const engine_draw_clip_t *clip = engine_draw_clip;
+
+    // Vertices in 24.8 fixed point
+    int32_t vertex_x[ENGINE_DRAW_POLYGON_MAX_VERTICES];
+    int32_t vertex_y[ENGINE_DRAW_POLYGON_MAX_VERTICES];
+    int32_t top = INT32_MAX;
+    int32_t bottom = INT32_MIN;
+
+    for(uint8_t ivx=0; ivx<vertex_count; ivx++){
+        // Also catches NaN
+        if(!(fabsf(xs[ivx]) < ENGINE_DRAW_POLYGON_MAX_COORDINATE && fabsf(ys[ivx]) < ENGINE_DRAW_POLYGON_MAX_COORDINATE)){
+            return;
+        }
+
+        vertex_x[ivx] = (int32_t)floorf(xs[ivx] * 256.0f + 0.5f);
+        vertex_y[ivx] = (int32_t)floorf(ys[ivx] * 256.0f + 0.5f);
+
+        if(vertex_y[ivx] < top) top = vertex_y[ivx];
+        if(vertex_y[ivx] > bottom) bottom = vertex_y[ivx];
+    }
+
+    int32_t row_start = ENGINE_DRAW_POLYGON_FIRST_PIXEL(top);
+    int32_t row_end = ENGINE_DRAW_POLYGON_FIRST_PIXEL(bottom);
+    if(row_start < clip->y0) row_start = clip->y0;
+    if(row_end > clip->y1) row_end = clip->y1;
+
+    if(row_start >= row_end){
+        return;
+    }
+
+    // Columns '[span_start, span_end)' of each row from 'row_start',
+    // empty until an edge crosses the row. Targets are never taller
+    // than the screen
+    int16_t span_start[SCREEN_HEIGHT];
+    int16_t span_end[SCREEN_HEIGHT];
+
+    for(int32_t row=row_start; row<row_end; row++){
+        span_start[row - row_start] = clip->x1;
+        span_end[row - row_start] = clip->x0;
+    }
+
+    for(uint8_t ivx=0; ivx<vertex_count; ivx++){
+        uint8_t next_ivx = (ivx+1 < vertex_count) ? ivx+1 : 0;
+
+        // Walk every edge from top to bottom so shared edges match
+        int32_t top_x = vertex_x[ivx];
+        int32_t top_y = vertex_y[ivx];
+        int32_t bottom_x = vertex_x[next_ivx];
+        int32_t bottom_y = vertex_y[next_ivx];
+
+        if(top_y > bottom_y){
+            top_x = vertex_x[next_ivx];
+            top_y = vertex_y[next_ivx];
+            bottom_x = vertex_x[ivx];
+            bottom_y = vertex_y[ivx];
+        }
+
+        int32_t edge_row_start = ENGINE_DRAW_POLYGON_FIRST_PIXEL(top_y);
+        int32_t edge_row_end = ENGINE_DRAW_POLYGON_FIRST_PIXEL(bottom_y);
+        if(edge_row_start < row_start) edge_row_start = row_start;
+        if(edge_row_end > row_end) edge_row_end = row_end;
+
+        // Horizontal, between pixel centers or clipped
+        if(edge_row_start >= edge_row_end){
+            continue;
+        }
+
+        int64_t dx = bottom_x - top_x;
+        int64_t dy = bottom_y - top_y;
+
+        // Edge x at the center of the first row as '(x + error/dy)'
+        int64_t numerator = ((int64_t)edge_row_start*256 + 128 - top_y) * dx;
+        int64_t x = engine_draw_floor_div(numerator, dy);
+        int64_t error = numerator - x*dy;
+        x += top_x;
+
+        // Moving down one row moves the edge by '(step_x + step_error/dy)'
+        int64_t step_x = engine_draw_floor_div(256*dx, dy);
+        int64_t step_error = 256*dx - step_x*dy;
+
+        for(int32_t row=edge_row_start; row<edge_row_end; row++){
+            int64_t column = ENGINE_DRAW_POLYGON_FIRST_PIXEL(x);
+            if(column < clip->x0) column = clip->x0;
+            if(column > clip->x1) column = clip->x1;
+
+            uint32_t span_index = row - row_start;
+            if(column < span_start[span_index]) span_start[span_index] = (int16_t)column;
+            if(column > span_end[span_index]) span_end[span_index] = (int16_t)column;
+
+            x += step_x;
+            error += step_error;
+
+            if(error >= dy){
+                x++;
+                error -= dy;
+            }
+        }
+    }
+
+    uint16_t *target = engine_draw_target_buffer();
+
+    for(int32_t row=row_start; row<row_end; row++){
+        int32_t start = span_start[row - row_start];
+        int32_t end = span_end[row - row_start];
+
+        if(start < end){
+            shader->execute_fill(target + row*engine_draw_target_width + start, color, end - start, alpha, shader);
+        }
+    }
+}
+
+
 void engine_draw_filled_triangle(uint16_t color, float x0, float y0, float x1, float y1, float x2, float y2, float alpha, engine_shader_t *shader){
-    // // Triangle setup
-    // int16_t A01 = (int16_t)(y0 - y1), B01 = (int16_t)(x1 - x0);
-    // int16_t A12 = (int16_t)(y1 - y2), B12 = (int16_t)(x2 - x1);
-    // int16_t A20 = (int16_t)(y2 - y0), B20 = (int16_t)(x0 - x2);
-
-    // // Compute triangle bounding box
-    // int16_t minX = (int16_t)min3(x0, x1, x2);
-    // int16_t minY = (int16_t)min3(y0, y1, y2);
-    // int16_t maxX = (int16_t)max3(x0, x1, x2);
-    // int16_t maxY = (int16_t)max3(y0, y1, y2);
-
-    // // Clip against screen bounds
-    // minX = max(minX, 0);
-    // minY = max(minY, 0);
-    // maxX = min(maxX, SCREEN_WIDTH_MINUS_1);
-    // maxY = min(maxY, SCREEN_HEIGHT_MINUS_1);
-
-    // int16_t px = minX;
-    // int16_t py = minY;
-
-    // int16_t w0_row = (int16_t)orient2d(x1, y1, x2, y2, px, py);
-    // int16_t w1_row = (int16_t)orient2d(x2, y2, x0, y0, px, py);
-    // int16_t w2_row = (int16_t)orient2d(x0, y0, x1, y1, px, py);
-
-    // // Rasterize
-    // for(py = minY; py <= maxY; py++){
-    //     // Barycentric coordinates at start of row
-    //     int16_t w0 = w0_row;
-    //     int16_t w1 = w1_row;
-    //     int16_t w2 = w2_row;
-
-    //     for(px = minX; px <= maxX; px++){
-    //         // If p is on or inside all edges, render pixel.
-    //         // https://fgiesen.wordpress.com/2013/02/10/optimizing-the-basic-rasterizer/#:~:text=if%20((w0%20%7C%20w1%20%7C%20w2)%20%3E%3D%200)
-    //         if ((w0 | w1 | w2) >= 0){
-    //             // if(engine_display_store_check_depth(px, py, depth)){
-    //                 engine_draw_pixel_no_check(color, px, py, alpha, shader);
-    //             // }
-    //         }
-
-    //         // One step to the right
-    //         w0 += A12;
-    //         w1 += A20;
-    //         w2 += A01;
-    //     }
-
-    //     // One row step
-    //     w0_row += B12;
-    //     w1_row += B20;
-    //     w2_row += B01;
-    // }
+    if(engine_draw_deferred_is_recording()){
+        engine_draw_deferred_record_filled_triangle(color, x0, y0, x1, y1, x2, y2, alpha, shader);
+        return;
+    }
+
+    const float xs[3] = {x0, x1, x2};
+    const float ys[3] = {y0, y1, y2};
+    engine_draw_filled_polygon(color, xs, ys, 3, alpha, shader);
+}
+
+
+// Columns texture coordinates are interpolated linearly over between
+// two perspective correct ones in 'engine_draw_filled_triangle_depth()'.
+// Same as the depth tiles so that each run is in one tile
+#define ENGINE_DRAW_DEPTH_RUN_LENGTH ENGINE_DISPLAY_DEPTH_TILE_SIZE
+
+
+// Value of an attribute interpolated over a triangle at pixel '(x, y)'
+// is 'c + dx*(x - ax) + dy*(y - ay)', 'c' being its value at the first
+// vertex (small offsets keep more float precision than the origin)
+typedef struct{
+    float c;
+    float dx;
+    float dy;
+}engine_draw_plane_t;
+
+
+// Plane of the attribute that is 'a', 'b' and 'c' at the vertices, from
+// the planes of the barycentric coordinates of each vertex
+static inline engine_draw_plane_t engine_draw_plane_make(const engine_draw_plane_t *barycentric, float a, float b, float c){
+    engine_draw_plane_t plane;
+    plane.c  = a*barycentric[0].c  + b*barycentric[1].c  + c*barycentric[2].c;
+    plane.dx = a*barycentric[0].dx + b*barycentric[1].dx + c*barycentric[2].dx;
+    plane.dy = a*barycentric[0].dy + b*barycentric[1].dy + c*barycentric[2].dy;
+    return plane;
+}
+
+
+// Converts to 16.16 fixed point, clamped so that the
+// conversion is defined for values far outside a texture
+static inline int32_t engine_draw_to_fixed_16_16(float value){
+    value = fminf(fmaxf(value, -32767.0f), 32767.0f);
+    return (int32_t)(value * 65536.0f);
+}
+
+
+// True if the edge functions picked by 'mask' (bit
+// 'i' for edge 'i') are all at least 'inside'
+static inline bool engine_draw_edges_inside(const int64_t *edges, uint8_t mask, int64_t inside){
+    return (!(mask & 1) || edges[0] >= inside) &&
+           (!(mask & 2) || edges[1] >= inside) &&
+           (!(mask & 4) || edges[2] >= inside);
+}
+
+
+static inline void engine_draw_edges_add(int64_t *edges, const int64_t *steps){
+    edges[0] += steps[0];
+    edges[1] += steps[1];
+    edges[2] += steps[2];
+}
+
+
+static inline void engine_draw_edges_subtract(int64_t *edges, const int64_t *steps){
+    edges[0] -= steps[0];
+    edges[1] -= steps[1];
+    edges[2] -= steps[2];
+}
+
+
+// Returns a bit for each depth tile from 'first_tile_x' to 'last_tile_x' on
+// tile row 'tile_y' where everything stored is closer than the closest the
+// 'depth' plane gets over the tile, none of the triangle is visible there
+static uint32_t engine_draw_depth_hidden_tiles(const engine_draw_plane_t *depth, float ax, float ay, int32_t tile_y, int32_t first_tile_x, int32_t last_tile_x){
+    // The closest depth over a tile is at one of its corners. Pixels
+    // step depth in fixed point, leave a little room for that
+    const float tile_last = (float)(ENGINE_DISPLAY_DEPTH_TILE_SIZE - 1);
+    const float corner_offset = fminf(depth->dx * tile_last, 0.0f) + fminf(depth->dy * tile_last, 0.0f) - 2.0f;
+    const float tile_row_depth = depth->c + depth->dy * ((float)(tile_y * ENGINE_DISPLAY_DEPTH_TILE_SIZE) - ay) + corner_offset;
+
+    uint32_t hidden_tiles = 0;
+
+    for(int32_t tile_x=first_tile_x; tile_x<=last_tile_x; tile_x++){
+        float closest = tile_row_depth + depth->dx * ((float)(tile_x * ENGINE_DISPLAY_DEPTH_TILE_SIZE) - ax);
+
+        if(closest >= (float)engine_display_get_depth_tile_max(tile_x, tile_y)){
+            hidden_tiles |= 1u << tile_x;
+        }
+    }
+
+    return hidden_tiles;
 }
 
 
@@ -742,14 +1587,44 @@ void engine_draw_filled_triangle_depth(texture_resource_class_obj_t *texture, ui
                                        float cx, float cy, uint16_t depth_cz, float cu, float cv,
                                        float w0, float w1, float w2,
                                        float alpha, engine_shader_t *shader){
+    engine_draw_shift_exact = false;
+
+    if(engine_draw_deferred_is_recording()){
+        engine_draw_deferred_record_filled_triangle_depth(texture, color,
+                                                          ax, ay, depth_az, au, av,
+                                                          bx, by, depth_bz, bu, bv,
+                                                          cx, cy, depth_cz, cu, cv,
+                                                          w0, w1, w2,
+                                                          alpha, shader);
+        return;
+    }
+
+    // Also catches NaN
+    if(!(fabsf(ax) < ENGINE_DRAW_POLYGON_MAX_COORDINATE && fabsf(ay) < ENGINE_DRAW_POLYGON_MAX_COORDINATE &&
+         fabsf(bx) < ENGINE_DRAW_POLYGON_MAX_COORDINATE && fabsf(by) < ENGINE_DRAW_POLYGON_MAX_COORDINATE &&
+         fabsf(cx) < ENGINE_DRAW_POLYGON_MAX_COORDINATE && fabsf(cy) < ENGINE_DRAW_POLYGON_MAX_COORDINATE)){
+        return;
+    }
+
     // A = x0, y0
     // B = x1, y1
     // C = x2, y2
     const float ABC = edge_function(ax, ay, bx, by, cx, cy);
 
+    // Vertices in 24.8 fixed point, the edge functions
+    // of these are exact (in 16.16 fixed point)
+    const int64_t fixed_ax = (int64_t)floorf(ax * 256.0f + 0.5f);
+    const int64_t fixed_ay = (int64_t)floorf(ay * 256.0f + 0.5f);
+    const int64_t fixed_bx = (int64_t)floorf(bx * 256.0f + 0.5f);
+    const int64_t fixed_by = (int64_t)floorf(by * 256.0f + 0.5f);
+    const int64_t fixed_cx = (int64_t)floorf(cx * 256.0f + 0.5f);
+    const int64_t fixed_cy = (int64_t)floorf(cy * 256.0f + 0.5f);
+
+    const int64_t fixed_ABC = (fixed_bx - fixed_ax) * (fixed_cy - fixed_ay) - (fixed_by - fixed_ay) * (fixed_cx - fixed_ax);
+
     // Do not render triangles with 2x negative area - back face culling
     // https://jtsorlinis.github.io/rendering-tutorial/#:~:text=RESET-,A%20nifty%20trick,-Another%20really%20useful
-    if(ABC <= 0.0f){
+    if(ABC <= 0.0f || fixed_ABC <= 0){
         // Do not draw this triangle
         return;
     }
@@ -769,103 +1644,274 @@ void engine_draw_filled_triangle_depth(texture_resource_class_obj_t *texture, ui
     max_x = min(max_x, SCREEN_WIDTH_MINUS_1);
     max_y = min(max_y, SCREEN_HEIGHT_MINUS_1);
 
-    // Start at the minimum x and y corner of the triangle view box
-    int16_t px = (int16_t)min_x;
-    int16_t py = (int16_t)min_y;
+    // Edge functions are exact and everything else is computed from the
+    // pixel position (never added up from the corner of the clip) so that
+    // rasterizing a tile gives every pixel the same values as when drawing
+    // in one go
+    const engine_draw_clip_t *clip = engine_draw_clip;
+    int32_t clip_min_x = max(min_x, clip->x0);
+    int32_t clip_min_y = max(min_y, clip->y0);
+    int32_t clip_max_x = min(max_x, clip->x1-1);
+    int32_t clip_max_y = min(max_y, clip->y1-1);
+
+    if(clip_min_x > clip_max_x || clip_min_y > clip_max_y){
+        return;
+    }
 
     // https://jtsorlinis.github.io/rendering-tutorial/#:~:text=this%20triangle%0A%7D-,Back%20to%20business,-So%2C%20why%20is
     // https://fgiesen.wordpress.com/2013/02/10/optimizing-the-basic-rasterizer/#:~:text=In%20our%20basic%20triangle%20rasterization%20loop
-    // Calculate our edge functions. If (px, py) is on the
-    // right side of all of the edges, each of these will
-    // be a positive number
-    float BCP_ROW = edge_function(bx, by, cx, cy, px, py) / ABC;
-    float CAP_ROW = edge_function(cx, cy, ax, ay, px, py) / ABC;
-    float ABP_ROW = edge_function(ax, ay, bx, by, px, py) / ABC;
+    // Calculate our edge functions (BCP, CAP and ABP) at the first pixel of
+    // the clipped box. If a pixel is on the right side of all of the edges,
+    // each of these will be a positive number
+    const int64_t start_x = (int64_t)clip_min_x * 256;
+    const int64_t start_y = (int64_t)clip_min_y * 256;
+
+    const int64_t edges_start[3] = {
+        (fixed_cx - fixed_bx) * (start_y - fixed_by) - (fixed_cy - fixed_by) * (start_x - fixed_bx),
+        (fixed_ax - fixed_cx) * (start_y - fixed_cy) - (fixed_ay - fixed_cy) * (start_x - fixed_cx),
+        (fixed_bx - fixed_ax) * (start_y - fixed_ay) - (fixed_by - fixed_ay) * (start_x - fixed_ax)
+    };
 
     // https://fgiesen.wordpress.com/2013/02/10/optimizing-the-basic-rasterizer/#:~:text=In%20our%20basic%20triangle%20rasterization%20loop
-    float dy_bc = (float)(by - cy) / ABC;
-    float dx_bc = (float)(cx - bx) / ABC;
-    
-    float dy_ca = (float)(cy - ay) / ABC;
-    float dx_ca = (float)(ax - cx) / ABC;
+    // Change of the edge functions for one column and one row
+    const int64_t edges_column_step[3] = {(fixed_by - fixed_cy) * 256, (fixed_cy - fixed_ay) * 256, (fixed_ay - fixed_by) * 256};
+    const int64_t edges_row_step[3] = {(fixed_cx - fixed_bx) * 256, (fixed_ax - fixed_cx) * 256, (fixed_bx - fixed_ax) * 256};
+
+    // Edges that get larger going right only limit the start of a
+    // span, edges that get smaller only its end and level edges
+    // either let the whole row in or nothing
+    uint8_t start_edges = 0;
+    uint8_t end_edges = 0;
+    uint8_t level_edges = 0;
+
+    for(uint8_t iex=0; iex<3; iex++){
+        if(edges_column_step[iex] > 0){
+            start_edges |= 1 << iex;
+        }else if(edges_column_step[iex] < 0){
+            end_edges |= 1 << iex;
+        }else{
+            level_edges |= 1 << iex;
+        }
+    }
 
-    float dy_ab = (float)(ay - by) / ABC;
-    float dx_ab = (float)(bx - ax) / ABC;
+    // Instead of comparing directly to 0, make sure triangles get filled
+    // by comparing to a small negative number (0.001 of the area)
+    const int64_t inside = -(fixed_ABC / 1000);
+
+    // https://jtsorlinis.github.io/rendering-tutorial/#:~:text=get%20the%20interpolated%20colour
+    // Barycentric coordinates as planes over the screen, BCP + CAP + ABP = 1.0
+    const float inverse_ABC = 1.0f / ABC;
+    const engine_draw_plane_t barycentric[3] = {
+        {1.0f, (by - cy) * inverse_ABC, (cx - bx) * inverse_ABC},
+        {0.0f, (cy - ay) * inverse_ABC, (ax - cx) * inverse_ABC},
+        {0.0f, (ay - by) * inverse_ABC, (bx - ax) * inverse_ABC}
+    };
+
+    // https://stackoverflow.com/questions/12360023/barycentric-coordinates-texture-mapping
+    // https://computergraphics.stackexchange.com/a/4091
+    // https://web.archive.org/web/20240416044207/https://www.scratchapixel.com/lessons/3d-basic-rendering/rasterization-practical-implementation/perspective-correct-interpolation-vertex-attributes.html
+    // Depth, 1/w, u/w and v/w are linear in screen space
+    const float inverse_w0 = 1.0f / w0;
+    const float inverse_w1 = 1.0f / w1;
+    const float inverse_w2 = 1.0f / w2;
+
+    const engine_draw_plane_t depth = engine_draw_plane_make(barycentric, (float)depth_az, (float)depth_bz, (float)depth_cz);
+    const engine_draw_plane_t q = engine_draw_plane_make(barycentric, inverse_w0, inverse_w1, inverse_w2);
+    const engine_draw_plane_t uq = engine_draw_plane_make(barycentric, au*inverse_w0, bu*inverse_w1, cu*inverse_w2);
+    const engine_draw_plane_t vq = engine_draw_plane_make(barycentric, av*inverse_w0, bv*inverse_w1, cv*inverse_w2);
+
+    // Depth per column in 24.8 fixed point (clamped, slivers
+    // can change depth by a lot more than fits in one column)
+    const int32_t depth_step = (int32_t)(fminf(fmaxf(depth.dx, -65536.0f), 65536.0f) * 256.0f);
+
+    // First and last columns inside the triangle on the row and the edge
+    // functions at them. Both are moved from where they were on the row
+    // before, edges only move a few columns from one row to the next
+    int32_t span_start = clip_min_x;
+    int32_t span_last = clip_max_x;
+    int64_t edges_at_start[3];
+    int64_t edges_at_last[3];
+
+    for(uint8_t iex=0; iex<3; iex++){
+        edges_at_start[iex] = edges_start[iex];
+        edges_at_last[iex] = edges_start[iex] + edges_column_step[iex] * (clip_max_x - clip_min_x);
+    }
 
+    // Depth tiles are found from buffer indices as if drawing to
+    // the screen, they only line up with targets as wide as it
+    const bool check_hidden = engine_draw_target_width == SCREEN_WIDTH;
+    const int32_t first_tile_x = clip_min_x >> ENGINE_DISPLAY_DEPTH_TILE_SHIFT;
+    const int32_t last_tile_x = clip_max_x >> ENGINE_DISPLAY_DEPTH_TILE_SHIFT;
+    const uint32_t row_tiles = ((2u << last_tile_x) - 1) & ~((1u << first_tile_x) - 1);
+    uint32_t hidden_tiles = 0;
+
+    // Go through all rows in the triangle view box and find the span
+    // of pixels inside the triangle on each
+    for(int32_t py=clip_min_y; py<=clip_max_y; py++){
+        if(py != clip_min_y){
+            engine_draw_edges_add(edges_at_start, edges_row_step);
+            engine_draw_edges_add(edges_at_last, edges_row_step);
+        }
 
-    // Go through all pixels in triangle view box and check if each
-    // point is inside or outside the triangle inside the box
-    for(py=min_y; py<=max_y; py++){
-        // Barycentric coordinates at start of row
-        float BCP = BCP_ROW;
-        float CAP = CAP_ROW;
-        float ABP = ABP_ROW;
+        // Tiles of the depth buffer that hide the triangle, found
+        // again on the first row of each row of tiles
+        if(check_hidden && (py == clip_min_y || (py & (ENGINE_DISPLAY_DEPTH_TILE_SIZE-1)) == 0)){
+            hidden_tiles = engine_draw_depth_hidden_tiles(&depth, ax, ay, py >> ENGINE_DISPLAY_DEPTH_TILE_SHIFT, first_tile_x, last_tile_x);
+        }
 
-        for(px=min_x; px<=max_x; px++){
+        // Early out for rows behind what was drawn before (the span is
+        // found from wherever it was last on the next row that isn't)
+        if(hidden_tiles == row_tiles){
+            continue;
+        }
 
-            // https://jtsorlinis.github.io/rendering-tutorial/#:~:text=get%20the%20interpolated%20colour
-            // BCP + CAP + ABP = 1.0
-            uint16_t depth_p = (uint16_t)((float)depth_az*BCP + (float)depth_bz*CAP + (float)depth_cz*ABP);
+        // Move the start left while the column before it is inside
+        // the edges limiting the start or right until it is
+        if(engine_draw_edges_inside(edges_at_start, start_edges, inside)){
+            while(span_start > clip_min_x){
+                engine_draw_edges_subtract(edges_at_start, edges_column_step);
 
-            // Check that the pixel is on the right side of each
-            // edge for all the edge functions calculated. Instead of
-            // comparing directly to 0.0, make sure triangles get filled
-            // by comparing to numbers above some small negative number
-            if((ABP >= -0.001f && BCP >= -0.001f && CAP >= -0.001f) && engine_display_store_check_depth(px, py, depth_p)){
+                if(!engine_draw_edges_inside(edges_at_start, start_edges, inside)){
+                    engine_draw_edges_add(edges_at_start, edges_column_step);
+                    break;
+                }
 
-                // https://stackoverflow.com/questions/12360023/barycentric-coordinates-texture-mapping
-                // https://computergraphics.stackexchange.com/a/4091
-                // https://www.reddit.com/r/opengl/comments/49fdhc/comment/d0rlh12/
-                // https://web.archive.org/web/20240416044207/https://www.scratchapixel.com/lessons/3d-basic-rendering/rasterization-practical-implementation/perspective-correct-interpolation-vertex-attributes.html
-                float w = BCP/w0 + CAP/w1 + ABP/w2;
+                span_start--;
+            }
+        }else{
+            while(span_start <= clip_max_x && !engine_draw_edges_inside(edges_at_start, start_edges, inside)){
+                engine_draw_edges_add(edges_at_start, edges_column_step);
+                span_start++;
+            }
+        }
 
-                uint16_t u = (uint16_t)((BCP*au/w0 + CAP*bu/w1 + ABP*cu/w2) / w);
-                uint16_t v = (uint16_t)((BCP*av/w0 + CAP*bv/w1 + ABP*cv/w2) / w);
+        // Same for the last column and the edges limiting the end
+        if(engine_draw_edges_inside(edges_at_last, end_edges, inside)){
+            while(span_last < clip_max_x){
+                engine_draw_edges_add(edges_at_last, edges_column_step);
 
-                // // https://computergraphics.stackexchange.com/questions/4079/perspective-correct-texture-mapping
-                // float tau = au / w0;
-                // float tav = av / w0;
-                // float tinvw0 = 1.0f / w0;
+                if(!engine_draw_edges_inside(edges_at_last, end_edges, inside)){
+                    engine_draw_edges_subtract(edges_at_last, edges_column_step);
+                    break;
+                }
 
-                // float tbu = bu / w1;
-                // float tbv = bv / w1;
-                // float tinvw1 = 1.0f / w1;
+                span_last++;
+            }
+        }else{
+            while(span_last >= clip_min_x && !engine_draw_edges_inside(edges_at_last, end_edges, inside)){
+                engine_draw_edges_subtract(edges_at_last, edges_column_step);
+                span_last--;
+            }
+        }
 
-                // float tcu = cu / w2;
-                // float tcv = cv / w2;
-                // float tinvw2 = 1.0f / w2;
+        // Early out for rows outside the triangle: the span is empty or
+        // the row is outside a level edge (which is the same on any column)
+        if(span_start > span_last || !engine_draw_edges_inside(edges_at_start, level_edges, inside)){
+            continue;
+        }
 
-                // // float invw = 1.0f / w;
+        const int32_t span_end = span_last + 1;
+
+        const float row_depth = depth.c + depth.dy * ((float)py - ay);
+        const float row_q = q.c + q.dy * ((float)py - ay);
+        const float row_uq = uq.c + uq.dy * ((float)py - ay);
+        const float row_vq = vq.c + vq.dy * ((float)py - ay);
+
+        // Perspective correct texture coordinates are only computed with
+        // a reciprocal of 1/w at every ENGINE_DRAW_DEPTH_RUN_LENGTH columns
+        // of the screen and interpolated linearly between them. Runs are
+        // aligned to the screen and not the span so that tiles match
+        int32_t run_x = span_start & ~(ENGINE_DRAW_DEPTH_RUN_LENGTH-1);
+
+        // Texture coordinates at the start of the run, carried
+        // over from the end of the run before when it was drawn
+        bool run_known = false;
+        float run_q = 0.0f;
+        float run_u = 0.0f;
+        float run_v = 0.0f;
+
+        int32_t px = span_start;
+
+        while(px < span_end){
+            const int32_t next_run_x = run_x + ENGINE_DRAW_DEPTH_RUN_LENGTH;
+            const int32_t run_end = min(span_end, next_run_x);
+
+            // Every pixel of the run would fail the depth test
+            if(hidden_tiles & (1u << (run_x >> ENGINE_DISPLAY_DEPTH_TILE_SHIFT))){
+                px = run_end;
+                run_x = next_run_x;
+                run_known = false;
+                continue;
+            }
 
+            if(!run_known){
+                run_q = row_q + q.dx * ((float)run_x - ax);
+                const float inverse_run_q = 1.0f / run_q;
+                run_u = (row_uq + uq.dx * ((float)run_x - ax)) * inverse_run_q;
+                run_v = (row_vq + vq.dx * ((float)run_x - ax)) * inverse_run_q;
+            }
 
-                // uint16_t invw = (uint16_t)((tinvw0*BCP + tinvw1*CAP + tinvw2*ABP));
-                // uint16_t u = (uint16_t)((tau*BCP + tbu*CAP + tcu*ABP)/(1.0f/invw));
-                // uint16_t v = (uint16_t)((tav*BCP + tbv*CAP + tcv*ABP)/(1.0f/invw));
+            const float next_run_q = row_q + q.dx * ((float)next_run_x - ax);
+            const float inverse_next_run_q = 1.0f / next_run_q;
+            const float next_run_u = (row_uq + uq.dx * ((float)next_run_x - ax)) * inverse_next_run_q;
+            const float next_run_v = (row_vq + vq.dx * ((float)next_run_x - ax)) * inverse_next_run_q;
+
+            // Interpolating linearly is off by about 'change*|dq|/(2*(q0 + q1))'
+            // in the middle of the run, divide for each pixel when that could
+            // be more than a quarter of a texel (steep triangles up close) or
+            // when 1/w reaches zero past the edge of the triangle
+            const float uv_change = fmaxf(fabsf(next_run_u - run_u), fabsf(next_run_v - run_v));
+            const bool divide_each = !(run_q > 0.0f && next_run_q > 0.0f && uv_change * fabsf(next_run_q - run_q) <= 0.5f * (run_q + next_run_q));
+
+            const int32_t u_run = engine_draw_to_fixed_16_16(run_u);
+            const int32_t v_run = engine_draw_to_fixed_16_16(run_v);
+            const int32_t u_step = ((int64_t)engine_draw_to_fixed_16_16(next_run_u) - u_run) / ENGINE_DRAW_DEPTH_RUN_LENGTH;
+            const int32_t v_step = ((int64_t)engine_draw_to_fixed_16_16(next_run_v) - v_run) / ENGINE_DRAW_DEPTH_RUN_LENGTH;
+
+            const float depth_run_start = row_depth + depth.dx * ((float)run_x - ax);
+            const int32_t depth_run = (int32_t)(fminf(fmaxf(depth_run_start, -65536.0f), 131072.0f) * 256.0f);
+
+            for(; px<run_end; px++){
+                const int32_t offset = px - run_x;
+
+                int32_t depth_p = (depth_run + depth_step*offset) >> 8;
+                depth_p = max(0, min(depth_p, UINT16_MAX));
+
+                if(engine_display_store_check_depth_index(py*engine_draw_target_width + px, (uint16_t)depth_p)){
+                    int32_t u;
+                    int32_t v;
+
+                    if(divide_each){
+                        const float pixel_q = row_q + q.dx * ((float)px - ax);
+                        u = engine_draw_to_fixed_16_16((row_uq + uq.dx * ((float)px - ax)) / pixel_q) >> 16;
+                        v = engine_draw_to_fixed_16_16((row_vq + vq.dx * ((float)px - ax)) / pixel_q) >> 16;
+                    }else{
+                        u = (u_run + u_step*offset) >> 16;
+                        v = (v_run + v_step*offset) >> 16;
+                    }
 
-                // uint16_t u = (uint16_t)((au*BCP + bu*CAP + cu*ABP));
-                // uint16_t v = (uint16_t)((av*BCP + bv*CAP + cv*ABP));
+                    u = max(0, min(u, texture->width-1));
+                    v = max(0, min(v, texture->height-1));
 
-                // Get the pixel from the texture
-                uint32_t index = v * texture->width + u;
-                float texture_pixel_alpha = 0.0f;
+                    // Get the pixel from the texture
+                    uint32_t index = v * texture->width + u;
+                    float texture_pixel_alpha = 0.0f;
 
-                uint16_t texture_pixel_color = texture->get_pixel(texture, index, &texture_pixel_alpha);
+                    uint16_t texture_pixel_color = texture->get_pixel(texture, index, &texture_pixel_alpha);
 
-                // Mix
-                alpha = alpha * texture_pixel_alpha;
+                    // Mix (only for this pixel, the pixels drawn before
+                    // must not change the opacity of the next ones)
+                    float pixel_alpha = alpha * texture_pixel_alpha;
 
-                engine_draw_pixel_no_check(texture_pixel_color, px, py, alpha, shader);
+                    engine_draw_pixel_no_check(texture_pixel_color, px, py, pixel_alpha, shader);
+                }
             }
 
-            // One step to the right
-            BCP += dy_bc;
-            CAP += dy_ca;
-            ABP += dy_ab;
+            run_x = next_run_x;
+            run_known = true;
+            run_q = next_run_q;
+            run_u = next_run_u;
+            run_v = next_run_v;
         }
-
-        // One row step
-        BCP_ROW += dx_bc;
-        CAP_ROW += dx_ca;
-        ABP_ROW += dx_ab;
     }
-}
\ No newline at end of file
+}
@@ -3,6 +3,7 @@
 
 #include "py/obj.h"
 #include <stdint.h>
+#include <stdbool.h>
 #include "engine_color.h"
 #include "resources/engine_font_resource.h"
 #include "utility/engine_defines.h"
@@ -18,6 +19,58 @@ void ENGINE_FAST_FUNCTION(engine_draw_fill_color)(uint16_t color, uint16_t *scre
 // Fills entire screen buffer with 'src_buffer'
 void ENGINE_FAST_FUNCTION(engine_draw_fill_buffer)(uint16_t* src_buffer, uint16_t *screen_buffer);
 
+// Same as the above two but only for the 'width' by 'height' area of the
+// screen buffer with its top-left at 'x' and 'y' (must be on screen)
+void ENGINE_FAST_FUNCTION(engine_draw_fill_color_rect)(uint16_t color, uint16_t *screen_buffer, int32_t x, int32_t y, int32_t width, int32_t height);
+void ENGINE_FAST_FUNCTION(engine_draw_fill_buffer_rect)(uint16_t* src_buffer, uint16_t *screen_buffer, int32_t x, int32_t y, int32_t width, int32_t height);
+
+// Makes the rasterizers below draw into the 'width' by 'height' RGB565
+// 'buffer' instead of the screen buffer (NULL goes back to the screen
+// buffer). The buffer can't be larger than the screen in either direction.
+// Used to render nodes into a texture (see 'engine_draw_module.c')
+void engine_draw_set_target(uint16_t *buffer, int32_t width, int32_t height);
+bool engine_draw_is_offscreen();
+
+// Buffer the rasterizers are drawing into and its width
+uint16_t *engine_draw_get_target();
+int32_t engine_draw_get_target_width();
+
+// Area of the target that the rasterizers below write to. This is all
+// of it unless tiles are being rasterized (see 'engine_draw_deferred.h')
+typedef struct{
+    int32_t x0;     // Left-most column
+    int32_t y0;     // Top-most row
+    int32_t x1;     // One past the right-most column
+    int32_t y1;     // One past the bottom-most row
+    bool covered;   // Set when something opaque was drawn over all of it
+}engine_draw_clip_t;
+
+// Makes the rasterizers called from this thread only write inside 'clip'
+// (NULL for the whole target). Every pixel inside is drawn exactly the
+// same as without a clip
+void engine_draw_set_clip(engine_draw_clip_t *clip);
+const engine_draw_clip_t *engine_draw_get_clip();
+
+// Something opaque covering the whole screen buffer (a background
+// sprite or rectangle drawn by the axis aligned fast paths) sets this,
+// used to skip clearing the screen buffer when every frame is covered.
+// 'engine_draw_set_covered()' is for when the screen got covered piece
+// by piece (every tile had its clip covered)
+void engine_draw_reset_covered();
+void engine_draw_set_covered();
+bool engine_draw_is_covered();
+
+// Everything drawn since 'engine_draw_reset_shift_exact()' on this thread
+// comes out exactly the same, moved by whole pixels, when drawn again at
+// positions moved by those whole pixels. Lines, circles and pixels are,
+// and so are polygons at whole pixel vertices and unrotated sprites and
+// rectangles at whole pixel centers (and whole number sprite scales).
+// Anything else clears it, and so can nodes that draw depending on the
+// camera
+void engine_draw_reset_shift_exact();
+void engine_draw_set_not_shift_exact();
+bool engine_draw_is_shift_exact();
+
 // Sets a single pixel in the screen buffer to 'color'
 void ENGINE_FAST_FUNCTION(engine_draw_pixel)(uint16_t color, int32_t x, int32_t y, float alpha, engine_shader_t *shader);
 
@@ -37,7 +90,12 @@ void engine_draw_filled_circle(uint16_t color, float center_x, float center_y, f
 
 void engine_draw_text(font_resource_class_obj_t *font, mp_obj_t text, float center_x, float center_y, float text_box_width, float text_box_height, float letter_spacing, float line_spacing, float x_scale, float y_scale, float rotation_radians, float alpha, engine_shader_t *shader);
 
+// Flat filled triangle and convex polygon ('xs[i], ys[i]' is a vertex, in
+// either winding). Concave polygons are filled as if each row was convex
+#define ENGINE_DRAW_POLYGON_MAX_VERTICES 32
+#define ENGINE_DRAW_POLYGON_MAX_COORDINATE 4194304.0f   // Polygons with vertices further out than this are not drawn
 void engine_draw_filled_triangle(uint16_t color, float x0, float y0, float x1, float y1, float x2, float y2, float alpha, engine_shader_t *shader);
+void engine_draw_filled_polygon(uint16_t color, const float *xs, const float *ys, uint8_t vertex_count, float alpha, engine_shader_t *shader);
 
 void engine_draw_filled_triangle_depth(texture_resource_class_obj_t *texture, uint16_t color,
                                        float ax, float ay, uint16_t depth_az, float au, float av,
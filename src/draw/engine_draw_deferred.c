@@ -0,0 +1,538 @@
+#include "draw/engine_draw_deferred.h"
+#include "draw/engine_display_draw.h"
+#include "display/engine_display_common.h"
+#include "debug/debug_print.h"
+#include "math/engine_math.h"
+#include "py/misc.h"
+#include <math.h>
+
+#if defined(ENGINE_DRAW_DEFERRED_MAX_WORKERS)
+    #include <SDL2/SDL.h>
+#endif
+
+#define ENGINE_DRAW_DEFERRED_TILES_X ((SCREEN_WIDTH + ENGINE_DRAW_DEFERRED_TILE_SIZE - 1) / ENGINE_DRAW_DEFERRED_TILE_SIZE)
+#define ENGINE_DRAW_DEFERRED_TILES_Y ((SCREEN_HEIGHT + ENGINE_DRAW_DEFERRED_TILE_SIZE - 1) / ENGINE_DRAW_DEFERRED_TILE_SIZE)
+#define ENGINE_DRAW_DEFERRED_TILE_COUNT (ENGINE_DRAW_DEFERRED_TILES_X * ENGINE_DRAW_DEFERRED_TILES_Y)
+
+// Each command stores the tiles it touches as bits
+#if ENGINE_DRAW_DEFERRED_TILE_COUNT > 32
+    #error "Too many deferred drawing tiles, increase ENGINE_DRAW_DEFERRED_TILE_SIZE"
+#endif
+
+enum engine_draw_command_types{
+    ENGINE_DRAW_COMMAND_LINE,
+    ENGINE_DRAW_COMMAND_BLIT,
+    ENGINE_DRAW_COMMAND_BLIT_DEPTH,
+    ENGINE_DRAW_COMMAND_RECT,
+    ENGINE_DRAW_COMMAND_OUTLINE_CIRCLE,
+    ENGINE_DRAW_COMMAND_FILLED_CIRCLE,
+    ENGINE_DRAW_COMMAND_FILLED_TRIANGLE,
+    ENGINE_DRAW_COMMAND_FILLED_TRIANGLE_DEPTH,
+};
+
+// The arguments of one call to an 'engine_draw_*' function
+typedef struct{
+    uint8_t type;               // One of 'engine_draw_command_types'
+    uint32_t tiles;             // Bit per tile the command touches
+    float alpha;
+    engine_shader_t *shader;
+
+    union{
+        struct{
+            uint16_t color;
+            float x_start;
+            float y_start;
+            float x_end;
+            float y_end;
+        }line;
+
+        // Also 'ENGINE_DRAW_COMMAND_BLIT_DEPTH'
+        struct{
+            texture_resource_class_obj_t *texture;
+            uint32_t offset;
+            float center_x;
+            float center_y;
+            int32_t window_width;
+            int32_t window_height;
+            uint32_t pixels_stride;
+            float x_scale;
+            float y_scale;
+            float rotation_radians;
+            uint16_t transparent_color;
+            uint16_t depth;
+        }blit;
+
+        struct{
+            uint16_t color;
+            float center_x;
+            float center_y;
+            int32_t width;
+            int32_t height;
+            float x_scale;
+            float y_scale;
+            float rotation_radians;
+        }rect;
+
+        // Outline and filled
+        struct{
+            uint16_t color;
+            float center_x;
+            float center_y;
+            float radius;
+        }circle;
+
+        // Also 'ENGINE_DRAW_COMMAND_FILLED_TRIANGLE' (only color and positions)
+        struct{
+            texture_resource_class_obj_t *texture;
+            uint16_t color;
+            float x[3];
+            float y[3];
+            uint16_t depth[3];
+            float u[3];
+            float v[3];
+            float w[3];
+        }triangle;
+    };
+}engine_draw_command_t;
+
+static bool deferred_enabled = false;
+static bool deferred_recording = false;
+
+// Allocated while enabled
+static engine_draw_command_t *commands = NULL;
+static uint16_t command_count = 0;
+
+// Each tile's area of the screen and whether it was covered this draw pass
+static engine_draw_clip_t tile_clips[ENGINE_DRAW_DEFERRED_TILE_COUNT];
+
+
+// Whole pixels of the screen touched by '[start, end)'. Clamped so that
+// NaN and infinite coordinates end up covering all of the screen
+static void engine_draw_deferred_clamp_span(float start, float end, int32_t size, int32_t *out_start, int32_t *out_end){
+    *out_start = (int32_t)fminf(fmaxf(floorf(start), 0.0f), (float)size);
+    *out_end = (int32_t)fmaxf(fminf(ceilf(end), (float)size), 0.0f);
+}
+
+
+// Sets the tiles the box between the corners touches and keeps the
+// command if it touches any (drops it if off screen)
+static void engine_draw_deferred_bin(engine_draw_command_t *command, float x0, float y0, float x1, float y1){
+    int32_t px0, px1, py0, py1;
+    engine_draw_deferred_clamp_span(x0, x1, SCREEN_WIDTH, &px0, &px1);
+    engine_draw_deferred_clamp_span(y0, y1, SCREEN_HEIGHT, &py0, &py1);
+
+    if(px0 >= px1 || py0 >= py1){
+        return;
+    }
+
+    command->tiles = 0;
+
+    for(int32_t ty=py0/ENGINE_DRAW_DEFERRED_TILE_SIZE; ty<=(py1-1)/ENGINE_DRAW_DEFERRED_TILE_SIZE; ty++){
+        for(int32_t tx=px0/ENGINE_DRAW_DEFERRED_TILE_SIZE; tx<=(px1-1)/ENGINE_DRAW_DEFERRED_TILE_SIZE; tx++){
+            command->tiles |= (1u << (ty*ENGINE_DRAW_DEFERRED_TILES_X + tx));
+        }
+    }
+
+    command_count++;
+}
+
+
+// Same bounding square the blit and rect rasterizers limit themselves to,
+// plus a pixel all around in case of rounding
+static void engine_draw_deferred_bin_square(engine_draw_command_t *command, float center_x, float center_y, float scaled_width, float scaled_height){
+    int32_t dim = (int32_t)sqrtf((scaled_width*scaled_width) + (scaled_height*scaled_height));
+    float dim_half = (dim / 2.0f);
+
+    float top_left_x = floorf(center_x - dim_half);
+    float top_left_y = floorf(center_y - dim_half);
+
+    engine_draw_deferred_bin(command, top_left_x - 1.0f, top_left_y - 1.0f, top_left_x + dim + 1.0f, top_left_y + dim + 1.0f);
+}
+
+
+// Next free command, rasterizes what was recorded first if full
+static engine_draw_command_t *engine_draw_deferred_next(uint8_t type, float alpha, engine_shader_t *shader){
+    if(command_count == ENGINE_DRAW_DEFERRED_MAX_COMMANDS){
+        engine_draw_deferred_flush();
+    }
+
+    engine_draw_command_t *command = &commands[command_count];
+    command->type = type;
+    command->alpha = alpha;
+    command->shader = shader;
+    return command;
+}
+
+
+static void engine_draw_deferred_rasterize_tile(uint8_t tile){
+    uint32_t tile_bit = (1u << tile);
+
+    engine_draw_set_clip(&tile_clips[tile]);
+
+    for(uint16_t icx=0; icx<command_count; icx++){
+        engine_draw_command_t *command = &commands[icx];
+
+        if((command->tiles & tile_bit) == 0){
+            continue;
+        }
+
+        switch(command->type){
+            case ENGINE_DRAW_COMMAND_LINE:
+                engine_draw_line(command->line.color, command->line.x_start, command->line.y_start, command->line.x_end, command->line.y_end, NULL, command->alpha, command->shader);
+            break;
+            case ENGINE_DRAW_COMMAND_BLIT:
+                engine_draw_blit(command->blit.texture, command->blit.offset, command->blit.center_x, command->blit.center_y,
+                                 command->blit.window_width, command->blit.window_height, command->blit.pixels_stride,
+                                 command->blit.x_scale, command->blit.y_scale, command->blit.rotation_radians,
+                                 command->blit.transparent_color, command->alpha, command->shader);
+            break;
+            case ENGINE_DRAW_COMMAND_BLIT_DEPTH:
+                engine_draw_blit_depth(command->blit.texture, command->blit.offset, command->blit.center_x, command->blit.center_y,
+                                       command->blit.window_width, command->blit.window_height, command->blit.pixels_stride,
+                                       command->blit.x_scale, command->blit.y_scale, command->blit.rotation_radians,
+                                       command->blit.transparent_color, command->alpha, command->blit.depth, command->shader);
+            break;
+            case ENGINE_DRAW_COMMAND_RECT:
+                engine_draw_rect(command->rect.color, command->rect.center_x, command->rect.center_y, command->rect.width, command->rect.height,
+                                 command->rect.x_scale, command->rect.y_scale, command->rect.rotation_radians, command->alpha, command->shader);
+            break;
+            case ENGINE_DRAW_COMMAND_OUTLINE_CIRCLE:
+                engine_draw_outline_circle(command->circle.color, command->circle.center_x, command->circle.center_y, command->circle.radius, command->alpha, command->shader);
+            break;
+            case ENGINE_DRAW_COMMAND_FILLED_CIRCLE:
+                engine_draw_filled_circle(command->circle.color, command->circle.center_x, command->circle.center_y, command->circle.radius, command->alpha, command->shader);
+            break;
+            case ENGINE_DRAW_COMMAND_FILLED_TRIANGLE:
+                engine_draw_filled_triangle(command->triangle.color,
+                                            command->triangle.x[0], command->triangle.y[0],
+                                            command->triangle.x[1], command->triangle.y[1],
+                                            command->triangle.x[2], command->triangle.y[2],
+                                            command->alpha, command->shader);
+            break;
+            case ENGINE_DRAW_COMMAND_FILLED_TRIANGLE_DEPTH:
+                engine_draw_filled_triangle_depth(command->triangle.texture, command->triangle.color,
+                                                  command->triangle.x[0], command->triangle.y[0], command->triangle.depth[0], command->triangle.u[0], command->triangle.v[0],
+                                                  command->triangle.x[1], command->triangle.y[1], command->triangle.depth[1], command->triangle.u[1], command->triangle.v[1],
+                                                  command->triangle.x[2], command->triangle.y[2], command->triangle.depth[2], command->triangle.u[2], command->triangle.v[2],
+                                                  command->triangle.w[0], command->triangle.w[1], command->triangle.w[2],
+                                                  command->alpha, command->shader);
+            break;
+        }
+    }
+
+    engine_draw_set_clip(NULL);
+}
+
+
+#if defined(ENGINE_DRAW_DEFERRED_MAX_WORKERS)
+    // Tiles are handed out one at a time to the workers and the engine
+    // thread, a new batch of tiles starts each time 'worker_batch' changes
+    static SDL_mutex *worker_mutex = NULL;
+    static SDL_cond *worker_batch_started = NULL;
+    static SDL_cond *worker_batch_done = NULL;
+    static uint32_t worker_batch = 0;
+    static uint8_t worker_next_tile = ENGINE_DRAW_DEFERRED_TILE_COUNT;
+    static uint8_t worker_tiles_done = 0;
+
+
+    // Rasterizes tiles until there are none left to take, called
+    // and returns with 'worker_mutex' locked
+    static void engine_draw_deferred_take_tiles(){
+        while(worker_next_tile < ENGINE_DRAW_DEFERRED_TILE_COUNT){
+            uint8_t tile = worker_next_tile++;
+
+            SDL_UnlockMutex(worker_mutex);
+            engine_draw_deferred_rasterize_tile(tile);
+            SDL_LockMutex(worker_mutex);
+
+            worker_tiles_done++;
+
+            if(worker_tiles_done == ENGINE_DRAW_DEFERRED_TILE_COUNT){
+                SDL_CondSignal(worker_batch_done);
+            }
+        }
+    }
+
+
+    static int engine_draw_deferred_worker(void *data){
+        SDL_LockMutex(worker_mutex);
+
+        uint32_t seen_batch = worker_batch;
+
+        while(true){
+            while(worker_batch == seen_batch){
+                SDL_CondWait(worker_batch_started, worker_mutex);
+            }
+
+            seen_batch = worker_batch;
+            engine_draw_deferred_take_tiles();
+        }
+
+        return 0;
+    }
+
+
+    // Started the first time deferred drawing is enabled and never stopped
+    static void engine_draw_deferred_start_workers(){
+        if(worker_mutex != NULL){
+            return;
+        }
+
+        worker_mutex = SDL_CreateMutex();
+        worker_batch_started = SDL_CreateCond();
+        worker_batch_done = SDL_CreateCond();
+
+        // The engine thread rasterizes tiles too
+        int worker_count = SDL_GetCPUCount() - 1;
+        if(worker_count > ENGINE_DRAW_DEFERRED_MAX_WORKERS) worker_count = ENGINE_DRAW_DEFERRED_MAX_WORKERS;
+
+        for(int iwx=0; iwx<worker_count; iwx++){
+            SDL_Thread *thread = SDL_CreateThread(engine_draw_deferred_worker, "engine_draw", NULL);
+
+            if(thread == NULL){
+                ENGINE_WARNING_PRINTF("Deferred drawing: could not start worker thread: %s", SDL_GetError());
+                break;
+            }
+
+            SDL_DetachThread(thread);
+        }
+    }
+
+
+    static void engine_draw_deferred_rasterize_tiles(){
+        SDL_LockMutex(worker_mutex);
+
+        worker_next_tile = 0;
+        worker_tiles_done = 0;
+        worker_batch++;
+        SDL_CondBroadcast(worker_batch_started);
+
+        engine_draw_deferred_take_tiles();
+
+        while(worker_tiles_done < ENGINE_DRAW_DEFERRED_TILE_COUNT){
+            SDL_CondWait(worker_batch_done, worker_mutex);
+        }
+
+        SDL_UnlockMutex(worker_mutex);
+    }
+#else
+    static void engine_draw_deferred_rasterize_tiles(){
+        for(uint8_t tile=0; tile<ENGINE_DRAW_DEFERRED_TILE_COUNT; tile++){
+            engine_draw_deferred_rasterize_tile(tile);
+        }
+    }
+#endif
+
+
+void engine_draw_deferred_set_enabled(bool enabled){
+    if(enabled == deferred_enabled){
+        return;
+    }
+
+    deferred_enabled = enabled;
+
+    if(enabled){
+        commands = m_tracked_calloc(ENGINE_DRAW_DEFERRED_MAX_COMMANDS, sizeof(engine_draw_command_t));
+
+        #if defined(ENGINE_DRAW_DEFERRED_MAX_WORKERS)
+            engine_draw_deferred_start_workers();
+        #endif
+    }else{
+        m_tracked_free(commands);
+        commands = NULL;
+        command_count = 0;
+    }
+}
+
+
+bool engine_draw_deferred_is_enabled(){
+    return deferred_enabled;
+}
+
+
+void engine_draw_deferred_begin(){
+    if(deferred_enabled == false){
+        return;
+    }
+
+    for(uint8_t tile=0; tile<ENGINE_DRAW_DEFERRED_TILE_COUNT; tile++){
+        engine_draw_clip_t *clip = &tile_clips[tile];
+
+        clip->x0 = (tile % ENGINE_DRAW_DEFERRED_TILES_X) * ENGINE_DRAW_DEFERRED_TILE_SIZE;
+        clip->y0 = (tile / ENGINE_DRAW_DEFERRED_TILES_X) * ENGINE_DRAW_DEFERRED_TILE_SIZE;
+        clip->x1 = min(clip->x0 + ENGINE_DRAW_DEFERRED_TILE_SIZE, SCREEN_WIDTH);
+        clip->y1 = min(clip->y0 + ENGINE_DRAW_DEFERRED_TILE_SIZE, SCREEN_HEIGHT);
+        clip->covered = false;
+    }
+
+    command_count = 0;
+    deferred_recording = true;
+}
+
+
+void engine_draw_deferred_end(){
+    if(deferred_recording == false){
+        return;
+    }
+
+    engine_draw_deferred_flush();
+    deferred_recording = false;
+}
+
+
+void engine_draw_deferred_cancel(){
+    deferred_recording = false;
+    command_count = 0;
+}
+
+
+bool engine_draw_deferred_is_recording(){
+    return deferred_recording;
+}
+
+
+void engine_draw_deferred_flush(){
+    if(command_count == 0){
+        return;
+    }
+
+    // The rasterizers draw instead of recording while this is false
+    bool recording = deferred_recording;
+    deferred_recording = false;
+
+    engine_draw_deferred_rasterize_tiles();
+
+    deferred_recording = recording;
+    command_count = 0;
+
+    // Every tile being covered covers the screen
+    for(uint8_t tile=0; tile<ENGINE_DRAW_DEFERRED_TILE_COUNT; tile++){
+        if(tile_clips[tile].covered == false){
+            return;
+        }
+    }
+
+    engine_draw_set_covered();
+}
+
+
+void engine_draw_deferred_record_line(uint16_t color, float x_start, float y_start, float x_end, float y_end, float alpha, engine_shader_t *shader){
+    engine_draw_command_t *command = engine_draw_deferred_next(ENGINE_DRAW_COMMAND_LINE, alpha, shader);
+    command->line.color = color;
+    command->line.x_start = x_start;
+    command->line.y_start = y_start;
+    command->line.x_end = x_end;
+    command->line.y_end = y_end;
+
+    engine_draw_deferred_bin(command, fminf(x_start, x_end) - 1.0f, fminf(y_start, y_end) - 1.0f, fmaxf(x_start, x_end) + 2.0f, fmaxf(y_start, y_end) + 2.0f);
+}
+
+
+void engine_draw_deferred_record_blit(texture_resource_class_obj_t *texture, uint32_t offset, float center_x, float center_y, int32_t window_width, int32_t window_height, uint32_t pixels_stride, float x_scale, float y_scale, float rotation_radians, uint16_t transparent_color, float alpha, engine_shader_t *shader){
+    engine_draw_command_t *command = engine_draw_deferred_next(ENGINE_DRAW_COMMAND_BLIT, alpha, shader);
+    command->blit.texture = texture;
+    command->blit.offset = offset;
+    command->blit.center_x = center_x;
+    command->blit.center_y = center_y;
+    command->blit.window_width = window_width;
+    command->blit.window_height = window_height;
+    command->blit.pixels_stride = pixels_stride;
+    command->blit.x_scale = x_scale;
+    command->blit.y_scale = y_scale;
+    command->blit.rotation_radians = rotation_radians;
+    command->blit.transparent_color = transparent_color;
+
+    engine_draw_deferred_bin_square(command, center_x, center_y, window_width * x_scale, window_height * y_scale);
+}
+
+
+void engine_draw_deferred_record_blit_depth(texture_resource_class_obj_t *texture, uint32_t offset, float center_x, float center_y, int32_t window_width, int32_t window_height, uint32_t pixels_stride, float x_scale, float y_scale, float rotation_radians, uint16_t transparent_color, float alpha, uint16_t depth, engine_shader_t *shader){
+    engine_draw_command_t *command = engine_draw_deferred_next(ENGINE_DRAW_COMMAND_BLIT_DEPTH, alpha, shader);
+    command->blit.texture = texture;
+    command->blit.offset = offset;
+    command->blit.center_x = center_x;
+    command->blit.center_y = center_y;
+    command->blit.window_width = window_width;
+    command->blit.window_height = window_height;
+    command->blit.pixels_stride = pixels_stride;
+    command->blit.x_scale = x_scale;
+    command->blit.y_scale = y_scale;
+    command->blit.rotation_radians = rotation_radians;
+    command->blit.transparent_color = transparent_color;
+    command->blit.depth = depth;
+
+    engine_draw_deferred_bin_square(command, center_x, center_y, window_width * x_scale, window_height * y_scale);
+}
+
+
+void engine_draw_deferred_record_rect(uint16_t color, float center_x, float center_y, int32_t width, int32_t height, float x_scale, float y_scale, float rotation_radians, float alpha, engine_shader_t *shader){
+    engine_draw_command_t *command = engine_draw_deferred_next(ENGINE_DRAW_COMMAND_RECT, alpha, shader);
+    command->rect.color = color;
+    command->rect.center_x = center_x;
+    command->rect.center_y = center_y;
+    command->rect.width = width;
+    command->rect.height = height;
+    command->rect.x_scale = x_scale;
+    command->rect.y_scale = y_scale;
+    command->rect.rotation_radians = rotation_radians;
+
+    engine_draw_deferred_bin_square(command, center_x, center_y, width * x_scale, height * y_scale);
+}
+
+
+void engine_draw_deferred_record_outline_circle(uint16_t color, float center_x, float center_y, float radius, float alpha, engine_shader_t *shader){
+    engine_draw_command_t *command = engine_draw_deferred_next(ENGINE_DRAW_COMMAND_OUTLINE_CIRCLE, alpha, shader);
+    command->circle.color = color;
+    command->circle.center_x = center_x;
+    command->circle.center_y = center_y;
+    command->circle.radius = radius;
+
+    float extent = fabsf(radius) + 2.0f;
+    engine_draw_deferred_bin(command, center_x - extent, center_y - extent, center_x + extent, center_y + extent);
+}
+
+
+void engine_draw_deferred_record_filled_circle(uint16_t color, float center_x, float center_y, float radius, float alpha, engine_shader_t *shader){
+    engine_draw_command_t *command = engine_draw_deferred_next(ENGINE_DRAW_COMMAND_FILLED_CIRCLE, alpha, shader);
+    command->circle.color = color;
+    command->circle.center_x = center_x;
+    command->circle.center_y = center_y;
+    command->circle.radius = radius;
+
+    float extent = fabsf(radius) + 2.0f;
+    engine_draw_deferred_bin(command, center_x - extent, center_y - extent, center_x + extent, center_y + extent);
+}
+
+
+void engine_draw_deferred_record_filled_triangle(uint16_t color, float x0, float y0, float x1, float y1, float x2, float y2, float alpha, engine_shader_t *shader){
+    engine_draw_command_t *command = engine_draw_deferred_next(ENGINE_DRAW_COMMAND_FILLED_TRIANGLE, alpha, shader);
+    command->triangle.color = color;
+
+    command->triangle.x[0] = x0; command->triangle.y[0] = y0;
+    command->triangle.x[1] = x1; command->triangle.y[1] = y1;
+    command->triangle.x[2] = x2; command->triangle.y[2] = y2;
+
+    engine_draw_deferred_bin(command, fminf(fminf(x0, x1), x2) - 1.0f, fminf(fminf(y0, y1), y2) - 1.0f, fmaxf(fmaxf(x0, x1), x2) + 2.0f, fmaxf(fmaxf(y0, y1), y2) + 2.0f);
+}
+
+
+void engine_draw_deferred_record_filled_triangle_depth(texture_resource_class_obj_t *texture, uint16_t color,
+                                                       float ax, float ay, uint16_t depth_az, float au, float av,
+                                                       float bx, float by, uint16_t depth_bz, float bu, float bv,
+                                                       float cx, float cy, uint16_t depth_cz, float cu, float cv,
+                                                       float w0, float w1, float w2,
+                                                       float alpha, engine_shader_t *shader){
+    engine_draw_command_t *command = engine_draw_deferred_next(ENGINE_DRAW_COMMAND_FILLED_TRIANGLE_DEPTH, alpha, shader);
+    command->triangle.texture = texture;
+    command->triangle.color = color;
+
+    command->triangle.x[0] = ax; command->triangle.y[0] = ay; command->triangle.depth[0] = depth_az; command->triangle.u[0] = au; command->triangle.v[0] = av;
+    command->triangle.x[1] = bx; command->triangle.y[1] = by; command->triangle.depth[1] = depth_bz; command->triangle.u[1] = bu; command->triangle.v[1] = bv;
+    command->triangle.x[2] = cx; command->triangle.y[2] = cy; command->triangle.depth[2] = depth_cz; command->triangle.u[2] = cu; command->triangle.v[2] = cv;
+
+    command->triangle.w[0] = w0;
+    command->triangle.w[1] = w1;
+    command->triangle.w[2] = w2;
+
+    engine_draw_deferred_bin(command, fminf(fminf(ax, bx), cx) - 1.0f, fminf(fminf(ay, by), cy) - 1.0f, fmaxf(fmaxf(ax, bx), cx) + 2.0f, fmaxf(fmaxf(ay, by), cy) + 2.0f);
+}
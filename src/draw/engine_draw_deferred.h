@@ -0,0 +1,62 @@
+#ifndef ENGINE_DRAW_DEFERRED_H
+#define ENGINE_DRAW_DEFERRED_H
+
+#include "py/obj.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include "draw/engine_shader.h"
+#include "resources/engine_texture_resource.h"
+
+// Deferred drawing. When enabled, the rasterizers in 'engine_display_draw.c'
+// don't draw while the node draw callbacks run but record compact commands
+// instead (text records a blit per glyph). Each command is binned into the
+// screen tiles its bounding box touches and after the draw callbacks every
+// tile is rasterized with all of its commands in order so that its part of
+// the screen buffer stays in cache. Tiles are rasterized with their clip
+// set (see 'engine_draw_set_clip()') so the result is exactly what drawing
+// immediately gives
+
+#define ENGINE_DRAW_DEFERRED_TILE_SIZE 32           // Width and height of each tile in pixels
+#define ENGINE_DRAW_DEFERRED_MAX_COMMANDS 512       // Recorded commands are rasterized early when there are this many
+
+// The unix port rasterizes tiles on this many threads
+// alongside the thread running the engine
+#if defined(__unix__) && !defined(__EMSCRIPTEN__)
+    #define ENGINE_DRAW_DEFERRED_MAX_WORKERS 3
+#endif
+
+
+void engine_draw_deferred_set_enabled(bool enabled);
+bool engine_draw_deferred_is_enabled();
+
+// Start and end recording a draw pass (see 'engine_invoke_all_node_draw_callbacks()').
+// Ending it rasterizes everything that was recorded. Does nothing when not enabled
+void engine_draw_deferred_begin();
+void engine_draw_deferred_end();
+
+// Called if a draw callback raised, drops what was recorded
+void engine_draw_deferred_cancel();
+
+// True between begin and end except while rasterizing
+bool engine_draw_deferred_is_recording();
+
+// Rasterizes what was recorded so far. Called when the command buffer is
+// full and before drawing anything that isn't recorded (single pixels)
+void engine_draw_deferred_flush();
+
+// Record a command for the 'engine_draw_*' function of the same name and arguments
+void engine_draw_deferred_record_line(uint16_t color, float x_start, float y_start, float x_end, float y_end, float alpha, engine_shader_t *shader);
+void engine_draw_deferred_record_blit(texture_resource_class_obj_t *texture, uint32_t offset, float center_x, float center_y, int32_t window_width, int32_t window_height, uint32_t pixels_stride, float x_scale, float y_scale, float rotation_radians, uint16_t transparent_color, float alpha, engine_shader_t *shader);
+void engine_draw_deferred_record_blit_depth(texture_resource_class_obj_t *texture, uint32_t offset, float center_x, float center_y, int32_t window_width, int32_t window_height, uint32_t pixels_stride, float x_scale, float y_scale, float rotation_radians, uint16_t transparent_color, float alpha, uint16_t depth, engine_shader_t *shader);
+void engine_draw_deferred_record_rect(uint16_t color, float center_x, float center_y, int32_t width, int32_t height, float x_scale, float y_scale, float rotation_radians, float alpha, engine_shader_t *shader);
+void engine_draw_deferred_record_outline_circle(uint16_t color, float center_x, float center_y, float radius, float alpha, engine_shader_t *shader);
+void engine_draw_deferred_record_filled_circle(uint16_t color, float center_x, float center_y, float radius, float alpha, engine_shader_t *shader);
+void engine_draw_deferred_record_filled_triangle(uint16_t color, float x0, float y0, float x1, float y1, float x2, float y2, float alpha, engine_shader_t *shader);
+void engine_draw_deferred_record_filled_triangle_depth(texture_resource_class_obj_t *texture, uint16_t color,
+                                                       float ax, float ay, uint16_t depth_az, float au, float av,
+                                                       float bx, float by, uint16_t depth_bz, float bu, float bv,
+                                                       float cx, float cy, uint16_t depth_cz, float cu, float cv,
+                                                       float w0, float w1, float w2,
+                                                       float alpha, engine_shader_t *shader);
+
+#endif  // ENGINE_DRAW_DEFERRED_H
@@ -1,9 +1,17 @@
 #include "py/obj.h"
 #include "py/runtime.h"
 #include "display/engine_display_common.h"
+#include "display/engine_display_damage.h"
+#include "draw/engine_draw_deferred.h"
+#include "draw/engine_draw_static.h"
 #include "resources/engine_texture_resource.h"
 #include "resources/engine_resource_manager.h"
+#include "nodes/node_base.h"
+#include "nodes/3D/camera_node.h"
+#include "engine_object_layers.h"
 #include "engine_color.h"
+#include "math/vector2.h"
+#include "engine_shader.h"
 #include "debug/debug_print.h"
 #include "engine_main.h"
 
@@ -51,6 +59,215 @@ static mp_obj_t engine_draw_set_background(mp_obj_t background){
 MP_DEFINE_CONST_FUN_OBJ_1(engine_draw_set_background_obj, engine_draw_set_background);
 
 
+/*  --- doc ---
+    NAME: set_background_covered
+    ID: set_background_covered
+    DESC: Tells the engine that every frame draws something opaque over the whole screen so that clearing the framebuffer to the background between frames can be skipped. Unrotated full-screen sprites (without transparent pixels) and rectangles are detected without this, use it for things like a {ref_link:VoxelSpaceNode} that fills the screen. Reset to False after a game exits
+    PARAM: [type=bool]   [name=covered]  [value=True or False]
+    RETURN: None
+*/
+static mp_obj_t engine_draw_set_background_covered(mp_obj_t covered){
+    engine_display_set_fill_covered(mp_obj_is_true(covered));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(engine_draw_set_background_covered_obj, engine_draw_set_background_covered);
+
+
+/*  --- doc ---
+    NAME: set_partial_updates
+    ID: set_partial_updates
+    DESC: When enabled, only the parts of the screen where 2D nodes moved, changed size or opacity, had an attribute set, or were destroyed are cleared, redrawn, and sent to the screen each frame. Frames that change more than half of the screen (or that draw GUI, 3D, or outlined physics nodes) are still full frames. The clearing happens while drawing nodes so games that draw to {ref_link:back_fb} themselves should leave this off. Games that edit texture data in place should call {ref_link:invalidate} after doing so. Off (full frames) by default and after a game exits
+    PARAM: [type=bool]   [name=enabled]  [value=True or False]
+    RETURN: None
+*/
+static mp_obj_t engine_draw_set_partial_updates(mp_obj_t enabled){
+    engine_display_damage_set_enabled(mp_obj_is_true(enabled));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(engine_draw_set_partial_updates_obj, engine_draw_set_partial_updates);
+
+
+/*  --- doc ---
+    NAME: invalidate
+    ID: invalidate
+    DESC: Makes the next frame redraw and send the whole screen when {ref_link:set_partial_updates} is enabled. Also draws the {ref_link:engine_layer_static} layers again, call this after changing something in them in place (like `node.position.x += 1`)
+    RETURN: None
+*/
+static mp_obj_t engine_draw_invalidate(){
+    engine_display_damage_invalidate();
+    engine_draw_static_invalidate();
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_0(engine_draw_invalidate_obj, engine_draw_invalidate);
+
+
+/*  --- doc ---
+    NAME: set_deferred
+    ID: set_deferred
+    DESC: When enabled, nodes don't draw to the screen buffer as they are visited but record what they draw instead. Everything recorded is then drawn in 32x32 pixel tiles, one tile at a time (on several threads on the unix port), which keeps each part of the screen buffer in cache while it is drawn to. What ends up on screen is exactly the same as with this off. Off by default and after a game exits
+    PARAM: [type=bool]   [name=enabled]  [value=True or False]
+    RETURN: None
+*/
+static mp_obj_t engine_draw_set_deferred(mp_obj_t enabled){
+    engine_draw_deferred_set_enabled(mp_obj_is_true(enabled));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(engine_draw_set_deferred_obj, engine_draw_set_deferred);
+
+
+// Reads a point passed as a `Vector2` or any `(x, y)` sequence
+static void engine_draw_get_point(mp_obj_t point, float *x, float *y){
+    if(mp_obj_is_type(point, &vector2_class_type)){
+        vector2_class_obj_t *vector = MP_OBJ_TO_PTR(point);
+        *x = vector->x.value;
+        *y = vector->y.value;
+    }else{
+        mp_obj_t *items;
+        mp_obj_get_array_fixed_n(point, 2, &items);
+        *x = mp_obj_get_float(items[0]);
+        *y = mp_obj_get_float(items[1]);
+    }
+}
+
+
+/*  --- doc ---
+    NAME: triangle
+    ID: engine_draw_triangle
+    DESC: Fills a triangle in the screen buffer right away, the same as drawing to {ref_link:back_fb} (call it after {ref_link:engine_tick} returns True to draw over the nodes). Triangles that share an edge don't overlap or leave gaps between them
+    PARAM:  [type={ref_link:Color}|int]     [name=color]    [value=Color or int (RGB565)]
+    PARAM:  [type={ref_link:Vector2}|tuple] [name=a]        [value=first corner in screen pixels]
+    PARAM:  [type={ref_link:Vector2}|tuple] [name=b]        [value=second corner in screen pixels]
+    PARAM:  [type={ref_link:Vector2}|tuple] [name=c]        [value=third corner in screen pixels]
+    PARAM:  [type=float]                    [name=opacity]  [value=0.0 ~ 1.0 (optional, defaults to 1.0)]
+    RETURN: None
+*/
+static mp_obj_t engine_draw_triangle(size_t n_args, const mp_obj_t *args){
+    uint16_t color = engine_color_class_color_value(args[0]);
+    float opacity = (n_args >= 5) ? mp_obj_get_float(args[4]) : 1.0f;
+
+    float xs[3];
+    float ys[3];
+
+    for(uint8_t ivx=0; ivx<3; ivx++){
+        engine_draw_get_point(args[1+ivx], &xs[ivx], &ys[ivx]);
+    }
+
+    engine_draw_filled_triangle(color, xs[0], ys[0], xs[1], ys[1], xs[2], ys[2], opacity, engine_shader_resolve(mp_const_none, opacity < 1.0f));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(engine_draw_triangle_obj, 4, 5, engine_draw_triangle);
+
+
+/*  --- doc ---
+    NAME: polygon
+    ID: engine_draw_polygon
+    DESC: Fills a convex polygon in the screen buffer right away, the same as {ref_link:engine_draw_triangle}. The points can go around either way. Concave polygons are filled as if every row of them was convex
+    PARAM:  [type={ref_link:Color}|int] [name=color]    [value=Color or int (RGB565)]
+    PARAM:  [type=list]                 [name=points]   [value=3 ~ 32 {ref_link:Vector2}s or (x, y) tuples in screen pixels]
+    PARAM:  [type=float]                [name=opacity]  [value=0.0 ~ 1.0 (optional, defaults to 1.0)]
+    RETURN: None
+*/
+static mp_obj_t engine_draw_polygon(size_t n_args, const mp_obj_t *args){
+    uint16_t color = engine_color_class_color_value(args[0]);
+    float opacity = (n_args >= 3) ? mp_obj_get_float(args[2]) : 1.0f;
+
+    size_t point_count;
+    mp_obj_t *points;
+    mp_obj_get_array(args[1], &point_count, &points);
+
+    if(point_count < 3 || point_count > ENGINE_DRAW_POLYGON_MAX_VERTICES){
+        mp_raise_msg_varg(&mp_type_ValueError, MP_ERROR_TEXT("EngineDraw: ERROR: A polygon needs between 3 and %d points, got %d"), ENGINE_DRAW_POLYGON_MAX_VERTICES, (int)point_count);
+    }
+
+    float xs[ENGINE_DRAW_POLYGON_MAX_VERTICES];
+    float ys[ENGINE_DRAW_POLYGON_MAX_VERTICES];
+
+    for(size_t ivx=0; ivx<point_count; ivx++){
+        engine_draw_get_point(points[ivx], &xs[ivx], &ys[ivx]);
+    }
+
+    engine_draw_filled_polygon(color, xs, ys, (uint8_t)point_count, opacity, engine_shader_resolve(mp_const_none, opacity < 1.0f));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(engine_draw_polygon_obj, 2, 3, engine_draw_polygon);
+
+
+/*  --- doc ---
+    NAME: render
+    ID: render
+    DESC: Draws nodes into a {ref_link:TextureResource} instead of the screen, as seen by one camera. Nodes are placed relative to the center of the camera's viewport, give the camera a viewport the size of the texture to center it on the texture. The texture can then be drawn by {ref_link:Sprite2DNode}s like any other, which is much cheaper than drawing many nodes that rarely change every frame (put them in a layer that {ref_link:engine_layer_offscreen} keeps off the screen). Render again whenever they change. The texture needs to be a 16-bit RGB565 texture in RAM (for example `TextureResource(64, 32)`) no larger than the screen and should not be drawn by the nodes being rendered. Makes the next frame redraw the whole screen when {ref_link:set_partial_updates} is enabled
+    PARAM:  [type={ref_link:TextureResource}]   [name=texture]      [value={ref_link:TextureResource}]
+    PARAM:  [type={ref_link:CameraNode}]        [name=camera]       [value={ref_link:CameraNode}]
+    PARAM:  [type=int]                          [name=layer]        [value=only draw the nodes in this layer (optional, defaults to None for all layers)]
+    PARAM:  [type={ref_link:Color}|int]         [name=clear_color]  [value=fill the texture with this color first (optional, defaults to None to draw over what is there)]
+    RETURN: None
+*/
+static mp_obj_t engine_draw_render(size_t n_args, const mp_obj_t *args){
+    if(mp_obj_is_type(args[0], &texture_resource_class_type) == false){
+        mp_raise_msg_varg(&mp_type_TypeError, MP_ERROR_TEXT("EngineDraw: ERROR: Expected a `TextureResource` to render to, got: %s"), mp_obj_get_type_str(args[0]));
+    }
+
+    if(mp_obj_is_subclass_fast(MP_OBJ_FROM_PTR(mp_obj_get_type(args[1])), MP_OBJ_FROM_PTR(&engine_camera_node_class_type)) == false){
+        mp_raise_msg_varg(&mp_type_TypeError, MP_ERROR_TEXT("EngineDraw: ERROR: Expected a `CameraNode` to render with, got: %s"), mp_obj_get_type_str(args[1]));
+    }
+
+    texture_resource_class_obj_t *texture = args[0];
+    engine_node_base_t *camera_node_base = node_base_get(args[1], NULL);
+
+    // The rasterizers use the same row buffers and
+    // depth buffer as when drawing to the screen
+    if(texture->width > SCREEN_WIDTH || texture->height > SCREEN_HEIGHT){
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("EngineDraw: ERROR: Can't render to a texture larger than the screen!"));
+    }
+
+    if(texture->bit_depth != 16 || texture->alpha_mask != 0 ||
+       texture->red_mask   != 0b1111100000000000 ||
+       texture->green_mask != 0b0000011111100000 ||
+       texture->blue_mask  != 0b0000000000011111){
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("EngineDraw: ERROR: Can only render to 16-bit RGB565 textures!"));
+    }
+
+    // Textures loaded from files are stored in flash unless asked not to be
+    if(texture->in_ram == false){
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("EngineDraw: ERROR: Can only render to textures stored in RAM!"));
+    }
+
+    uint8_t first_layer = 0;
+    uint8_t last_layer = engine_objects_get_layer_count() - 1;
+
+    if(n_args >= 3 && args[2] != mp_const_none){
+        mp_int_t layer = mp_obj_get_int(args[2]);
+
+        if(layer < 0 || layer >= engine_objects_get_layer_count()){
+            mp_raise_msg_varg(&mp_type_ValueError, MP_ERROR_TEXT("EngineDraw: ERROR: Layer must be between 0 and %d"), engine_objects_get_layer_count()-1);
+        }
+
+        first_layer = (uint8_t)layer;
+        last_layer = (uint8_t)layer;
+    }
+
+    uint16_t *pixels = ((mp_obj_array_t*)texture->data)->items;
+
+    if(n_args >= 4 && args[3] != mp_const_none){
+        uint16_t clear_color = engine_color_class_color_value(args[3]);
+        uint32_t pixel_count = texture->width * texture->height;
+
+        for(uint32_t ipx=0; ipx<pixel_count; ipx++){
+            pixels[ipx] = clear_color;
+        }
+    }
+
+    engine_invoke_node_draw_callbacks_offscreen(pixels, texture->width, texture->height, NULL, camera_node_base, first_layer, last_layer);
+
+    // Sprites showing the texture could be anywhere on screen
+    engine_display_damage_invalidate();
+    engine_draw_static_invalidate();
+
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(engine_draw_render_obj, 2, 4, engine_draw_render);
+
+
 static mp_obj_t engine_draw_module_init(){
     engine_main_raise_if_not_initialized();
     return mp_const_none;
@@ -135,11 +352,19 @@ color_class_obj_t violet        = {{&const_color_class_type}, .value = 0x915C};
     DESC: Module for drawing to the framebuffer
     ATTR: [type=function]           [name={ref_link:set_background_color}]  [value=function]
     ATTR: [type=function]           [name={ref_link:set_background}]        [value=function]
+    ATTR: [type=function]           [name={ref_link:set_background_covered}] [value=function]
+    ATTR: [type=function]           [name={ref_link:set_partial_updates}]   [value=function]
+    ATTR: [type=function]           [name={ref_link:invalidate}]            [value=function]
+    ATTR: [type=function]           [name={ref_link:set_deferred}]          [value=function]
+    ATTR: [type=function]           [name={ref_link:render}]                [value=function]
+    ATTR: [type=function]           [name={ref_link:engine_draw_triangle}]  [value=function]
+    ATTR: [type=function]           [name={ref_link:engine_draw_polygon}]   [value=function]
     ATTR: [type=function]           [name={ref_link:back_fb_data}]          [value=getter/setter function]
     ATTR: [type=function]           [name={ref_link:front_fb_data}]         [value=getter/setter function]
     ATTR: [type=function]           [name={ref_link:back_fb}]               [value=getter/setter function]
     ATTR: [type=function]           [name={ref_link:front_fb}]              [value=getter/setter function]
     ATTR: [type=type]               [name={ref_link:Color}]                 [value=type]
+    ATTR: [type=type]               [name={ref_link:Shader}]                [value=type]
     ATTR: [type={ref_link:Color}]   [name=black]                            [value=0x0000]
     ATTR: [type={ref_link:Color}]   [name=navy]                             [value=0x000F]
     ATTR: [type={ref_link:Color}]   [name=darkgreen]                        [value=0x03E0]
@@ -170,7 +395,15 @@ static const mp_rom_map_elem_t engine_draw_globals_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR___init__), MP_ROM_PTR(&engine_draw_module_init_obj) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_set_background_color), MP_ROM_PTR(&engine_draw_set_background_color_obj) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_set_background), MP_ROM_PTR(&engine_draw_set_background_obj) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_background_covered), MP_ROM_PTR(&engine_draw_set_background_covered_obj) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_partial_updates), MP_ROM_PTR(&engine_draw_set_partial_updates_obj) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_invalidate), MP_ROM_PTR(&engine_draw_invalidate_obj) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_deferred), MP_ROM_PTR(&engine_draw_set_deferred_obj) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_render), MP_ROM_PTR(&engine_draw_render_obj) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_triangle), MP_ROM_PTR(&engine_draw_triangle_obj) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_polygon), MP_ROM_PTR(&engine_draw_polygon_obj) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_Color), MP_ROM_PTR(&color_class_type) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_Shader), MP_ROM_PTR(&shader_class_type) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_black), MP_ROM_PTR(&black) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_navy), MP_ROM_PTR(&navy) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_darkgreen), MP_ROM_PTR(&darkgreen) },
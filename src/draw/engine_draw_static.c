@@ -0,0 +1,261 @@
+#include "draw/engine_draw_static.h"
+#include "draw/engine_display_draw.h"
+#include "display/engine_display_common.h"
+#include "nodes/node_base.h"
+#include "nodes/3D/camera_node.h"
+#include "math/rectangle.h"
+#include "math/engine_math.h"
+#include "engine_object_layers.h"
+#include "engine_collections.h"
+#include "debug/debug_print.h"
+#include "py/misc.h"
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+// Everything about the camera that changes where and how
+// the static layers are drawn. 'origin_x/y' is where the
+// world origin was on screen when the cache was drawn
+typedef struct{
+    engine_node_base_t *camera_node_base;
+    float origin_x;
+    float origin_y;
+    float rotation;
+    float zoom;
+    float opacity;
+    float viewport_width;
+    float viewport_height;
+}engine_draw_static_view_t;
+
+static uint16_t *static_buffer = NULL;
+static int16_t static_last_layer = -1;
+static engine_draw_static_view_t static_view;
+
+// Set when something in the static layers changed
+static bool static_dirty = true;
+
+// Set when everything drawn into the cache comes out exactly the same
+// when drawn again moved by whole pixels (see 'engine_draw_is_shift_exact()'),
+// only then is scrolling the cache the same as drawing it again
+static bool static_shift_exact = false;
+
+
+// Returns the only camera drawing to the screen or NULL if there are more (or none)
+static engine_node_base_t *engine_draw_static_get_camera(){
+    linked_list_node *current_camera_list_node = engine_collections_get_camera_list()->start;
+    engine_node_base_t *screen_camera_node_base = NULL;
+
+    while(current_camera_list_node != NULL){
+        engine_node_base_t *camera_node_base = current_camera_list_node->object;
+        current_camera_list_node = current_camera_list_node->next;
+
+        // Only used to render into textures
+        if(engine_objects_is_layer_offscreen(camera_node_base->layer)){
+            continue;
+        }
+
+        if(screen_camera_node_base != NULL){
+            return NULL;
+        }
+
+        screen_camera_node_base = camera_node_base;
+    }
+
+    return screen_camera_node_base;
+}
+
+
+static engine_draw_static_view_t engine_draw_static_get_view(engine_node_base_t *camera_node_base){
+    engine_camera_node_class_obj_t *camera = camera_node_base->node;
+    rectangle_class_obj_t *camera_viewport = camera->viewport;
+
+    engine_draw_static_view_t view;
+    view.camera_node_base = camera_node_base;
+    view.origin_x = 0.0f;
+    view.origin_y = 0.0f;
+    view.rotation = 0.0f;
+    view.zoom = mp_obj_get_float(camera->zoom);
+    view.opacity = mp_obj_get_float(camera->opacity);
+    view.viewport_width = camera_viewport->width;
+    view.viewport_height = camera_viewport->height;
+
+    engine_camera_transform_2d(camera_node_base, &view.origin_x, &view.origin_y, &view.rotation);
+
+    return view;
+}
+
+
+// Clears the area of the cache from '(x0, y0)' up to but not including
+// '(x1, y1)' to the background and draws the static layers inside of it
+static void engine_draw_static_draw_rect(int32_t x0, int32_t y0, int32_t x1, int32_t y1){
+    uint16_t *engine_fill_background = engine_display_get_background();
+
+    if(engine_fill_background != NULL){
+        engine_draw_fill_buffer_rect(engine_fill_background, static_buffer, x0, y0, x1 - x0, y1 - y0);
+    }else{
+        engine_draw_fill_color_rect(engine_display_get_color(), static_buffer, x0, y0, x1 - x0, y1 - y0);
+    }
+
+    engine_draw_clip_t clip = {x0, y0, x1, y1, false};
+
+    // Draw each run of layers between the offscreen ones
+    int16_t run_start = -1;
+
+    for(int16_t ilx=0; ilx<=static_last_layer+1; ilx++){
+        bool drawn = ilx <= static_last_layer && engine_objects_is_layer_offscreen(ilx) == false;
+
+        if(drawn && run_start == -1){
+            run_start = ilx;
+        }else if(drawn == false && run_start != -1){
+            engine_invoke_node_draw_callbacks_offscreen(static_buffer, SCREEN_WIDTH, SCREEN_HEIGHT, &clip, static_view.camera_node_base, run_start, ilx-1);
+            run_start = -1;
+        }
+    }
+}
+
+
+// Moves what's in the cache by whole pixels and draws the uncovered edges
+static void engine_draw_static_scroll(int32_t shift_x, int32_t shift_y){
+    int32_t row_width = SCREEN_WIDTH - abs(shift_x);
+    int32_t src_x = (shift_x < 0) ? -shift_x : 0;
+    int32_t dst_x = (shift_x > 0) ? shift_x : 0;
+
+    // Go against the direction of the shift so that rows
+    // are moved before they're written over
+    if(shift_y > 0){
+        for(int32_t y=SCREEN_HEIGHT-1; y>=shift_y; y--){
+            memmove(static_buffer + y*SCREEN_WIDTH + dst_x, static_buffer + (y-shift_y)*SCREEN_WIDTH + src_x, row_width*sizeof(uint16_t));
+        }
+    }else{
+        for(int32_t y=0; y<SCREEN_HEIGHT+shift_y; y++){
+            memmove(static_buffer + y*SCREEN_WIDTH + dst_x, static_buffer + (y-shift_y)*SCREEN_WIDTH + src_x, row_width*sizeof(uint16_t));
+        }
+    }
+
+    // Rows uncovered at the top or bottom
+    if(shift_y > 0){
+        engine_draw_static_draw_rect(0, 0, SCREEN_WIDTH, shift_y);
+    }else if(shift_y < 0){
+        engine_draw_static_draw_rect(0, SCREEN_HEIGHT+shift_y, SCREEN_WIDTH, SCREEN_HEIGHT);
+    }
+
+    // Columns uncovered on the left or right between those rows
+    int32_t kept_y0 = (shift_y > 0) ? shift_y : 0;
+    int32_t kept_y1 = (shift_y < 0) ? SCREEN_HEIGHT+shift_y : SCREEN_HEIGHT;
+
+    if(shift_x > 0){
+        engine_draw_static_draw_rect(0, kept_y0, shift_x, kept_y1);
+    }else if(shift_x < 0){
+        engine_draw_static_draw_rect(SCREEN_WIDTH+shift_x, kept_y0, SCREEN_WIDTH, kept_y1);
+    }
+}
+
+
+void engine_draw_static_invalidate(){
+    static_dirty = true;
+}
+
+
+bool engine_draw_static_update(){
+    int16_t last_layer = engine_objects_get_last_static_layer();
+    engine_node_base_t *camera_node_base = (last_layer == -1) ? NULL : engine_draw_static_get_camera();
+
+    // Nothing to cache, draw everything every frame again
+    if(camera_node_base == NULL){
+        if(static_buffer == NULL){
+            return false;
+        }
+
+        engine_draw_static_reset();
+        return true;
+    }
+
+    engine_draw_static_view_t view = engine_draw_static_get_view(camera_node_base);
+
+    if(static_buffer == NULL){
+        ENGINE_INFO_PRINTF("Creating static layer cache of size %d bytes", SCREEN_BUFFER_SIZE_BYTES);
+        static_buffer = m_tracked_calloc(1, SCREEN_BUFFER_SIZE_BYTES);
+        static_dirty = true;
+    }
+
+    // Only moving the camera shifts everything by the same amount.
+    // Background textures stay where they are, can't scroll over them
+    bool only_moved = static_dirty == false &&
+                      static_shift_exact &&
+                      engine_display_get_background() == NULL &&
+                      last_layer == static_last_layer &&
+                      view.camera_node_base == static_view.camera_node_base &&
+                      view.rotation == static_view.rotation &&
+                      view.zoom == static_view.zoom &&
+                      view.opacity == static_view.opacity &&
+                      view.viewport_width == static_view.viewport_width &&
+                      view.viewport_height == static_view.viewport_height;
+
+    if(only_moved){
+        float shift_x = view.origin_x - static_view.origin_x;
+        float shift_y = view.origin_y - static_view.origin_y;
+        float whole_shift_x = roundf(shift_x);
+        float whole_shift_y = roundf(shift_y);
+
+        // Nodes land on other pixels unless the shift is whole
+        if(engine_math_compare_floats(shift_x, whole_shift_x) &&
+           engine_math_compare_floats(shift_y, whole_shift_y) &&
+           fabsf(whole_shift_x) < SCREEN_WIDTH &&
+           fabsf(whole_shift_y) < SCREEN_HEIGHT){
+
+            if(whole_shift_x == 0.0f && whole_shift_y == 0.0f){
+                return false;
+            }
+
+            // Keep the origin the cache was drawn at so that
+            // rounding the shift doesn't add up over frames
+            static_view.origin_x += whole_shift_x;
+            static_view.origin_y += whole_shift_y;
+
+            static_dirty = true;
+            engine_draw_reset_shift_exact();
+            engine_draw_static_scroll((int32_t)whole_shift_x, (int32_t)whole_shift_y);
+
+            // Something that wasn't drawn in the cache before came into
+            // view along the edges and might not line up with the rest
+            if(engine_draw_is_shift_exact()){
+                static_dirty = false;
+                return true;
+            }
+        }
+    }
+
+    // Stays dirty if a draw callback raises (also while scrolling)
+    static_dirty = true;
+    static_last_layer = last_layer;
+    static_view = view;
+
+    engine_draw_reset_shift_exact();
+    engine_draw_static_draw_rect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+    static_shift_exact = engine_draw_is_shift_exact();
+
+    static_dirty = false;
+    return true;
+}
+
+
+uint16_t *engine_draw_static_get_buffer(){
+    return static_buffer;
+}
+
+
+int16_t engine_draw_static_get_last_layer(){
+    return (static_buffer != NULL) ? static_last_layer : -1;
+}
+
+
+void engine_draw_static_reset(){
+    if(static_buffer != NULL){
+        m_tracked_free(static_buffer);
+        static_buffer = NULL;
+    }
+
+    static_last_layer = -1;
+    static_dirty = true;
+    static_shift_exact = false;
+}
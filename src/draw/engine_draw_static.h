@@ -0,0 +1,37 @@
+#ifndef ENGINE_DRAW_STATIC_H
+#define ENGINE_DRAW_STATIC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Static layer caching. The nodes in the run of static layers at the bottom
+// (see 'engine_objects_get_last_static_layer()') are drawn once over the
+// background into a screen sized cache. Frames are then cleared to the cache
+// instead of the background (see 'engine_display_get_fill_buffer()') and the
+// draw pass skips those layers. The cache is drawn again when something in
+// the static layers changes or the camera zooms, rotates, fades or resizes
+// its viewport. When the camera only moves by whole pixels (and the
+// background is a color) the cache is scrolled and only the uncovered
+// edges are drawn. Only used while exactly one camera draws to the
+// screen, there would be one image per camera otherwise
+
+// Makes the next 'engine_draw_static_update()' draw the cache again
+void engine_draw_static_invalidate();
+
+// Called at the start of the draw pass to create, draw, scroll or free the
+// cache. Returns true if the cache changed (or stopped being used) since the
+// frame was cleared, it has to be cleared again then. Can raise if a draw
+// callback does
+bool engine_draw_static_update();
+
+// Returns the cache or NULL if there isn't one
+uint16_t *engine_draw_static_get_buffer();
+
+// Returns the last layer drawn into the cache (the draw pass starts
+// after it) or -1 if there isn't a cache
+int16_t engine_draw_static_get_last_layer();
+
+// Frees the cache (should be used on engine reset)
+void engine_draw_static_reset();
+
+#endif  // ENGINE_DRAW_STATIC_H
@@ -1,11 +1,87 @@
 #include "engine_shader.h"
 #include "draw/engine_color.h"
+#include "display/engine_display_common.h"
+#include "display/engine_display_damage.h"
+#include "draw/engine_draw_static.h"
+#include "draw/engine_display_draw.h"
 #include "debug/debug_print.h"
+#include "py/runtime.h"
 
 #include <string.h>
 #include <stdlib.h>
 
 
+// Thresholds (out of 16) for ordered dithering a 4x4 block of pixels
+static const uint8_t engine_shader_bayer_4x4[4][4] = {
+    { 0,  8,  2, 10},
+    {12,  4, 14,  6},
+    { 3, 11,  1,  9},
+    {15,  7, 13,  5}
+};
+
+
+// Runs the `fg` op codes of a compiled program
+static inline uint16_t engine_shader_run_stages(uint16_t fg, engine_shader_t *shader){
+    for(uint8_t index=0; index<shader->stage_count; index++){
+        engine_shader_stage_t *stage = &shader->stages[index];
+
+        switch(stage->op){
+            case SHADER_RGB_INTERPOLATE:
+                fg = engine_color_blend(fg, stage->color, stage->amount);
+            break;
+            case SHADER_MULTIPLY:
+                fg = engine_color_multiply(fg, stage->color);
+            break;
+            case SHADER_BRIGHTNESS:
+                fg = engine_color_brightness(fg, stage->amount);
+            break;
+            case SHADER_PALETTE_REMAP:
+                if(fg == stage->color) fg = stage->to_color;
+            break;
+            case SHADER_FLASH:
+                fg = stage->color;
+            break;
+        }
+    }
+
+    return fg;
+}
+
+
+// Runs the blend op code a compiled program ends with
+static inline uint16_t engine_shader_run_blend(uint16_t bg, uint16_t fg, float opacity, uint8_t blend){
+    switch(blend){
+        case SHADER_OPACITY_BLEND:
+            return engine_color_alpha_blend(bg, fg, opacity);
+        case SHADER_ADDITIVE_BLEND:
+            return engine_color_additive_blend(bg, fg, opacity);
+        case SHADER_DITHER_BLEND:
+            // Where a lone pixel is on screen isn't known, blend instead
+            return engine_color_alpha_blend(bg, fg, opacity);
+        default:
+            return fg;
+    }
+}
+
+
+// Writes the foreground (`src` run through the program or `color` if `src`
+// is NULL) to the pixels of a row of the draw target the dither pattern for
+// `opacity` covers, the rest are left alone
+static void engine_shader_dither(uint16_t *dst, const uint16_t *src, uint16_t color, uint32_t count, float opacity, engine_shader_t *shader){
+    const uint32_t target_width = engine_draw_get_target_width();
+    const uint32_t offset = dst - engine_draw_get_target();
+    const uint32_t x = offset % target_width;
+    const uint8_t *thresholds = engine_shader_bayer_4x4[(offset / target_width) & 3];
+    const uint8_t level = (uint8_t)(opacity * 16.0f + 0.5f);
+
+    for(uint32_t i=0; i<count; i++){
+        if(thresholds[(x+i) & 3] < level){
+            dst[i] = (src == NULL) ? color : engine_shader_run_stages(src[i], shader);
+        }
+    }
+}
+
+
 // Fast function for when a node doesn't have any effects
 uint16_t ENGINE_FAST_FUNCTION(engine_pixel_shader_empty)(uint16_t bg, uint16_t fg, float opacity, engine_shader_t *shader){
     return fg;
@@ -18,69 +94,520 @@ uint16_t ENGINE_FAST_FUNCTION(engine_pixel_shader_alpha)(uint16_t bg, uint16_t f
 }
 
 
-// Slow function for when a node has a custom shader (TODO: not implemented yet)
+// Generic function for compiled programs that don't match a fused kernel.
+// Operands were decoded at compile time so this only dispatches on op codes
 uint16_t ENGINE_FAST_FUNCTION(engine_pixel_shader_custom)(uint16_t bg, uint16_t fg, float opacity, engine_shader_t *shader){
-    uint8_t index = 0;
+    fg = engine_shader_run_stages(fg, shader);
+    return engine_shader_run_blend(bg, fg, opacity, shader->blend);
+}
 
-    while(index < shader->program_len){
-        switch(shader->program[index]){
-            case SHADER_OPACITY_BLEND:
-            {
-                fg = engine_color_alpha_blend(bg, fg, opacity);
-            }
-            break;
-            case SHADER_RGB_INTERPOLATE:
-            {
-                uint16_t interpolate_to_color = 0x0000;
-                interpolate_to_color |= (shader->program[index+1] << 8);
-                interpolate_to_color |= (shader->program[index+2] << 0);
 
-                float t = 0;
-                memcpy(&t, shader->program+index+3, sizeof(float));
+// Fused kernel for `SHADER_RGB_INTERPOLATE` then `SHADER_OPACITY_BLEND`
+uint16_t ENGINE_FAST_FUNCTION(engine_pixel_shader_tint)(uint16_t bg, uint16_t fg, float opacity, engine_shader_t *shader){
+    fg = engine_color_blend(fg, shader->stages[0].color, shader->stages[0].amount);
+    return engine_color_alpha_blend(bg, fg, opacity);
+}
 
-                fg = engine_color_blend(fg, interpolate_to_color, t);
 
-                index += 6; // OPPFFFF
-                continue;
-            }
-            break;
-        }
+// Fused kernel for `SHADER_RGB_INTERPOLATE` all the way (1.0) or `SHADER_FLASH`
+// then `SHADER_OPACITY_BLEND`: the source color no longer matters at all
+uint16_t ENGINE_FAST_FUNCTION(engine_pixel_shader_recolor)(uint16_t bg, uint16_t fg, float opacity, engine_shader_t *shader){
+    return engine_color_alpha_blend(bg, shader->stages[0].color, opacity);
+}
+
+
+void ENGINE_FAST_FUNCTION(engine_pixel_shader_empty_span)(uint16_t *dst, const uint16_t *src, uint32_t count, float opacity, engine_shader_t *shader){
+    memcpy(dst, src, count*sizeof(uint16_t));
+}
+
+
+void ENGINE_FAST_FUNCTION(engine_pixel_shader_empty_fill)(uint16_t *dst, uint16_t color, uint32_t count, float opacity, engine_shader_t *shader){
+    while(count--) *dst++ = color;
+}
+
+
+void ENGINE_FAST_FUNCTION(engine_pixel_shader_alpha_span)(uint16_t *dst, const uint16_t *src, uint32_t count, float opacity, engine_shader_t *shader){
+    engine_color_alpha_blend_span(dst, src, count, opacity);
+}
+
 
-        index++;
+void ENGINE_FAST_FUNCTION(engine_pixel_shader_alpha_fill)(uint16_t *dst, uint16_t color, uint32_t count, float opacity, engine_shader_t *shader){
+    engine_color_alpha_blend_fill(dst, color, count, opacity);
+}
+
+
+void ENGINE_FAST_FUNCTION(engine_pixel_shader_tint_span)(uint16_t *dst, const uint16_t *src, uint32_t count, float opacity, engine_shader_t *shader){
+    for(uint32_t i=0; i<count; i++){
+        dst[i] = engine_pixel_shader_tint(dst[i], src[i], opacity, shader);
     }
+}
 
-    return fg;
+
+// Same foreground for every pixel so only tint it once
+void ENGINE_FAST_FUNCTION(engine_pixel_shader_tint_fill)(uint16_t *dst, uint16_t color, uint32_t count, float opacity, engine_shader_t *shader){
+    color = engine_color_blend(color, shader->stages[0].color, shader->stages[0].amount);
+    engine_color_alpha_blend_fill(dst, color, count, opacity);
+}
+
+
+void ENGINE_FAST_FUNCTION(engine_pixel_shader_recolor_fill)(uint16_t *dst, uint16_t color, uint32_t count, float opacity, engine_shader_t *shader){
+    color = shader->stages[0].color;
+
+    // Blending at full opacity always gives back the foreground
+    if(opacity == 1.0f){
+        engine_pixel_shader_empty_fill(dst, color, count, opacity, shader);
+    }else{
+        engine_color_alpha_blend_fill(dst, color, count, opacity);
+    }
+}
+
+
+// Every source pixel becomes the same color so spans turn into fills
+void ENGINE_FAST_FUNCTION(engine_pixel_shader_recolor_span)(uint16_t *dst, const uint16_t *src, uint32_t count, float opacity, engine_shader_t *shader){
+    engine_pixel_shader_recolor_fill(dst, 0, count, opacity, shader);
+}
+
+
+// Fallbacks for programs without a fused kernel
+void ENGINE_FAST_FUNCTION(engine_pixel_shader_custom_span)(uint16_t *dst, const uint16_t *src, uint32_t count, float opacity, engine_shader_t *shader){
+    uint8_t blend = shader->blend;
+
+    if(blend == SHADER_DITHER_BLEND){
+        engine_shader_dither(dst, src, 0, count, opacity, shader);
+        return;
+    }
+
+    // Blending at full opacity always gives back the foreground
+    if(blend == SHADER_OPACITY_BLEND && opacity >= 1.0f){
+        blend = ENGINE_SHADER_NO_BLEND;
+    }
+
+    for(uint32_t i=0; i<count; i++){
+        dst[i] = engine_shader_run_blend(dst[i], engine_shader_run_stages(src[i], shader), opacity, blend);
+    }
+}
+
+
+void ENGINE_FAST_FUNCTION(engine_pixel_shader_custom_fill)(uint16_t *dst, uint16_t color, uint32_t count, float opacity, engine_shader_t *shader){
+    // None of the `fg` op codes depend on the background, so the
+    // program only has to run once for the whole span
+    color = engine_shader_run_stages(color, shader);
+
+    switch(shader->blend){
+        case SHADER_OPACITY_BLEND:
+            if(opacity >= 1.0f){
+                engine_pixel_shader_empty_fill(dst, color, count, opacity, shader);
+            }else{
+                engine_color_alpha_blend_fill(dst, color, count, opacity);
+            }
+        break;
+        case SHADER_ADDITIVE_BLEND:
+            for(uint32_t i=0; i<count; i++){
+                dst[i] = engine_color_additive_blend(dst[i], color, opacity);
+            }
+        break;
+        case SHADER_DITHER_BLEND:
+            engine_shader_dither(dst, NULL, color, count, opacity, shader);
+        break;
+        default:
+            engine_pixel_shader_empty_fill(dst, color, count, opacity, shader);
+        break;
+    }
 }
 
 
 // Fast shader that can be passed from node draw callback to drawing functions to quickly paste pixels to buffer
 engine_shader_t empty_shader = {
-    .program = {},
-    .program_len = 0,
+    .stages = {},
+    .stage_count = 0,
+    .blend = ENGINE_SHADER_NO_BLEND,
     .execute = engine_pixel_shader_empty,
+    .execute_span = engine_pixel_shader_empty_span,
+    .execute_fill = engine_pixel_shader_empty_fill,
 };
 
 
 // Fast shader that can be passed from node draw callback to drawing functions to quickly paste pixels to buffer with opacity blending
 engine_shader_t opacity_shader = {
-    .program = {},
-    .program_len = 0,
+    .stages = {},
+    .stage_count = 0,
+    .blend = SHADER_OPACITY_BLEND,
     .execute = engine_pixel_shader_alpha,
+    .execute_span = engine_pixel_shader_alpha_span,
+    .execute_fill = engine_pixel_shader_alpha_fill,
 };
 
-
-engine_shader_t blend_opacity_shader = {
-    .program = {SHADER_RGB_INTERPOLATE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, SHADER_OPACITY_BLEND},
-    .program_len = 8,
-    .execute = engine_pixel_shader_custom,
-};
-
-engine_shader_t *builtin_shaders[3] = {
+engine_shader_t *builtin_shaders[2] = {
     &empty_shader,
-    &opacity_shader,
-    &blend_opacity_shader
+    &opacity_shader
 };
 
 engine_shader_t *engine_get_builtin_shader(enum engine_builtin_shader_types type){
     return builtin_shaders[type];
-}
\ No newline at end of file
+}
+
+
+static void engine_shader_set_kernels(engine_shader_t *shader,
+                                      uint16_t (*execute)(uint16_t, uint16_t, float, engine_shader_t*),
+                                      void (*execute_span)(uint16_t*, const uint16_t*, uint32_t, float, engine_shader_t*),
+                                      void (*execute_fill)(uint16_t*, uint16_t, uint32_t, float, engine_shader_t*)){
+    shader->execute = execute;
+    shader->execute_span = execute_span;
+    shader->execute_fill = execute_fill;
+}
+
+
+bool engine_shader_compile(engine_shader_t *shader, const uint8_t *program, uint8_t program_len){
+    uint8_t stage_count = 0;
+    uint8_t blend = ENGINE_SHADER_NO_BLEND;
+    uint16_t index = 0;
+
+    // Decode every op code and its operands once
+    while(index < program_len){
+        uint8_t op = program[index];
+
+        // Blend op codes combine with the background so have to come last
+        if(op == SHADER_OPACITY_BLEND || op == SHADER_ADDITIVE_BLEND || op == SHADER_DITHER_BLEND){
+            if(index + 1 != program_len){
+                ENGINE_WARNING_PRINTF("Shader: Blend op code %d is not the last op code", op);
+                goto invalid;
+            }
+
+            blend = op;
+            index += 1;
+            continue;
+        }
+
+        if(stage_count == ENGINE_SHADER_MAX_STAGES){
+            ENGINE_WARNING_PRINTF("Shader: Too many op codes, max is %d", ENGINE_SHADER_MAX_STAGES);
+            goto invalid;
+        }
+
+        // Op code and operand bytes
+        uint8_t length = 0;
+
+        switch(op){
+            case SHADER_RGB_INTERPOLATE:    length = 7; break;  // OPPFFFF
+            case SHADER_MULTIPLY:           length = 3; break;  // OPP
+            case SHADER_BRIGHTNESS:         length = 5; break;  // OFFFF
+            case SHADER_PALETTE_REMAP:      length = 5; break;  // OPPPP
+            case SHADER_FLASH:              length = 3; break;  // OPP
+            default:
+                ENGINE_WARNING_PRINTF("Shader: Unknown op code %d", op);
+                goto invalid;
+        }
+
+        if(index + length > program_len){
+            ENGINE_WARNING_PRINTF("Shader: Op code %d is missing operand bytes", op);
+            goto invalid;
+        }
+
+        engine_shader_stage_t *stage = &shader->stages[stage_count];
+        stage->op = op;
+        stage->color = 0;
+        stage->to_color = 0;
+        stage->amount = 0.0f;
+
+        switch(op){
+            case SHADER_RGB_INTERPOLATE:
+                stage->color = (program[index+1] << 8) | (program[index+2] << 0);
+                memcpy(&stage->amount, program+index+3, sizeof(float));
+            break;
+            case SHADER_BRIGHTNESS:
+                memcpy(&stage->amount, program+index+1, sizeof(float));
+            break;
+            case SHADER_PALETTE_REMAP:
+                stage->color = (program[index+1] << 8) | (program[index+2] << 0);
+                stage->to_color = (program[index+3] << 8) | (program[index+4] << 0);
+            break;
+            default:    // SHADER_MULTIPLY and SHADER_FLASH
+                stage->color = (program[index+1] << 8) | (program[index+2] << 0);
+            break;
+        }
+
+        index += length;
+        stage_count++;
+    }
+
+    shader->stage_count = stage_count;
+    shader->blend = blend;
+
+    // Map common programs onto fused kernels, everything
+    // else runs through the generic stage loop
+    engine_shader_stage_t *stages = shader->stages;
+
+    if(stage_count == 0 && blend == ENGINE_SHADER_NO_BLEND){
+        engine_shader_set_kernels(shader, engine_pixel_shader_empty, engine_pixel_shader_empty_span, engine_pixel_shader_empty_fill);
+    }else if(stage_count == 0 && blend == SHADER_OPACITY_BLEND){
+        engine_shader_set_kernels(shader, engine_pixel_shader_alpha, engine_pixel_shader_alpha_span, engine_pixel_shader_alpha_fill);
+    }else if(stage_count == 1 && blend == SHADER_OPACITY_BLEND && (stages[0].op == SHADER_FLASH || (stages[0].op == SHADER_RGB_INTERPOLATE && stages[0].amount == 1.0f))){
+        engine_shader_set_kernels(shader, engine_pixel_shader_recolor, engine_pixel_shader_recolor_span, engine_pixel_shader_recolor_fill);
+    }else if(stage_count == 1 && blend == SHADER_OPACITY_BLEND && stages[0].op == SHADER_RGB_INTERPOLATE){
+        engine_shader_set_kernels(shader, engine_pixel_shader_tint, engine_pixel_shader_tint_span, engine_pixel_shader_tint_fill);
+    }else{
+        engine_shader_set_kernels(shader, engine_pixel_shader_custom, engine_pixel_shader_custom_span, engine_pixel_shader_custom_fill);
+    }
+
+    return true;
+
+    invalid:
+    shader->stage_count = 0;
+    shader->blend = ENGINE_SHADER_NO_BLEND;
+    engine_shader_set_kernels(shader, engine_pixel_shader_empty, engine_pixel_shader_empty_span, engine_pixel_shader_empty_fill);
+    return false;
+}
+
+
+void engine_shader_compile_tint(engine_shader_t *shader, uint16_t color, float amount){
+    // Nodes call this every draw, only recompile when the color changed
+    engine_shader_stage_t *stages = shader->stages;
+    if(shader->stage_count == 1 && shader->blend == SHADER_OPACITY_BLEND && stages[0].op == SHADER_RGB_INTERPOLATE && stages[0].color == color && stages[0].amount == amount){
+        return;
+    }
+
+    uint8_t program[8] = {SHADER_RGB_INTERPOLATE, (color >> 8) & 0b11111111, (color >> 0) & 0b11111111, 0, 0, 0, 0, SHADER_OPACITY_BLEND};
+    memcpy(program+3, &amount, sizeof(float));
+    engine_shader_compile(shader, program, 8);
+}
+
+
+mp_obj_t engine_shader_class_verify_opt(mp_obj_t shader){
+    if(shader != mp_const_none && !mp_obj_is_type(shader, &shader_class_type)){
+        mp_raise_TypeError(MP_ERROR_TEXT("Shader: ERROR: Expected Shader or None"));
+    }
+
+    return shader;
+}
+
+
+engine_shader_t *engine_shader_resolve(mp_obj_t shader, bool needs_blending){
+    if(shader != mp_const_none){
+        shader_class_obj_t *shader_obj = MP_OBJ_TO_PTR(shader);
+        return &shader_obj->shader;
+    }else if(needs_blending){
+        return engine_get_builtin_shader(OPACITY_SHADER);
+    }else{
+        return engine_get_builtin_shader(EMPTY_SHADER);
+    }
+}
+
+
+// Compiles the effects added so far plus the blend op into what nodes draw with
+static void shader_class_recompile(shader_class_obj_t *self){
+    uint8_t program[ENGINE_SHADER_MAX_PROGRAM_LEN+1];
+    memcpy(program, self->program, self->program_len);
+    program[self->program_len] = self->blend;
+
+    engine_shader_compile(&self->shader, program, self->program_len+1);
+
+    // Any number of nodes could be drawing with this shader
+    engine_display_damage_invalidate();
+    engine_draw_static_invalidate();
+}
+
+
+// Adds an op code and its operand bytes (at most 6) to the end of the program
+static mp_obj_t shader_class_add_op(mp_obj_t self_in, uint8_t op, const uint8_t *operands, uint8_t operands_len){
+    shader_class_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
+    if(self->stage_count == ENGINE_SHADER_MAX_STAGES){
+        mp_raise_ValueError(MP_ERROR_TEXT("Shader: ERROR: Too many effects, a Shader can have up to 8"));
+    }
+
+    self->program[self->program_len++] = op;
+    memcpy(self->program+self->program_len, operands, operands_len);
+    self->program_len += operands_len;
+    self->stage_count++;
+
+    shader_class_recompile(self);
+
+    // Return self so calls can be chained
+    return self_in;
+}
+
+
+static void shader_class_pack_color(uint8_t *bytes, mp_obj_t color){
+    uint16_t value = engine_color_class_color_value(color);
+    bytes[0] = (value >> 8) & 0b11111111;
+    bytes[1] = (value >> 0) & 0b11111111;
+}
+
+
+mp_obj_t shader_class_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args){
+    ENGINE_INFO_PRINTF("New Shader");
+    mp_arg_check_num(n_args, n_kw, 0, 0, false);
+
+    shader_class_obj_t *self = mp_obj_malloc(shader_class_obj_t, &shader_class_type);
+    self->program_len = 0;
+    self->stage_count = 0;
+    self->blend = SHADER_OPACITY_BLEND;
+    shader_class_recompile(self);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+
+/*  --- doc ---
+    NAME: tint
+    ID: shader_tint
+    DESC: Adds an effect that moves the color of every pixel `amount` of the way to `color`. Returns the Shader so calls can be chained
+    PARAM:  [type={ref_link:Color}|int]     [name=color]                    [value=Color or int (RGB565)]
+    PARAM:  [type=float]                    [name=amount]                   [value=0.0 ~ 1.0 (optional, defaults to 1.0)]
+    RETURN: {ref_link:Shader}
+*/
+static mp_obj_t shader_class_tint(size_t n_args, const mp_obj_t *args){
+    uint8_t operands[6];
+    shader_class_pack_color(operands, args[1]);
+
+    float amount = (n_args == 3) ? mp_obj_get_float(args[2]) : 1.0f;
+    memcpy(operands+2, &amount, sizeof(float));
+
+    return shader_class_add_op(args[0], SHADER_RGB_INTERPOLATE, operands, 6);
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(shader_class_tint_obj, 2, 3, shader_class_tint);
+
+
+/*  --- doc ---
+    NAME: multiply
+    ID: shader_multiply
+    DESC: Adds an effect that multiplies the channels of every pixel by the channels of `color` (white changes nothing). Returns the Shader so calls can be chained
+    PARAM:  [type={ref_link:Color}|int]     [name=color]                    [value=Color or int (RGB565)]
+    RETURN: {ref_link:Shader}
+*/
+static mp_obj_t shader_class_multiply(mp_obj_t self_in, mp_obj_t color){
+    uint8_t operands[2];
+    shader_class_pack_color(operands, color);
+    return shader_class_add_op(self_in, SHADER_MULTIPLY, operands, 2);
+}
+MP_DEFINE_CONST_FUN_OBJ_2(shader_class_multiply_obj, shader_class_multiply);
+
+
+/*  --- doc ---
+    NAME: brightness
+    ID: shader_brightness
+    DESC: Adds an effect that scales the channels of every pixel by `amount` (above 1.0 brightens, below darkens). Returns the Shader so calls can be chained
+    PARAM:  [type=float]                    [name=amount]                   [value=0.0 ~ any]
+    RETURN: {ref_link:Shader}
+*/
+static mp_obj_t shader_class_brightness(mp_obj_t self_in, mp_obj_t amount_obj){
+    uint8_t operands[4];
+    float amount = mp_obj_get_float(amount_obj);
+    memcpy(operands, &amount, sizeof(float));
+    return shader_class_add_op(self_in, SHADER_BRIGHTNESS, operands, 4);
+}
+MP_DEFINE_CONST_FUN_OBJ_2(shader_class_brightness_obj, shader_class_brightness);
+
+
+/*  --- doc ---
+    NAME: remap
+    ID: shader_remap
+    DESC: Adds an effect that swaps pixels of exactly `from_color` for `to_color` (palette swap). Effects run in the order they were added, so chain one remap per palette entry. Returns the Shader so calls can be chained
+    PARAM:  [type={ref_link:Color}|int]     [name=from_color]               [value=Color or int (RGB565)]
+    PARAM:  [type={ref_link:Color}|int]     [name=to_color]                 [value=Color or int (RGB565)]
+    RETURN: {ref_link:Shader}
+*/
+static mp_obj_t shader_class_remap(mp_obj_t self_in, mp_obj_t from_color, mp_obj_t to_color){
+    uint8_t operands[4];
+    shader_class_pack_color(operands, from_color);
+    shader_class_pack_color(operands+2, to_color);
+    return shader_class_add_op(self_in, SHADER_PALETTE_REMAP, operands, 4);
+}
+MP_DEFINE_CONST_FUN_OBJ_3(shader_class_remap_obj, shader_class_remap);
+
+
+/*  --- doc ---
+    NAME: flash
+    ID: shader_flash
+    DESC: Adds an effect that draws every pixel as `color` (for hit flashes and silhouettes). Returns the Shader so calls can be chained
+    PARAM:  [type={ref_link:Color}|int]     [name=color]                    [value=Color or int (RGB565)]
+    RETURN: {ref_link:Shader}
+*/
+static mp_obj_t shader_class_flash(mp_obj_t self_in, mp_obj_t color){
+    uint8_t operands[2];
+    shader_class_pack_color(operands, color);
+    return shader_class_add_op(self_in, SHADER_FLASH, operands, 2);
+}
+MP_DEFINE_CONST_FUN_OBJ_2(shader_class_flash_obj, shader_class_flash);
+
+
+static mp_obj_t shader_class_set_blend(mp_obj_t self_in, uint8_t blend){
+    shader_class_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    self->blend = blend;
+    shader_class_recompile(self);
+    return self_in;
+}
+
+
+/*  --- doc ---
+    NAME: additive
+    ID: shader_additive
+    DESC: Makes the node add its colors (scaled by its opacity) onto what is behind it instead of blending (for glows, fire and lights). Returns the Shader so calls can be chained
+    RETURN: {ref_link:Shader}
+*/
+static mp_obj_t shader_class_additive(mp_obj_t self_in){
+    return shader_class_set_blend(self_in, SHADER_ADDITIVE_BLEND);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(shader_class_additive_obj, shader_class_additive);
+
+
+/*  --- doc ---
+    NAME: dither
+    ID: shader_dither
+    DESC: Makes the node use its opacity to decide which pixels to draw in an ordered dither pattern instead of blending. This is cheaper than blending and gives a retro look to fades. Returns the Shader so calls can be chained
+    RETURN: {ref_link:Shader}
+*/
+static mp_obj_t shader_class_dither(mp_obj_t self_in){
+    return shader_class_set_blend(self_in, SHADER_DITHER_BLEND);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(shader_class_dither_obj, shader_class_dither);
+
+
+/*  --- doc ---
+    NAME: clear
+    ID: shader_clear
+    DESC: Removes all effects and goes back to normal opacity blending. Returns the Shader so calls can be chained
+    RETURN: {ref_link:Shader}
+*/
+static mp_obj_t shader_class_clear(mp_obj_t self_in){
+    shader_class_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    self->program_len = 0;
+    self->stage_count = 0;
+    return shader_class_set_blend(self_in, SHADER_OPACITY_BLEND);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(shader_class_clear_obj, shader_class_clear);
+
+
+static const mp_rom_map_elem_t shader_class_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_tint), MP_ROM_PTR(&shader_class_tint_obj) },
+    { MP_ROM_QSTR(MP_QSTR_multiply), MP_ROM_PTR(&shader_class_multiply_obj) },
+    { MP_ROM_QSTR(MP_QSTR_brightness), MP_ROM_PTR(&shader_class_brightness_obj) },
+    { MP_ROM_QSTR(MP_QSTR_remap), MP_ROM_PTR(&shader_class_remap_obj) },
+    { MP_ROM_QSTR(MP_QSTR_flash), MP_ROM_PTR(&shader_class_flash_obj) },
+    { MP_ROM_QSTR(MP_QSTR_additive), MP_ROM_PTR(&shader_class_additive_obj) },
+    { MP_ROM_QSTR(MP_QSTR_dither), MP_ROM_PTR(&shader_class_dither_obj) },
+    { MP_ROM_QSTR(MP_QSTR_clear), MP_ROM_PTR(&shader_class_clear_obj) },
+};
+static MP_DEFINE_CONST_DICT(shader_class_locals_dict, shader_class_locals_dict_table);
+
+
+/*  --- doc ---
+    NAME: Shader
+    ID: Shader
+    DESC: Per-pixel effects that can be assigned to the `shader` attribute of 2D nodes. Effects are added with the functions below, run in the order they were added and are compiled once when added, not every frame. The same Shader can be shared by many nodes, e.g. `engine_draw.Shader().flash(engine_draw.white)` for hit flashes
+    ATTR:   [type=function]         [name={ref_link:shader_tint}]           [value=function]
+    ATTR:   [type=function]         [name={ref_link:shader_multiply}]       [value=function]
+    ATTR:   [type=function]         [name={ref_link:shader_brightness}]     [value=function]
+    ATTR:   [type=function]         [name={ref_link:shader_remap}]          [value=function]
+    ATTR:   [type=function]         [name={ref_link:shader_flash}]          [value=function]
+    ATTR:   [type=function]         [name={ref_link:shader_additive}]       [value=function]
+    ATTR:   [type=function]         [name={ref_link:shader_dither}]         [value=function]
+    ATTR:   [type=function]         [name={ref_link:shader_clear}]          [value=function]
+*/
+MP_DEFINE_CONST_OBJ_TYPE(
+    shader_class_type,
+    MP_QSTR_Shader,
+    MP_TYPE_FLAG_NONE,
+
+    make_new, shader_class_new,
+    locals_dict, &shader_class_locals_dict
+);
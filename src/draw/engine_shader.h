@@ -1,28 +1,90 @@
 #ifndef ENGINE_SHADER_H
 #define ENGINE_SHADER_H
 
+#include "py/obj.h"
 #include <stdint.h>
+#include <stdbool.h>
 #include "utility/engine_defines.h"
 
+#define ENGINE_SHADER_MAX_STAGES 8
+#define ENGINE_SHADER_MAX_PROGRAM_LEN 64    // Enough for `ENGINE_SHADER_MAX_STAGES` of the longest op plus a blend op
+#define ENGINE_SHADER_NO_BLEND 0xFF         // `engine_shader_t.blend` when the program doesn't end with a blend op
+
+// Every op code works on the `fg` color except the blend op codes which
+// combine `fg` with `bg` and are only allowed as the last op in a program
 enum engine_shader_op_codes{
     SHADER_OPACITY_BLEND,    // blend the next two `bg` bytes to the subsequent `fg` bytes
     SHADER_RGB_INTERPOLATE,  // Interpolate `fg` to the color stored in the next two bytes using the 4 bytes after as the bytes containing a float from 0.0 to 1.0
+    SHADER_MULTIPLY,         // Multiply each channel of `fg` by the channels of the color stored in the next two bytes (tint)
+    SHADER_BRIGHTNESS,       // Scale each channel of `fg` by the float stored in the next 4 bytes
+    SHADER_PALETTE_REMAP,    // Replace `fg` with the color in bytes 3 and 4 when it is the color in the next two bytes
+    SHADER_FLASH,            // Replace `fg` with the color stored in the next two bytes
+    SHADER_ADDITIVE_BLEND,   // Add `fg` scaled by opacity to `bg` (blend op)
+    SHADER_DITHER_BLEND,     // Write `fg` to an ordered 4x4 dither pattern covering opacity of the pixels (blend op)
 };
 
 enum engine_builtin_shader_types{
     EMPTY_SHADER=0,
-    OPACITY_SHADER=1,
-    BLEND_OPACITY_SHADER=2
+    OPACITY_SHADER=1
 };
 
+// A single op code from a shader program with its operands already
+// decoded so that kernels never parse program bytes per-pixel
+typedef struct{
+    uint8_t op;         // One of `engine_shader_op_codes`
+    uint16_t color;     // Color operand
+    uint16_t to_color;  // Second color operand (`SHADER_PALETTE_REMAP`)
+    float amount;       // Float operand
+}engine_shader_stage_t;
+
+// A compiled shader program. Built once by `engine_shader_compile` when the
+// program is created or changes (not per-draw) and owned by whatever node
+// uses it so that nodes with different programs never share state
 typedef struct engine_shader_t{
-    uint8_t program[UINT8_MAX];                                                                      // Shader program consisting of op codes from `engine_shader_op_codes` (256 max codes allowed)
-    uint8_t program_len;                                                                             // Length of `program` in bytes
-    uint16_t (*execute)(uint16_t bg, uint16_t fg, float opacity, struct engine_shader_t *shader);    // Function to execute the bytes/op codes in `program` (sometimes switched out for speed if some effects are not used)
+    engine_shader_stage_t stages[ENGINE_SHADER_MAX_STAGES];                                          // Pre-decoded `fg` op codes from `engine_shader_op_codes`
+    uint8_t stage_count;                                                                             // Number of used entries in `stages`
+    uint8_t blend;                                                                                   // Blend op code the program ends with or `ENGINE_SHADER_NO_BLEND`
+    uint16_t (*execute)(uint16_t bg, uint16_t fg, float opacity, struct engine_shader_t *shader);    // Function to execute `stages` (switched to a fused kernel for common programs)
+
+    // Same as `execute` but for `count` pixels in a row of the screen buffer: `dst[i]` is the
+    // background and gets the result. `execute_span` takes a foreground per pixel from `src`,
+    // `execute_fill` uses the same foreground `color` for every pixel. Rasterizers call these
+    // once per horizontal span and only fall back to `execute` for single pixels
+    void (*execute_span)(uint16_t *dst, const uint16_t *src, uint32_t count, float opacity, struct engine_shader_t *shader);
+    void (*execute_fill)(uint16_t *dst, uint16_t color, uint32_t count, float opacity, struct engine_shader_t *shader);
 }engine_shader_t;
 
+// Python `engine_draw.Shader` that games build and assign to nodes
+typedef struct{
+    mp_obj_base_t base;
+    uint8_t program[ENGINE_SHADER_MAX_PROGRAM_LEN];     // `fg` op codes and their operands, without the blend op
+    uint8_t program_len;
+    uint8_t stage_count;                                // Number of op codes in `program`
+    uint8_t blend;                                      // Blend op code appended to `program` when compiling
+    engine_shader_t shader;                             // `program` compiled, this is what nodes draw with
+}shader_class_obj_t;
+
+extern const mp_obj_type_t shader_class_type;
+
 
 engine_shader_t *engine_get_builtin_shader(enum engine_builtin_shader_types type);
 
+// Decodes `program` (op codes from `engine_shader_op_codes` followed by their
+// operand bytes) into `shader` and picks the fastest kernels for it. Returns
+// false and leaves `shader` as an empty shader if the program is invalid
+bool engine_shader_compile(engine_shader_t *shader, const uint8_t *program, uint8_t program_len);
+
+// Compiles the program used for colored text: interpolate every pixel
+// `amount` of the way to `color` and then opacity blend it. Does nothing if
+// `shader` is already compiled for `color` and `amount`
+void engine_shader_compile_tint(engine_shader_t *shader, uint16_t color, float amount);
+
+// Raises if `shader` is not None or a `Shader`, otherwise returns it
+mp_obj_t engine_shader_class_verify_opt(mp_obj_t shader);
+
+// Returns the compiled shader of the `Shader` assigned to a node or, if
+// None, the builtin opacity or empty shader depending on `needs_blending`
+engine_shader_t *engine_shader_resolve(mp_obj_t shader, bool needs_blending);
+
 
-#endif  // ENGINE_SHADER_H
\ No newline at end of file
+#endif  // ENGINE_SHADER_H
@@ -8,11 +8,13 @@
 #include "physics/engine_physics.h"
 #include "resources/engine_resource_manager.h"
 #include "engine_gui.h"
+#include "engine_idle.h"
 #include "utility/engine_time.h"
 #include "audio/engine_audio_module.h"
 #include "math/engine_math.h"
 #include "utility/engine_defines.h"
 #include "link/engine_link_module.h"
+#include "debug/engine_debug_profiler.h"
 
 #include "draw/engine_display_draw.h"
 
@@ -59,8 +61,16 @@
 bool is_engine_looping = false;
 bool fps_limit_disabled = true;
 float engine_fps_limit_period_ms = 1;  // limit disabled initially anyway
-uint32_t engine_fps_time_at_last_tick_ms = MILLIS_NULL;
-uint32_t engine_fps_time_at_before_last_tick_ms = MILLIS_NULL;
+
+// Times (from `micros()`) of the last two ticks. Every value `micros()`
+// returns is valid so track if they have been set separately
+uint32_t engine_fps_time_at_last_tick_us = 0;
+uint32_t engine_fps_time_at_before_last_tick_us = 0;
+uint8_t engine_fps_ticks_recorded = 0;
+
+// When the next tick should happen if the FPS limit is enabled. Advanced
+// by exactly one period each tick so that frame pacing doesn't drift
+uint32_t engine_fps_time_at_next_tick_us = 0;
 
 
 float engine_get_fps_limit_ms(){
@@ -133,16 +143,16 @@ MP_DEFINE_CONST_FUN_OBJ_0(engine_disable_fps_limit_obj, engine_disable_fps_limit
 */
 static mp_obj_t engine_get_running_fps(){
     ENGINE_INFO_PRINTF("Engine: Getting FPS");
-    if(engine_fps_time_at_before_last_tick_ms == MILLIS_NULL){
+    if(engine_fps_ticks_recorded < 2){
         return mp_obj_new_float(99999);
     }
-    float period = millis_diff(engine_fps_time_at_last_tick_ms, engine_fps_time_at_before_last_tick_ms) / 1000.0f;    // Seconds
-    float fps = 1.0f / period;
 
-    if(engine_math_compare_floats(fps, 0.0f) == true){
+    uint32_t period_us = micros_diff(engine_fps_time_at_last_tick_us, engine_fps_time_at_before_last_tick_us);
+
+    if(period_us == 0){
         return mp_obj_new_float(99999);
     }else{
-        return mp_obj_new_float(fps);
+        return mp_obj_new_float(1000000.0f / (float)period_us);
     }
 }
 MP_DEFINE_CONST_FUN_OBJ_0(engine_get_running_fps_obj, engine_get_running_fps);
@@ -220,11 +230,12 @@ MP_DEFINE_CONST_FUN_OBJ_0(engine_end_obj, engine_end);
 */
 static mp_obj_t engine_mp_time_to_next_tick(){
     int32_t time_to_next_tick;
-    if(fps_limit_disabled || engine_fps_time_at_last_tick_ms == MILLIS_NULL){
+    if(fps_limit_disabled || engine_fps_ticks_recorded == 0){
         time_to_next_tick = 0;
     }else{
-        int32_t dt_ms = millis_diff(millis(), engine_fps_time_at_last_tick_ms);
-        time_to_next_tick = (int32_t)(engine_fps_limit_period_ms + 0.5f) - dt_ms;
+        // Round to the nearest millisecond
+        int32_t time_to_next_tick_us = (int32_t)micros_diff(engine_fps_time_at_next_tick_us, micros());
+        time_to_next_tick = (time_to_next_tick_us + 500) / 1000;
         if(time_to_next_tick < 0){
             time_to_next_tick = 0;
         }
@@ -244,51 +255,101 @@ bool engine_tick(){
     // correctly, just replicating what happens in modutime.c
     MP_THREAD_GIL_EXIT();
 
-    uint32_t now = millis();
+    uint32_t now = micros();
     float dt_ms;
-    if(engine_fps_time_at_last_tick_ms == MILLIS_NULL){
+    bool tick_due;
+    if(engine_fps_ticks_recorded == 0){
         dt_ms = engine_fps_limit_period_ms;
+        tick_due = true;
     }else{
-        dt_ms = (float)millis_diff(now, engine_fps_time_at_last_tick_ms);
+        dt_ms = (float)micros_diff(now, engine_fps_time_at_last_tick_us) * 0.001f;
+        tick_due = (int32_t)micros_diff(now, engine_fps_time_at_next_tick_us) >= 0;
     }
 
+    // Headless runs are deterministic, every tick is a frame of fixed length
+    bool fixed_dt = false;
+    #if defined(__unix__)
+        if(engine_headless){
+            dt_ms = engine_headless_dt_ms;
+            fixed_dt = true;
+        }
+    #endif
+
+    // Callbacks from here on can remove nodes from lists that are being
+    // looped over, keep removed list nodes from being reused until done
+    linked_list_pool_hold();
+
     // Now that all the node callbacks were called and potentially moved
     // physics nodes around, step the physics engine another tick.
+    ENGINE_PROFILER_PHASE_START();
     engine_physics_tick();
+    ENGINE_PROFILER_PHASE_END(ENGINE_PROFILER_PHASE_PHYSICS);
+
+    if(fixed_dt || fps_limit_disabled || tick_due){
+        engine_fps_time_at_before_last_tick_us = engine_fps_time_at_last_tick_us;
+        engine_fps_time_at_last_tick_us = now;
+
+        // Schedule the next tick one period after when this one should have
+        // happened. If more than a period behind (slow frame or the limit
+        // was just enabled), schedule from now instead of trying to catch up
+        uint32_t period_us = (uint32_t)(engine_fps_limit_period_ms * 1000.0f);
+        engine_fps_time_at_next_tick_us += period_us;
+        if(engine_fps_ticks_recorded == 0 || (int32_t)micros_diff(now, engine_fps_time_at_next_tick_us) >= 0){
+            engine_fps_time_at_next_tick_us = now + period_us;
+        }
 
-    if(fps_limit_disabled || dt_ms >= engine_fps_limit_period_ms){
-        engine_fps_time_at_before_last_tick_ms = engine_fps_time_at_last_tick_ms;
-        engine_fps_time_at_last_tick_ms = now;
+        if(engine_fps_ticks_recorded < 2){
+            engine_fps_ticks_recorded++;
+        }
 
         ENGINE_PERFORMANCE_STOP(ENGINE_PERF_TIMER_1, "Loop time");
         ENGINE_PERFORMANCE_START(ENGINE_PERF_TIMER_1);
 
-        float dt_s = dt_ms * 0.001f;
+        // Every tick/animation callback this frame gets passed the same
+        // float objects instead of allocating one per node
+        mp_obj_t dt_ms_obj = mp_obj_new_float(dt_ms);
+        mp_obj_t dt_s_obj = mp_obj_new_float(dt_ms * 0.001f);
+
+        ENGINE_PROFILER_PHASE_START();
 
         // Update/grab which buttons are pressed before calling all node callbacks
         engine_io_tick();
+        ENGINE_PROFILER_PHASE_END(ENGINE_PROFILER_PHASE_IO);
 
         // Goes through all animation components.
         // Do this first in case a camera is being
         // tweened or anything like that
-        engine_animation_tick(dt_ms);
+        engine_animation_tick(dt_ms_obj);
+        ENGINE_PROFILER_PHASE_END(ENGINE_PROFILER_PHASE_ANIMATION);
 
         // Call every instanced node's callbacks
-        engine_invoke_all_node_tick_callbacks(dt_s);
+        engine_invoke_all_node_tick_callbacks(dt_s_obj);
+        ENGINE_PROFILER_PHASE_END(ENGINE_PROFILER_PHASE_NODE_TICK);
+
         engine_objects_clear_deletable();                       // Remove any nodes marked for deletion before rendering
+        ENGINE_PROFILER_PHASE_END(ENGINE_PROFILER_PHASE_DELETE);
+
         engine_invoke_all_node_draw_callbacks();
+        ENGINE_PROFILER_PHASE_END(ENGINE_PROFILER_PHASE_NODE_DRAW);
 
         engine_gui_tick();
+        ENGINE_PROFILER_PHASE_END(ENGINE_PROFILER_PHASE_GUI);
 
         // After every game cycle send the current active screen buffer to the display
         engine_display_send();
+        ENGINE_PROFILER_PHASE_END(ENGINE_PROFILER_PHASE_DISPLAY_SEND);
 
         // Clear the depth buffer, if needed
         engine_display_clear_depth_buffer();
+        ENGINE_PROFILER_PHASE_END(ENGINE_PROFILER_PHASE_DEPTH_CLEAR);
+
+        ENGINE_PROFILER_FRAME_END();
 
         ticked = true;
     }
 
+    linked_list_pool_release();
+
     // Not sure why this is needed exactly for handling ctrl-c
     // correctly, just replicating what happens in modutime.c
     MP_THREAD_GIL_ENTER();
@@ -310,11 +371,17 @@ bool engine_tick(){
 /* --- doc ---
    NAME: dt
    ID: engine_dt
-   DESC: Returns the time, in seconds, since the last {ref_link:engine_tick}
-   RETURN: True or False
+   DESC: Returns the time, in seconds (microsecond resolution), since the last {ref_link:engine_tick}
+   RETURN: float
 */
 static mp_obj_t engine_mp_dt(){
-    return mp_obj_new_float(millis_diff(millis(), engine_fps_time_at_last_tick_ms) * 0.001f);
+    #if defined(__unix__)
+        if(engine_headless){
+            return mp_obj_new_float(engine_headless_dt_ms * 0.001f);
+        }
+    #endif
+
+    return mp_obj_new_float((float)micros_diff(micros(), engine_fps_time_at_last_tick_us) * 0.000001f);
 }
 MP_DEFINE_CONST_FUN_OBJ_0(engine_mp_dt_obj, engine_mp_dt);
 
@@ -343,7 +410,15 @@ static mp_obj_t engine_start(){
     is_engine_looping = true;
     while(is_engine_looping){
 
-        engine_tick();
+        // Once per frame, give the time left before the next frame
+        // to idle work instead of only spinning until then
+        if(engine_tick() && !fps_limit_disabled){
+            int32_t time_to_next_tick_us = (int32_t)micros_diff(engine_fps_time_at_next_tick_us, micros());
+
+            if(time_to_next_tick_us > 0){
+                engine_idle_run(time_to_next_tick_us);
+            }
+        }
         // // See ports/rp2/mphalport.h, ports/rp2/mphalport.c, py/mphal.h, shared/runtime/sys_stdio_mphal.c
         // // Can get chars from REPL and do stuff with them!
         // if(mp_hal_stdio_poll(MP_STREAM_POLL_RD)){
@@ -438,6 +513,102 @@ static mp_obj_t engine_setting_brightness(size_t n_args, const mp_obj_t *args){
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(engine_setting_brightness_obj, 0, 2, engine_setting_brightness);
 
 
+/* --- doc ---
+   NAME: layer_count
+   ID: engine_layer_count
+   DESC: Gets or sets how many layers nodes can be placed in (nodes can use layers 0 ~ count-1). Fewer layers use less memory (only a few bytes each). Can only be set before any nodes are created (or after they are all deleted). Resets to 128 on engine reset
+   PARAM: [type=int (optional)] [name=count] [value=1 ~ 256]
+   RETURN: None or int
+*/
+static mp_obj_t engine_layer_count(size_t n_args, const mp_obj_t *args){
+    if(n_args == 0){
+        return mp_obj_new_int(engine_objects_get_layer_count());
+    }
+
+    engine_objects_set_layer_count(mp_obj_get_int(args[0]));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(engine_layer_count_obj, 0, 1, engine_layer_count);
+
+
+/* --- doc ---
+   NAME: layer_offscreen
+   ID: engine_layer_offscreen
+   DESC: Gets or sets if the nodes in a layer are only drawn into textures by {ref_link:render} and not to the screen. Use it for layers that get rendered into a texture once and then shown by a sprite. Cameras in such a layer don't draw anything to the screen either, use them for rendering. Resets to False for every layer on engine reset
+   PARAM: [type=int] [name=layer] [value=0 ~ layer_count-1]
+   PARAM: [type=bool (optional)] [name=offscreen] [value=True or False]
+   RETURN: None or bool
+*/
+static mp_obj_t engine_layer_offscreen(size_t n_args, const mp_obj_t *args){
+    mp_int_t layer = mp_obj_get_int(args[0]);
+
+    if(layer < 0 || layer >= engine_objects_get_layer_count()){
+        mp_raise_msg_varg(&mp_type_ValueError, MP_ERROR_TEXT("Layer must be between 0 and %d"), engine_objects_get_layer_count()-1);
+    }
+
+    if(n_args == 1){
+        return mp_obj_new_bool(engine_objects_is_layer_offscreen(layer));
+    }
+
+    engine_objects_set_layer_offscreen(layer, mp_obj_is_true(args[1]));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(engine_layer_offscreen_obj, 1, 2, engine_layer_offscreen);
+
+
+/* --- doc ---
+   NAME: layer_static
+   ID: engine_layer_static
+   DESC: Gets or sets if the nodes in a layer never change. When the lowest layers with nodes in them (not counting {ref_link:engine_layer_offscreen} layers) are all static and only one camera draws to the screen, they are drawn once together with the background and every frame starts from that image instead of drawing them again. Moving the camera by whole pixels only draws the newly uncovered edges (unless the background is a texture). Adding, removing or setting an attribute of a node in a static layer draws them all again, but changing a vector in place (`node.position.x += 1`) is not noticed, call {ref_link:invalidate} after doing that. Nodes in static layers should not be children of the camera or of nodes in other layers. Resets to False for every layer on engine reset
+   PARAM: [type=int] [name=layer] [value=0 ~ layer_count-1]
+   PARAM: [type=bool (optional)] [name=static] [value=True or False]
+   RETURN: None or bool
+*/
+static mp_obj_t engine_layer_static(size_t n_args, const mp_obj_t *args){
+    mp_int_t layer = mp_obj_get_int(args[0]);
+
+    if(layer < 0 || layer >= engine_objects_get_layer_count()){
+        mp_raise_msg_varg(&mp_type_ValueError, MP_ERROR_TEXT("Layer must be between 0 and %d"), engine_objects_get_layer_count()-1);
+    }
+
+    if(n_args == 1){
+        return mp_obj_new_bool(engine_objects_is_layer_static(layer));
+    }
+
+    engine_objects_set_layer_static(layer, mp_obj_is_true(args[1]));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(engine_layer_static_obj, 1, 2, engine_layer_static);
+
+
+/* --- doc ---
+   NAME: add_idle_callback
+   ID: engine_add_idle_callback
+   DESC: Adds a function that is called with the time, in seconds, left before the next frame when the FPS limit is enabled and {ref_link:engine_start} is used. Use it for low priority work, keeping under the time passed. Callbacks that don't fit in the remaining time are skipped until the next frame. Garbage is also collected in this time when there is enough of it
+   PARAM: [type=function] [name=callback] [value=function that accepts one float]
+   RETURN: None
+*/
+static mp_obj_t engine_add_idle_callback(mp_obj_t callback){
+    engine_idle_add_callback(callback);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(engine_add_idle_callback_obj, engine_add_idle_callback);
+
+
+/* --- doc ---
+   NAME: remove_idle_callback
+   ID: engine_remove_idle_callback
+   DESC: Removes a function added with {ref_link:engine_add_idle_callback}
+   PARAM: [type=function] [name=callback] [value=function]
+   RETURN: None
+*/
+static mp_obj_t engine_remove_idle_callback(mp_obj_t callback){
+    engine_idle_remove_callback(callback);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(engine_remove_idle_callback_obj, engine_remove_idle_callback);
+
+
 static mp_obj_t engine_root_dir(){
     return mp_obj_new_str(filesystem_root, strlen(filesystem_root));
 }
@@ -467,6 +638,11 @@ MP_DEFINE_CONST_FUN_OBJ_0(engine_module_init_obj, engine_module_init);
    ATTR: [type=function] [name={ref_link:engine_freq}]                      [value=function]
    ATTR: [type=function] [name={ref_link:engine_setting_volume}]            [value=function]
    ATTR: [type=function] [name={ref_link:engine_setting_brightness}]        [value=function]
+   ATTR: [type=function] [name={ref_link:engine_layer_count}]               [value=getter/setter function]
+   ATTR: [type=function] [name={ref_link:engine_layer_offscreen}]           [value=getter/setter function]
+   ATTR: [type=function] [name={ref_link:engine_layer_static}]              [value=getter/setter function]
+   ATTR: [type=function] [name={ref_link:engine_add_idle_callback}]         [value=function]
+   ATTR: [type=function] [name={ref_link:engine_remove_idle_callback}]      [value=function]
 */
 static const mp_rom_map_elem_t engine_globals_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR___name__), MP_OBJ_NEW_QSTR(MP_QSTR_engine) },
@@ -484,6 +660,11 @@ static const mp_rom_map_elem_t engine_globals_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_setting_volume), (mp_obj_t)&engine_setting_volume_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_setting_brightness), (mp_obj_t)&engine_setting_brightness_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_root_dir), (mp_obj_t)&engine_root_dir_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_layer_count), (mp_obj_t)&engine_layer_count_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_layer_offscreen), (mp_obj_t)&engine_layer_offscreen_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_layer_static), (mp_obj_t)&engine_layer_static_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_add_idle_callback), (mp_obj_t)&engine_add_idle_callback_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_remove_idle_callback), (mp_obj_t)&engine_remove_idle_callback_obj },
 };
 
 // Module init
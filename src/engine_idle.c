@@ -0,0 +1,135 @@
+#include "engine_idle.h"
+#include "utility/engine_time.h"
+#include "debug/debug_print.h"
+
+#include "py/runtime.h"
+#include "py/gc.h"
+#include "py/mpstate.h"
+
+
+// List of Python functions called with the remaining idle budget in seconds
+MP_REGISTER_ROOT_POINTER(mp_obj_t engine_idle_callbacks);
+
+// How long the last idle garbage collection took (lowered
+// again while collections are skipped for not fitting)
+uint32_t engine_idle_gc_estimate_us = ENGINE_IDLE_GC_INITIAL_ESTIMATE_US;
+
+#if !MICROPY_GC_ALLOC_THRESHOLD
+    // Heap bytes in use right after the last collection. Without the
+    // allocation counter, growth past this is what was allocated since
+    size_t engine_idle_gc_used_after_collect = 0;
+#endif
+
+
+void engine_idle_reset(){
+    MP_STATE_VM(engine_idle_callbacks) = MP_OBJ_NULL;
+}
+
+
+void engine_idle_add_callback(mp_obj_t callback){
+    if(MP_STATE_VM(engine_idle_callbacks) == MP_OBJ_NULL){
+        MP_STATE_VM(engine_idle_callbacks) = mp_obj_new_list(0, NULL);
+    }
+
+    mp_obj_list_append(MP_STATE_VM(engine_idle_callbacks), callback);
+}
+
+
+void engine_idle_remove_callback(mp_obj_t callback){
+    if(MP_STATE_VM(engine_idle_callbacks) == MP_OBJ_NULL){
+        mp_raise_ValueError(MP_ERROR_TEXT("Idle callback was never added"));
+    }
+
+    // Raises `ValueError` if not registered, like `list.remove()`
+    mp_call_function_1(mp_load_attr(MP_STATE_VM(engine_idle_callbacks), MP_QSTR_remove), callback);
+}
+
+
+static bool engine_idle_gc_needed(){
+    #if MICROPY_GC_ALLOC_THRESHOLD
+        // Counts blocks allocated since the last collection
+        return MP_STATE_MEM(gc_alloc_amount) * MICROPY_BYTES_PER_GC_BLOCK >= ENGINE_IDLE_GC_MIN_ALLOCATED_BYTES;
+    #else
+        gc_info_t info;
+        gc_info(&info);
+
+        // Some other collection freed more than the last idle one did
+        if(info.used < engine_idle_gc_used_after_collect){
+            engine_idle_gc_used_after_collect = info.used;
+        }
+
+        return info.used - engine_idle_gc_used_after_collect >= ENGINE_IDLE_GC_MIN_ALLOCATED_BYTES;
+    #endif
+}
+
+
+// Collecting in idle time means the collection the allocator
+// would eventually do in the middle of a frame happens less often
+static void engine_idle_gc(uint32_t start_us, uint32_t budget_us){
+    // Leave some margin since the last collection's time is only a guess
+    uint32_t estimate_us = engine_idle_gc_estimate_us + engine_idle_gc_estimate_us / 4;
+
+    if(!engine_idle_gc_needed()){
+        return;
+    }
+
+    if(micros_diff(micros(), start_us) + estimate_us > budget_us){
+        // One slow collection (like a full heap) shouldn't keep idle
+        // collections from ever fitting again, creep back towards the
+        // initial guess every time one had to be skipped
+        if(engine_idle_gc_estimate_us > ENGINE_IDLE_GC_INITIAL_ESTIMATE_US){
+            engine_idle_gc_estimate_us -= (engine_idle_gc_estimate_us - ENGINE_IDLE_GC_INITIAL_ESTIMATE_US) / 8 + 1;
+        }
+        return;
+    }
+
+    uint32_t gc_start_us = micros();
+    gc_collect();
+    engine_idle_gc_estimate_us = micros_diff(micros(), gc_start_us);
+
+    #if !MICROPY_GC_ALLOC_THRESHOLD
+        gc_info_t info;
+        gc_info(&info);
+        engine_idle_gc_used_after_collect = info.used;
+    #endif
+
+    ENGINE_INFO_PRINTF("Idle: collected garbage in %lu us", engine_idle_gc_estimate_us);
+}
+
+
+static void engine_idle_call_callbacks(uint32_t start_us, uint32_t budget_us){
+    mp_obj_t callbacks = MP_STATE_VM(engine_idle_callbacks);
+
+    if(callbacks == MP_OBJ_NULL){
+        return;
+    }
+
+    size_t callback_count = 0;
+    mp_obj_t *callback_items = NULL;
+    mp_obj_list_get(callbacks, &callback_count, &callback_items);
+
+    for(size_t icx=0; icx<callback_count; icx++){
+        uint32_t elapsed_us = micros_diff(micros(), start_us);
+
+        if(elapsed_us + ENGINE_IDLE_MIN_BUDGET_US > budget_us){
+            break;
+        }
+
+        mp_call_function_1(callback_items[icx], mp_obj_new_float((float)(budget_us - elapsed_us) * 0.000001f));
+
+        // Callbacks may have added/removed callbacks
+        mp_obj_list_get(callbacks, &callback_count, &callback_items);
+    }
+}
+
+
+void engine_idle_run(uint32_t budget_us){
+    if(budget_us < ENGINE_IDLE_MIN_BUDGET_US){
+        return;
+    }
+
+    uint32_t start_us = micros();
+
+    engine_idle_gc(start_us, budget_us);
+    engine_idle_call_callbacks(start_us, budget_us);
+}
@@ -0,0 +1,26 @@
+#ifndef ENGINE_IDLE_H
+#define ENGINE_IDLE_H
+
+#include <stdint.h>
+#include "py/obj.h"
+
+// Don't start idle work with less than this much time left before the next frame
+#define ENGINE_IDLE_MIN_BUDGET_US           500
+
+// Guess for how long a garbage collection takes before one has been timed
+#define ENGINE_IDLE_GC_INITIAL_ESTIMATE_US  4000
+
+// Only collect in idle time after at least this much was allocated since the last collection
+#define ENGINE_IDLE_GC_MIN_ALLOCATED_BYTES  2048
+
+// Clears the registered idle callbacks
+void engine_idle_reset();
+
+// Runs idle jobs (garbage collection, then user idle callbacks)
+// as long as they are expected to fit in `budget_us`
+void engine_idle_run(uint32_t budget_us);
+
+void engine_idle_add_callback(mp_obj_t callback);
+void engine_idle_remove_callback(mp_obj_t callback);
+
+#endif  // ENGINE_IDLE_H
@@ -17,9 +17,13 @@
 #include "time/engine_rtc.h"
 #include "display/engine_display.h"
 #include "display/engine_display_common.h"
+#include "display/engine_display_damage.h"
+#include "draw/engine_draw_deferred.h"
+#include "draw/engine_draw_static.h"
 #include "physics/engine_physics.h"
 #include "animation/engine_animation_module.h"
 #include "engine_gui.h"
+#include "engine_idle.h"
 #include "fault/engine_fault.h"
 #include "link/engine_link_module.h"
 #include "py/mpstate.h"
@@ -28,6 +32,7 @@
 
 #elif defined(__unix__)
     #include <dirent.h>
+    #include <stdlib.h>
 #elif defined(__arm__)
     #include "hardware/adc.h"
 #endif
@@ -39,6 +44,11 @@
 char filesystem_root[FILESYSTEM_ROOT_MAX_LEN];
 bool is_engine_initialized = false;
 
+#if defined(__unix__)
+    bool engine_headless = false;
+    float engine_headless_dt_ms = 1000.0f / 60.0f;
+#endif
+
 mp_obj_str_t settings_location = {
     .base.type = &mp_type_str,
     .hash = 0,
@@ -169,6 +179,10 @@ void engine_main_reset(){
 
     // Always reset screen background fills
     engine_display_reset_fills();
+
+    // and go back to sending full frames
+    engine_display_damage_set_enabled(false);
+    engine_draw_deferred_set_enabled(false);
     
     engine_link_module_reset();
 
@@ -176,8 +190,14 @@ void engine_main_reset(){
     engine_audio_reset();
     engine_resource_reset();
     engine_gui_reset();
+    engine_idle_reset();
 
     engine_objects_clear_all();
+    linked_list_pool_release();     // In case an exception stopped a tick that held it
+    engine_objects_set_layer_count(ENGINE_OBJECT_LAYER_COUNT_DEFAULT);
+    engine_objects_reset_layer_offscreen();
+    engine_objects_reset_layer_static();
+    engine_draw_static_reset();
 
     engine_display_free_depth_buffer();
 
@@ -204,6 +224,19 @@ static mp_obj_t engine_main_module_init(){
             if(getcwd(filesystem_root, sizeof(filesystem_root)) == NULL){
                 filesystem_root[0] = '\0';
             }
+
+            // Needs to be known before the display and IO are setup
+            char *headless = getenv("ENGINE_HEADLESS");
+            engine_headless = (headless != NULL && strcmp(headless, "1") == 0);
+
+            char *headless_dt_ms = getenv("ENGINE_HEADLESS_DT_MS");
+            if(headless_dt_ms != NULL && strtof(headless_dt_ms, NULL) > 0.0f){
+                engine_headless_dt_ms = strtof(headless_dt_ms, NULL);
+            }
+
+            if(engine_headless){
+                ENGINE_PRINTF("Headless, fixed dt: %0.3f ms\n", (double)engine_headless_dt_ms);
+            }
         #endif
 
         ENGINE_PRINTF("Filesystem root: %s\n", filesystem_root);
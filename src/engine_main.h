@@ -1,6 +1,8 @@
 #ifndef ENGINE_MAIN_H
 #define ENGINE_MAIN_H
 
+#include <stdbool.h>
+
 void engine_main_raise_if_not_initialized();
 void engine_main_reset();
 
@@ -13,6 +15,14 @@ void engine_main_reset();
 
 extern char filesystem_root[FILESYSTEM_ROOT_MAX_LEN];
 
+#if defined(__unix__)
+    // Set by running with the `ENGINE_HEADLESS=1` environment variable. No
+    // SDL window or input is used and every `engine.tick()` runs a frame
+    // with a fixed dt of `ENGINE_HEADLESS_DT_MS` (default 1000/60 ms)
+    extern bool engine_headless;
+    extern float engine_headless_dt_ms;
+#endif
+
 
 void engine_main_settings_write(float volume, float brightness);
 
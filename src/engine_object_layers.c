@@ -13,28 +13,126 @@
 #include "nodes/2D/gui_bitmap_button_2d_node.h"
 #include "nodes/2D/physics_rectangle_2d_node.h"
 #include "nodes/2D/physics_circle_2d_node.h"
+#include "nodes/physics_node_base.h"
 #include "nodes/node_types.h"
 #include "nodes/node_base.h"
 #include "engine_collections.h"
+#include "debug/engine_debug_node_profiler.h"
+#include "utility/engine_time.h"
+#include "display/engine_display_common.h"
+#include "display/engine_display_damage.h"
+#include "draw/engine_display_draw.h"
+#include "draw/engine_draw_deferred.h"
+#include "draw/engine_draw_static.h"
+#include "math/engine_math.h"
+#include "math/rectangle.h"
+
+#include "utility/bits.h"
 
 #include "py/gc.h"
+#include "py/nlr.h"
 
-uint16_t engine_object_layer_count = 128;
-linked_list engine_object_layers[128];
+#include <string.h>
+#include <stdlib.h>
+
+// Layers are allocated on first use (or when resized) so games that
+// only use a few layers don't pay for all of them
+uint16_t engine_object_layer_count = ENGINE_OBJECT_LAYER_COUNT_DEFAULT;
+linked_list *engine_object_layers = NULL;
+
+// One bit per layer, set when the layer has at least one node in it
+uint32_t engine_object_layers_occupied[ENGINE_OBJECT_LAYER_COUNT_MAX / 32] = {0};
+
+// One bit per layer, set when the layer is only drawn into textures
+uint32_t engine_object_layers_offscreen[ENGINE_OBJECT_LAYER_COUNT_MAX / 32] = {0};
+
+// One bit per layer, set when the nodes in the layer never change
+uint32_t engine_object_layers_static[ENGINE_OBJECT_LAYER_COUNT_MAX / 32] = {0};
+
+// Sorted indices of the layers that have at least one node in them
+uint8_t engine_active_layers[ENGINE_OBJECT_LAYER_COUNT_MAX];
+uint16_t engine_active_layer_count = 0;
+
+
+static void engine_objects_allocate_layers(){
+    engine_object_layers = malloc(sizeof(linked_list) * engine_object_layer_count);
+
+    if(engine_object_layers == NULL){
+        mp_raise_msg(&mp_type_MemoryError, MP_ERROR_TEXT("Could not allocate the node layers, try a smaller layer count"));
+    }
+
+    for(uint16_t ilx=0; ilx<engine_object_layer_count; ilx++){
+        linked_list_init(&engine_object_layers[ilx]);
+    }
+}
+
+
+// Called when a layer goes from empty to having one node
+static void engine_objects_activate_layer(uint8_t layer_index){
+    BIT_SET_TRUE(engine_object_layers_occupied[layer_index >> 5], (layer_index & 31));
+
+    // Keep the list sorted so that layers are still ticked/drawn in order
+    uint16_t insert_index = 0;
+    while(insert_index < engine_active_layer_count && engine_active_layers[insert_index] < layer_index){
+        insert_index++;
+    }
+
+    memmove(&engine_active_layers[insert_index+1], &engine_active_layers[insert_index], engine_active_layer_count - insert_index);
+    engine_active_layers[insert_index] = layer_index;
+    engine_active_layer_count++;
+}
+
+
+// Called when the last node in a layer is removed
+static void engine_objects_deactivate_layer(uint8_t layer_index){
+    BIT_SET_FALSE(engine_object_layers_occupied[layer_index >> 5], (layer_index & 31));
+
+    for(uint16_t ilx=0; ilx<engine_active_layer_count; ilx++){
+        if(engine_active_layers[ilx] == layer_index){
+            memmove(&engine_active_layers[ilx], &engine_active_layers[ilx+1], engine_active_layer_count - ilx - 1);
+            engine_active_layer_count--;
+            break;
+        }
+    }
+}
+
+
+// Returns the index of the next occupied layer after `layer_index`
+// (pass -1 to get the first) or -1 if there are no more. Uses the
+// bitmap instead of the compact list since tick callbacks can add
+// or remove nodes (and layers) while looping
+static int16_t engine_objects_next_active_layer(int16_t layer_index){
+    int16_t start = layer_index + 1;
+
+    for(int16_t word_index=start >> 5; word_index<(ENGINE_OBJECT_LAYER_COUNT_MAX / 32); word_index++){
+        uint32_t word = engine_object_layers_occupied[word_index];
+
+        // Mask off the layers at and before `layer_index` in the first word
+        if(word_index == (start >> 5)){
+            word &= (UINT32_MAX << (start & 31));
+        }
+
+        if(word != 0){
+            return (word_index << 5) + __builtin_ctz(word);
+        }
+    }
+
+    return -1;
+}
 
 
 void engine_objects_clear_all(){
     ENGINE_INFO_PRINTF("Untracking all nodes...");
-    for(uint8_t inx=0; inx<engine_object_layer_count; inx++){
 
-        while(engine_object_layers[inx].start != NULL){
-            engine_node_base_t *node_base = engine_object_layers[inx].start->object;
+    // Deleting the last node in a layer removes it from the active list
+    while(engine_active_layer_count > 0){
+        uint8_t inx = engine_active_layers[0];
+        engine_node_base_t *node_base = engine_object_layers[inx].start->object;
 
-            // m_del_obj does not call finalizer, call it ourselves then delete the mp object
-            mp_obj_t final = mp_load_attr(node_base, MP_QSTR___del__);
-            mp_call_function_0(final);
-            m_del_obj(mp_obj_get_type(node_base), node_base);
-        }
+        // m_del_obj does not call finalizer, call it ourselves then delete the mp object
+        mp_obj_t final = mp_load_attr(node_base, MP_QSTR___del__);
+        mp_call_function_0(final);
+        m_del_obj(mp_obj_get_type(node_base), node_base);
     }
 }
 
@@ -55,14 +153,102 @@ void engine_objects_clear_deletable(){
 
 uint16_t engine_get_total_object_count(){
     uint16_t count = 0;
-    for(uint8_t ilx=0; ilx<engine_object_layer_count; ilx++){
-        count += engine_object_layers[ilx].count;
+    for(uint16_t ilx=0; ilx<engine_active_layer_count; ilx++){
+        count += engine_object_layers[engine_active_layers[ilx]].count;
     }
 
     return count;
 }
 
 
+uint16_t engine_objects_get_layer_count(){
+    return engine_object_layer_count;
+}
+
+
+void engine_objects_set_layer_count(mp_int_t layer_count){
+    if(layer_count < 1 || layer_count > ENGINE_OBJECT_LAYER_COUNT_MAX){
+        mp_raise_msg_varg(&mp_type_ValueError, MP_ERROR_TEXT("Layer count must be between 1 and %d"), ENGINE_OBJECT_LAYER_COUNT_MAX);
+    }
+
+    // Nodes store the layer they are in, can't move them around
+    if(engine_active_layer_count > 0){
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("Can only change the layer count when no nodes exist"));
+    }
+
+    if(layer_count == engine_object_layer_count){
+        return;
+    }
+
+    free(engine_object_layers);
+    engine_object_layers = NULL;
+    engine_object_layer_count = (uint16_t)layer_count;
+}
+
+
+bool engine_objects_is_layer_offscreen(uint8_t layer_index){
+    return BIT_GET(engine_object_layers_offscreen[layer_index >> 5], (layer_index & 31));
+}
+
+
+void engine_objects_set_layer_offscreen(uint8_t layer_index, bool offscreen){
+    if(layer_index >= engine_object_layer_count){
+        mp_raise_msg_varg(&mp_type_ValueError, MP_ERROR_TEXT("Layer must be between 0 and %d"), engine_object_layer_count-1);
+    }
+
+    BIT_SET(engine_object_layers_offscreen[layer_index >> 5], (layer_index & 31), offscreen);
+
+    // The nodes in the layer appear or disappear from the screen
+    engine_display_damage_invalidate();
+    engine_draw_static_invalidate();
+}
+
+
+void engine_objects_reset_layer_offscreen(){
+    memset(engine_object_layers_offscreen, 0, sizeof(engine_object_layers_offscreen));
+}
+
+
+bool engine_objects_is_layer_static(uint8_t layer_index){
+    return BIT_GET(engine_object_layers_static[layer_index >> 5], (layer_index & 31));
+}
+
+
+void engine_objects_set_layer_static(uint8_t layer_index, bool is_static){
+    if(layer_index >= engine_object_layer_count){
+        mp_raise_msg_varg(&mp_type_ValueError, MP_ERROR_TEXT("Layer must be between 0 and %d"), engine_object_layer_count-1);
+    }
+
+    BIT_SET(engine_object_layers_static[layer_index >> 5], (layer_index & 31), is_static);
+    engine_draw_static_invalidate();
+}
+
+
+void engine_objects_reset_layer_static(){
+    memset(engine_object_layers_static, 0, sizeof(engine_object_layers_static));
+}
+
+
+int16_t engine_objects_get_last_static_layer(){
+    int16_t last_static_layer = -1;
+
+    for(int16_t ilx=engine_objects_next_active_layer(-1); ilx!=-1; ilx=engine_objects_next_active_layer(ilx)){
+        if(engine_objects_is_layer_offscreen(ilx)){
+            continue;
+        }
+
+        // Layers drawn every frame can't be under cached ones
+        if(engine_objects_is_layer_static(ilx) == false){
+            break;
+        }
+
+        last_static_layer = ilx;
+    }
+
+    return last_static_layer;
+}
+
+
 // Add an object to the pool of all nodes in 'engine_object_layers' at some layer
 linked_list_node *engine_add_object_to_layer(void *obj, uint8_t layer_index){
     if(layer_index >= engine_object_layer_count){
@@ -70,22 +256,94 @@ linked_list_node *engine_add_object_to_layer(void *obj, uint8_t layer_index){
         mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("Tried to add object to layer index that is out of bounds! Resize the object layer count!"));
     }
 
-    return linked_list_add_obj(&engine_object_layers[layer_index], obj);
+    if(engine_object_layers == NULL){
+        engine_objects_allocate_layers();
+    }
+
+    linked_list *layer = &engine_object_layers[layer_index];
+
+    if(layer->start == NULL){
+        engine_objects_activate_layer(layer_index);
+    }
+
+    if(engine_objects_is_layer_static(layer_index)){
+        engine_draw_static_invalidate();
+    }
+
+    return linked_list_add_obj(layer, obj);
 }
 
 
 void engine_remove_object_from_layer(linked_list_node *object_list_node, uint8_t layer_index){
-    linked_list_del_list_node(&engine_object_layers[layer_index], object_list_node);
+    linked_list *layer = &engine_object_layers[layer_index];
+
+    linked_list_del_list_node(layer, object_list_node);
+
+    if(layer->start == NULL){
+        engine_objects_deactivate_layer(layer_index);
+    }
+
+    if(engine_objects_is_layer_static(layer_index)){
+        engine_draw_static_invalidate();
+    }
+}
+
+
+// Per node type callbacks used when ticking and drawing all nodes. Each
+// node module provides its own `tick` (calls `tick()` and any other
+// per-frame callbacks) and `draw` (called once per camera, `NULL` if
+// the node type does not draw anything)
+typedef struct{
+    void (*tick)(engine_node_base_t *node_base, mp_obj_t dt_s_obj);
+    void (*draw)(mp_obj_t node_base, mp_obj_t camera_node);
+}engine_node_type_callbacks_t;
+
+
+static const engine_node_type_callbacks_t engine_node_type_callbacks[NODE_TYPE_COUNT] = {
+    [NODE_TYPE_EMPTY]                   = {empty_node_class_tick,               NULL},
+    [NODE_TYPE_CAMERA]                  = {camera_node_class_tick,              NULL},
+    [NODE_TYPE_VOXELSPACE]              = {voxelspace_node_class_tick,          voxelspace_node_class_draw},
+    [NODE_TYPE_VOXELSPACE_SPRITE]       = {voxelspace_sprite_node_class_tick,   voxelspace_sprite_node_class_draw},
+    [NODE_TYPE_MESH_3D]                 = {mesh_node_class_tick,                mesh_node_class_draw},
+    [NODE_TYPE_RECTANGLE_2D]            = {rectangle_2d_node_class_tick,        rectangle_2d_node_class_draw},
+    [NODE_TYPE_LINE_2D]                 = {line_2d_node_class_tick,             line_2d_node_class_draw},
+    [NODE_TYPE_CIRCLE_2D]               = {circle_2d_node_class_tick,           circle_2d_node_class_draw},
+    [NODE_TYPE_SPRITE_2D]               = {sprite_2d_node_class_tick,           sprite_2d_node_class_draw},
+    [NODE_TYPE_TEXT_2D]                 = {text_2d_node_class_tick,             text_2d_node_class_draw},
+    [NODE_TYPE_GUI_BUTTON_2D]           = {gui_button_2d_node_class_tick,       gui_button_2d_node_class_draw},
+    [NODE_TYPE_GUI_BITMAP_BUTTON_2D]    = {gui_bitmap_button_2d_node_class_tick,gui_bitmap_button_2d_node_class_draw},
+    [NODE_TYPE_PHYSICS_RECTANGLE_2D]    = {physics_node_base_class_tick,        physics_rectangle_2d_node_class_draw},
+    [NODE_TYPE_PHYSICS_CIRCLE_2D]       = {physics_node_base_class_tick,        physics_circle_2d_node_class_draw},
+};
+
+
+// Used for node types out of range of the table above (a type added
+// to 'node_types.h' but not to the table, or a corrupted node)
+static const engine_node_type_callbacks_t engine_node_type_no_callbacks = {NULL, NULL};
+
+
+// Entries can be NULL, check before calling them
+static inline const engine_node_type_callbacks_t *engine_node_type_get_callbacks(engine_node_base_t *node_base){
+    if(node_base->type >= NODE_TYPE_COUNT){
+        return &engine_node_type_no_callbacks;
+    }
+
+    return &engine_node_type_callbacks[node_base->type];
 }
 
 
 // Go through all nodes and call their tick callbacks depending on the
 // node type. For example, some nodes will only have a 'tick()'
-// dt_s - delta time in seconds
-void engine_invoke_all_node_tick_callbacks(float dt_s){
+// dt_s_obj - delta time in seconds, one float object shared by all nodes
+void engine_invoke_all_node_tick_callbacks(mp_obj_t dt_s_obj){
     linked_list_node *current_linked_list_node = NULL;
 
-    for(uint16_t ilx=0; ilx<engine_object_layer_count; ilx++){
+    if(DEBUG_NODE_PROFILER_ENABLED){
+        engine_node_profiler_window_check();
+    }
+
+    // Only visit layers that have nodes in them
+    for(int16_t ilx=engine_objects_next_active_layer(-1); ilx!=-1; ilx=engine_objects_next_active_layer(ilx)){
         ENGINE_INFO_PRINTF("Starting ticking nodes in layer %d/%d", ilx, engine_object_layer_count-1);
 
         current_linked_list_node = engine_object_layers[ilx].start;
@@ -93,251 +351,16 @@ void engine_invoke_all_node_tick_callbacks(float dt_s){
         while(current_linked_list_node != NULL){
             // Get the base node that every node is stored under
             engine_node_base_t *node_base = current_linked_list_node->object;
-
-            mp_obj_t exec[3];
-
-            switch(node_base->type){
-                case NODE_TYPE_EMPTY:
-                {
-                    engine_empty_node_class_obj_t *empty_node = node_base->node;
-                    if(empty_node->tick_cb != mp_const_none){
-                        exec[0] = empty_node->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                case NODE_TYPE_CAMERA:
-                {
-                    engine_camera_node_class_obj_t *camera_node = node_base->node;
-                    if(camera_node->tick_cb != mp_const_none){
-                        exec[0] = camera_node->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                case NODE_TYPE_VOXELSPACE:
-                {
-                    engine_voxelspace_node_class_obj_t *voxelspace_node= node_base->node;
-                    if(voxelspace_node->tick_cb != mp_const_none){
-                        exec[0] = voxelspace_node->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                case NODE_TYPE_VOXELSPACE_SPRITE:
-                {
-                    engine_voxelspace_sprite_node_class_obj_t *voxelspace_sprite_node= node_base->node;
-                    if(voxelspace_sprite_node->tick_cb != mp_const_none){
-                        exec[0] = voxelspace_sprite_node->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                case NODE_TYPE_MESH_3D:
-                {
-                    engine_mesh_node_class_obj_t *mesh_node = node_base->node;
-                    if(mesh_node->tick_cb != mp_const_none){
-                        exec[0] = mesh_node->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
+            void (*tick)(engine_node_base_t *node_base, mp_obj_t dt_s_obj) = engine_node_type_get_callbacks(node_base)->tick;
+
+            if(tick != NULL){
+                if(DEBUG_NODE_PROFILER_ENABLED){
+                    uint32_t start_us = micros();
+                    tick(node_base, dt_s_obj);
+                    engine_node_profiler_add_tick(node_base, micros_diff(micros(), start_us));
+                }else{
+                    tick(node_base, dt_s_obj);
                 }
-                break;
-                case NODE_TYPE_RECTANGLE_2D:
-                {
-                    engine_rectangle_2d_node_class_obj_t *rectangle_2d_node = node_base->node;
-                    if(rectangle_2d_node->tick_cb != mp_const_none){
-                        exec[0] = rectangle_2d_node->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                case NODE_TYPE_LINE_2D:
-                {
-                    engine_line_2d_node_class_obj_t *line_2d_node = node_base->node;
-                    if(line_2d_node->tick_cb != mp_const_none){
-                        exec[0] = line_2d_node->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                case NODE_TYPE_CIRCLE_2D:
-                {
-                    engine_circle_2d_node_class_obj_t *circle_2d_node = node_base->node;
-                    if(circle_2d_node->tick_cb != mp_const_none){
-                        exec[0] = circle_2d_node->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                case NODE_TYPE_SPRITE_2D:
-                {
-                    engine_sprite_2d_node_class_obj_t *sprite_2d_node = node_base->node;
-                    if(sprite_2d_node->tick_cb != mp_const_none){
-                        exec[0] = sprite_2d_node->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                case NODE_TYPE_TEXT_2D:
-                {
-                    engine_text_2d_node_class_obj_t *text_2d_node = node_base->node;
-                    if(text_2d_node->tick_cb != mp_const_none){
-                        exec[0] = text_2d_node->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                case NODE_TYPE_GUI_BUTTON_2D:
-                {
-                    engine_gui_button_2d_node_class_obj_t *button_2d_node = node_base->node;
-                    exec[1] = node_base->attr_accessor;
-
-                    if(button_2d_node->tick_cb != mp_const_none){
-                        exec[0] = button_2d_node->tick_cb;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-
-                    if(button_2d_node->on_focused_cb != mp_const_none && button_2d_node->focused == true){
-                        exec[0] = button_2d_node->on_focused_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
-
-                    if(button_2d_node->on_just_focused_cb != mp_const_none && button_2d_node->last_focused == false && button_2d_node->focused == true){
-                        exec[0] = button_2d_node->on_just_focused_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
-
-                    if(button_2d_node->on_just_unfocused_cb != mp_const_none && button_2d_node->last_focused == true && button_2d_node->focused == false){
-                        exec[0] = button_2d_node->on_just_unfocused_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
-
-                    if(button_2d_node->on_pressed_cb != mp_const_none && button_2d_node->pressed == true){
-                        exec[0] = button_2d_node->on_pressed_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
-
-                    if(button_2d_node->on_just_pressed_cb != mp_const_none && button_2d_node->last_pressed == false && button_2d_node->pressed == true){
-                        exec[0] = button_2d_node->on_just_pressed_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
-
-                    if(button_2d_node->on_just_released_cb != mp_const_none && button_2d_node->last_pressed == true && button_2d_node->pressed == false){
-                        exec[0] = button_2d_node->on_just_released_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
-
-                    // Save the state for tracking for callbacks
-                    button_2d_node->last_pressed = button_2d_node->pressed;
-                    button_2d_node->last_focused = button_2d_node->focused;
-
-                    // After drawing everything, set pressed back to false.
-                    // After this function is done looping through all the
-                    // node callbacks, the gui tick is done again and it
-                    // may be found that the button is still pressed but
-                    // set to false anyways
-                    button_2d_node->pressed = false;
-                }
-                break;
-                case NODE_TYPE_GUI_BITMAP_BUTTON_2D:
-                {
-                    engine_gui_bitmap_button_2d_node_class_obj_t *bitmap_button_2d_node = node_base->node;
-                    exec[1] = node_base->attr_accessor;
-
-                    if(bitmap_button_2d_node->tick_cb != mp_const_none){
-                        exec[0] = bitmap_button_2d_node->tick_cb;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-
-                    if(bitmap_button_2d_node->on_focused_cb != mp_const_none && bitmap_button_2d_node->focused == true){
-                        exec[0] = bitmap_button_2d_node->on_focused_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
-
-                    if(bitmap_button_2d_node->on_just_focused_cb != mp_const_none && bitmap_button_2d_node->last_focused == false && bitmap_button_2d_node->focused == true){
-                        exec[0] = bitmap_button_2d_node->on_just_focused_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
-
-                    if(bitmap_button_2d_node->on_just_unfocused_cb != mp_const_none && bitmap_button_2d_node->last_focused == true && bitmap_button_2d_node->focused == false){
-                        exec[0] = bitmap_button_2d_node->on_just_unfocused_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
-
-                    if(bitmap_button_2d_node->on_pressed_cb != mp_const_none && bitmap_button_2d_node->pressed == true){
-                        exec[0] = bitmap_button_2d_node->on_pressed_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
-
-                    if(bitmap_button_2d_node->on_just_pressed_cb != mp_const_none && bitmap_button_2d_node->last_pressed == false && bitmap_button_2d_node->pressed == true){
-                        exec[0] = bitmap_button_2d_node->on_just_pressed_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
-
-                    if(bitmap_button_2d_node->on_just_released_cb != mp_const_none && bitmap_button_2d_node->last_pressed == true && bitmap_button_2d_node->pressed == false){
-                        exec[0] = bitmap_button_2d_node->on_just_released_cb;
-                        mp_call_method_n_kw(0, 0, exec);
-                    }
-
-                    // Save the state for tracking for callbacks
-                    bitmap_button_2d_node->last_pressed = bitmap_button_2d_node->pressed;
-                    bitmap_button_2d_node->last_focused = bitmap_button_2d_node->focused;
-
-                    // After drawing everything, set pressed back to false.
-                    // After this function is done looping through all the
-                    // node callbacks, the gui tick is done again and it
-                    // may be found that the button is still pressed but
-                    // set to false anyways
-                    bitmap_button_2d_node->pressed = false;
-                }
-                break;
-                case NODE_TYPE_PHYSICS_RECTANGLE_2D:
-                {
-                    engine_physics_node_base_t *physics_node_base = node_base->node;
-                    if(physics_node_base->tick_cb != mp_const_none){
-                        exec[0] = physics_node_base->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                case NODE_TYPE_PHYSICS_CIRCLE_2D:
-                {
-                    engine_physics_node_base_t *physics_node_base = node_base->node;
-                    if(physics_node_base->tick_cb != mp_const_none){
-                        exec[0] = physics_node_base->tick_cb;
-                        exec[1] = node_base->attr_accessor;
-                        exec[2] = mp_obj_new_float(dt_s);
-                        mp_call_method_n_kw(1, 0, exec);
-                    }
-                }
-                break;
-                default:
-                    ENGINE_ERROR_PRINTF("This node type doesn't do anything? %d", node_base->type);
-                break;
             }
 
             current_linked_list_node = current_linked_list_node->next;
@@ -348,10 +371,19 @@ void engine_invoke_all_node_tick_callbacks(float dt_s){
 }
 
 
-void engine_invoke_all_node_draw_callbacks(){
+static void engine_draw_all_layers(){
     linked_list_node *current_linked_list_node = NULL;
 
-    for(uint16_t ilx=0; ilx<engine_object_layer_count; ilx++){
+    // Static layers are already in the frame if they're cached
+    int16_t ilx = engine_objects_next_active_layer(engine_draw_static_get_last_layer());
+
+    // Only visit layers that have nodes in them
+    for(; ilx!=-1; ilx=engine_objects_next_active_layer(ilx)){
+        // Only drawn into textures
+        if(engine_objects_is_layer_offscreen(ilx)){
+            continue;
+        }
+
         ENGINE_INFO_PRINTF("Starting drawing nodes in layer %d/%d", ilx, engine_object_layer_count-1);
 
         current_linked_list_node = engine_object_layers[ilx].start;
@@ -360,86 +392,274 @@ void engine_invoke_all_node_draw_callbacks(){
             // Get the base node that every node is stored under
             engine_node_base_t *node_base = current_linked_list_node->object;
 
-            switch(node_base->type){
-                case NODE_TYPE_EMPTY:
-                {
-                    // Nothing but don't want to get to default case and error
-                }
-                break;
-                case NODE_TYPE_CAMERA:
-                {
-                    // Nothing but don't want to get to default case and error
-                }
-                break;
-                case NODE_TYPE_VOXELSPACE:
-                {
-                    engine_camera_draw_for_each(voxelspace_node_class_draw, node_base);
-                }
-                break;
-                case NODE_TYPE_VOXELSPACE_SPRITE:
-                {
-                    engine_camera_draw_for_each(voxelspace_sprite_node_class_draw, node_base);
-                }
-                break;
-                case NODE_TYPE_MESH_3D:
-                {
-                    engine_camera_draw_for_each(mesh_node_class_draw, node_base);
-                }
-                break;
-                case NODE_TYPE_RECTANGLE_2D:
-                {
-                    engine_camera_draw_for_each(rectangle_2d_node_class_draw, node_base);
-                }
-                break;
-                case NODE_TYPE_LINE_2D:
-                {
-                    engine_camera_draw_for_each(line_2d_node_class_draw, node_base);
-                }
-                break;
-                case NODE_TYPE_CIRCLE_2D:
-                {
-                    engine_camera_draw_for_each(circle_2d_node_class_draw, node_base);
-                }
-                break;
-                case NODE_TYPE_SPRITE_2D:
-                {
-                    engine_camera_draw_for_each(sprite_2d_node_class_draw, node_base);
-                }
-                break;
-                case NODE_TYPE_TEXT_2D:
-                {
-                    engine_camera_draw_for_each(text_2d_node_class_draw, node_base);
-                }
-                break;
-                case NODE_TYPE_GUI_BUTTON_2D:
-                {
-                    engine_camera_draw_for_each(gui_button_2d_node_class_draw, node_base);
-                }
-                break;
-                case NODE_TYPE_GUI_BITMAP_BUTTON_2D:
-                {
-                    engine_camera_draw_for_each(gui_bitmap_button_2d_node_class_draw, node_base);
-                }
-                break;
-                case NODE_TYPE_PHYSICS_RECTANGLE_2D:
-                {
+            void (*draw)(mp_obj_t node_base, mp_obj_t camera_node) = engine_node_type_get_callbacks(node_base)->draw;
 
-                    engine_camera_draw_for_each(physics_rectangle_2d_node_class_draw, node_base);
-                }
-                break;
-                case NODE_TYPE_PHYSICS_CIRCLE_2D:
-                {
-                    engine_camera_draw_for_each(physics_circle_2d_node_class_draw, node_base);
+            // Empty and camera nodes have nothing to draw
+            if(draw != NULL){
+                if(DEBUG_NODE_PROFILER_ENABLED){
+                    uint32_t start_us = micros();
+                    engine_camera_draw_for_each(draw, node_base);
+                    engine_node_profiler_add_draw(node_base, micros_diff(micros(), start_us));
+                }else{
+                    engine_camera_draw_for_each(draw, node_base);
                 }
-                break;
-                default:
-                    ENGINE_ERROR_PRINTF("This node type doesn't do anything? %d", node_base->type);
-                break;
             }
 
             current_linked_list_node = current_linked_list_node->next;
         }
     }
+}
+
+
+// Node types whose draw callbacks report their bounds through
+// `engine_camera_2d_is_on_screen()` before drawing anything
+static bool engine_node_type_reports_bounds(engine_node_base_t *node_base){
+    switch(node_base->type){
+        case NODE_TYPE_RECTANGLE_2D:
+        case NODE_TYPE_LINE_2D:
+        case NODE_TYPE_CIRCLE_2D:
+        case NODE_TYPE_SPRITE_2D:
+        case NODE_TYPE_TEXT_2D:
+            return true;
+        case NODE_TYPE_PHYSICS_RECTANGLE_2D:
+        case NODE_TYPE_PHYSICS_CIRCLE_2D:
+        {
+            // Only draws anything when outlined
+            engine_physics_node_base_t *physics_node_base = node_base->node;
+            return mp_obj_get_int(physics_node_base->outline) == false;
+        }
+        default:
+            return false;
+    }
+}
+
+
+static bool engine_inheritable_2d_equal(engine_inheritable_2d_t *a, engine_inheritable_2d_t *b){
+    return a->px == b->px && a->py == b->py && a->rotation == b->rotation &&
+           a->sx == b->sx && a->sy == b->sy && a->opacity == b->opacity &&
+           a->is_camera_child == b->is_camera_child;
+}
+
+
+// Returns true if a camera drawing to the screen was added, removed,
+// moved, zoomed or faded since the last measured frame (everything it
+// draws moves). Each camera keeps where it put the world origin on
+// screen in its 'drawn_world_2d'
+static bool engine_measure_cameras_changed(){
+    static uint16_t last_camera_count = 0;
+    uint16_t camera_count = 0;
+    bool changed = false;
+
+    linked_list_node *current_camera_list_node = engine_collections_get_camera_list()->start;
+
+    while(current_camera_list_node != NULL){
+        engine_node_base_t *camera_node_base = current_camera_list_node->object;
+        engine_camera_node_class_obj_t *camera = camera_node_base->node;
+        current_camera_list_node = current_camera_list_node->next;
+
+        // Only used to render into textures
+        if(engine_objects_is_layer_offscreen(camera_node_base->layer)){
+            continue;
+        }
+
+        engine_inheritable_2d_t view = {0};
+        engine_camera_transform_2d(camera_node_base, &view.px, &view.py, &view.rotation);
+        view.px += camera->viewport->width/2;
+        view.py += camera->viewport->height/2;
+        view.sx = mp_obj_get_float(camera->zoom);
+        view.sy = view.sx;
+        view.opacity = mp_obj_get_float(camera->opacity);
+
+        if(camera_node_base->damaged || engine_inheritable_2d_equal(&view, &camera_node_base->drawn_world_2d) == false){
+            changed = true;
+        }
+
+        camera_node_base->drawn_world_2d = view;
+        camera_node_base->damaged = false;
+        camera_count++;
+    }
+
+    if(camera_count != last_camera_count){
+        changed = true;
+    }
+
+    last_camera_count = camera_count;
+    return changed;
+}
+
+
+// Runs the draw callbacks without drawing anything to find out which
+// nodes changed where on screen since the last measured frame. Nodes that
+// moved, resized, faded, had an attribute set, or went off screen damage
+// both where they were and where they are now. Only nodes that can have
+// changed are measured: anything else covers the same area as last frame
+// if the cameras didn't change either, so its callback is only run once
+// (if at all) in the real draw pass
+static void engine_measure_all_layers(){
+    linked_list_node *current_linked_list_node = NULL;
+
+    bool cameras_changed = engine_measure_cameras_changed();
+
+    engine_display_damage_begin_measure();
+
+    int16_t ilx = engine_objects_next_active_layer(engine_draw_static_get_last_layer());
+
+    for(; ilx!=-1; ilx=engine_objects_next_active_layer(ilx)){
+        if(engine_objects_is_layer_offscreen(ilx)){
+            continue;
+        }
+
+        current_linked_list_node = engine_object_layers[ilx].start;
+
+        while(current_linked_list_node != NULL){
+            engine_node_base_t *node_base = current_linked_list_node->object;
+            void (*draw)(mp_obj_t node_base, mp_obj_t camera_node) = engine_node_type_get_callbacks(node_base)->draw;
+
+            current_linked_list_node = current_linked_list_node->next;
+
+            if(draw == NULL){
+                continue;
+            }
+
+            // Don't know where these draw, have to redraw everything
+            // this frame and whenever they stop drawing or are removed
+            if(engine_node_type_reports_bounds(node_base) == false){
+                engine_display_damage_invalidate();
+                node_base->drawn_bounds = (engine_display_rect_t){0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
+                continue;
+            }
+
+            // Resolved once for both passes (see 'node_base_transform_cache_begin()')
+            engine_inheritable_2d_t world_2d;
+            node_base_inherit_2d(node_base, &world_2d);
+
+            if(cameras_changed == false && node_base->damaged == false && engine_inheritable_2d_equal(&world_2d, &node_base->drawn_world_2d)){
+                continue;
+            }
+
+            node_base->drawn_world_2d = world_2d;
+
+            engine_display_damage_begin_node();
+            engine_camera_draw_for_each(draw, node_base);
+            engine_display_rect_t bounds = engine_display_damage_end_node();
+
+            // Only valid if the node got far enough to report its bounds
+            float opacity = engine_display_rect_is_empty(bounds) ? 0.0f : node_base->world_2d.opacity;
+
+            if(node_base->damaged ||
+               engine_display_rect_equal(bounds, node_base->drawn_bounds) == false ||
+               engine_math_compare_floats(opacity, node_base->drawn_opacity) == false){
+                engine_display_damage_add(node_base->drawn_bounds);
+                engine_display_damage_add(bounds);
+            }
+
+            node_base->drawn_bounds = bounds;
+            node_base->drawn_opacity = opacity;
+            node_base->damaged = false;
+        }
+    }
+
+    engine_display_damage_end_measure();
+}
+
+
+void engine_invoke_all_node_draw_callbacks(){
+    // Draw the static layers into their cache if anything changed. The
+    // frame was cleared to the old cache, the whole frame has to be
+    // cleared again and redrawn
+    if(engine_draw_static_update()){
+        if(engine_display_damage_is_enabled()){
+            engine_display_damage_invalidate();
+        }else if(engine_display_fill_skippable() == false){
+            engine_display_fill_active_buffer();
+        }
+    }
+
+    // No Python code runs while drawing, so world transforms
+    // can be resolved once per node for the whole pass. Make
+    // sure the cache is turned off again if a node raises
+    // (e.g. a bad `position` type) so it never goes stale
+    node_base_transform_cache_begin();
+    engine_camera_reset_cull_stats();
+
+    nlr_buf_t nlr;
+    if(nlr_push(&nlr) == 0){
+        // Only clear and redraw what changed, the clear
+        // was left to this point by 'engine_display_send()'
+        if(engine_display_damage_is_enabled()){
+            engine_measure_all_layers();
+            engine_display_damage_clear_frame();
+        }
+
+        engine_draw_reset_covered();
+        engine_draw_deferred_begin();
+        engine_draw_all_layers();
+        engine_draw_deferred_end();
+
+        // The clear was skipped since the last frame was covered by
+        // something opaque but this one wasn't, clear and draw again
+        if(engine_display_take_fill_skipped() && engine_draw_is_covered() == false){
+            if(engine_display_damage_is_enabled()){
+                engine_display_damage_clear_frame();
+            }else{
+                engine_display_fill_active_buffer();
+            }
+
+            engine_camera_reset_cull_stats();
+            engine_draw_deferred_begin();
+            engine_draw_all_layers();
+            engine_draw_deferred_end();
+        }
+
+        nlr_pop();
+    }else{
+        node_base_transform_cache_end();
+        engine_display_damage_cancel();
+        engine_draw_deferred_cancel();
+        nlr_jump(nlr.ret_val);
+    }
+
+    node_base_transform_cache_end();
 
     ENGINE_INFO_PRINTF("##### GAME DRAWING COMPLETE #####\n");
-}
\ No newline at end of file
+}
+
+
+void engine_invoke_node_draw_callbacks_offscreen(uint16_t *buffer, int32_t width, int32_t height, engine_draw_clip_t *clip, mp_obj_t camera_node, uint8_t first_layer, uint8_t last_layer){
+    node_base_transform_cache_begin();
+    engine_draw_set_target(buffer, width, height);
+    engine_draw_set_clip(clip);
+
+    nlr_buf_t nlr;
+    if(nlr_push(&nlr) == 0){
+        // Only visit layers in the range that have nodes in them
+        for(int16_t ilx=engine_objects_next_active_layer(first_layer-1); ilx!=-1 && ilx<=last_layer; ilx=engine_objects_next_active_layer(ilx)){
+            linked_list_node *current_linked_list_node = engine_object_layers[ilx].start;
+
+            while(current_linked_list_node != NULL){
+                engine_node_base_t *node_base = current_linked_list_node->object;
+                void (*draw)(mp_obj_t node_base, mp_obj_t camera_node) = engine_node_type_get_callbacks(node_base)->draw;
+
+                if(draw != NULL){
+                    draw(node_base, camera_node);
+                }
+
+                current_linked_list_node = current_linked_list_node->next;
+            }
+        }
+
+        nlr_pop();
+    }else{
+        engine_draw_set_target(NULL, 0, 0);
+        node_base_transform_cache_end();
+        engine_display_clear_depth_buffer();
+        nlr_jump(nlr.ret_val);
+    }
+
+    engine_draw_set_target(NULL, 0, 0);
+    node_base_transform_cache_end();
+
+    // 3D nodes stored depths for the buffer, the next
+    // draw pass expects to start with a clear depth buffer
+    engine_display_clear_depth_buffer();
+}
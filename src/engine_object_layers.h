@@ -1,15 +1,55 @@
 #ifndef ENGINE_OBJECT_LAYERS_H
 #define ENGINE_OBJECT_LAYERS_H
 
+#include "py/obj.h"
 #include "utility/linked_list.h"
+#include "draw/engine_display_draw.h"
+
+// Layers are indexed by `uint8_t` and tracked in bitmaps of this size.
+// Only the lists of the layer count in use are allocated (on first use)
+// and empty layers are skipped through the bitmap, so a higher count
+// only costs a list head per layer
+#define ENGINE_OBJECT_LAYER_COUNT_MAX       256
+#define ENGINE_OBJECT_LAYER_COUNT_DEFAULT   128
 
 void engine_objects_clear_all();
 void engine_objects_clear_deletable();
 uint16_t engine_get_total_object_count();
+
+// Gets/sets how many layers nodes can be placed in. Setting
+// the count is only possible while there are no nodes
+uint16_t engine_objects_get_layer_count();
+void engine_objects_set_layer_count(mp_int_t layer_count);
+
+// Gets/sets if the nodes in a layer are only drawn into textures (see
+// 'engine_invoke_node_draw_callbacks_offscreen()') and not to the screen.
+// Cameras in these layers don't draw anything to the screen either
+bool engine_objects_is_layer_offscreen(uint8_t layer_index);
+void engine_objects_set_layer_offscreen(uint8_t layer_index, bool offscreen);
+void engine_objects_reset_layer_offscreen();
+
+// Gets/sets if the nodes in a layer never change so that they can be
+// drawn once into a cache (see 'draw/engine_draw_static.h'). Adding or
+// removing nodes in a static layer invalidates the cache
+bool engine_objects_is_layer_static(uint8_t layer_index);
+void engine_objects_set_layer_static(uint8_t layer_index, bool is_static);
+void engine_objects_reset_layer_static();
+
+// Returns the last layer of the run of static layers that starts at the
+// first occupied layer (skipping offscreen layers) or -1 if that layer
+// isn't static. These are the layers the static cache can hold
+int16_t engine_objects_get_last_static_layer();
+
 linked_list_node *engine_add_object_to_layer(void *obj, uint8_t layer_index);
 void engine_remove_object_from_layer(linked_list_node *object_list_node, uint8_t layer_index);
 
-void engine_invoke_all_node_tick_callbacks(float dt);
+void engine_invoke_all_node_tick_callbacks(mp_obj_t dt_s_obj);
 void engine_invoke_all_node_draw_callbacks();
 
+// Draws the nodes in layers 'first_layer' through 'last_layer' as seen by
+// only 'camera_node' into the 'width' by 'height' RGB565 'buffer' instead of
+// the screen (see 'engine_draw_set_target()'). Only the part of the buffer
+// inside 'clip' is drawn to unless it is NULL
+void engine_invoke_node_draw_callbacks_offscreen(uint16_t *buffer, int32_t width, int32_t height, engine_draw_clip_t *clip, mp_obj_t camera_node, uint8_t first_layer, uint8_t last_layer);
+
 #endif  // ENGINE_OBJECT_LAYERS_H
\ No newline at end of file
@@ -13,6 +13,7 @@
     });
 #elif defined(__unix__)
     #include "engine_io_sdl.h"
+    #include "engine_main.h"
 #elif defined(__arm__)
     #include "engine_io_rp3.h"
     #include "hardware/adc.h"
@@ -77,7 +78,9 @@ void buttons_update_state() {
     #if defined(__EMSCRIPTEN__)
         pressed_buttons = engine_io_web_pressed_buttons();
     #elif defined(__unix__)
-        pressed_buttons = engine_io_sdl_pressed_buttons();
+        if(!engine_headless){
+            pressed_buttons = engine_io_sdl_pressed_buttons();
+        }
     #elif defined(__arm__)
         pressed_buttons = engine_io_rp3_pressed_buttons();
     #endif
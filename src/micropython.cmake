@@ -44,6 +44,8 @@ target_sources(usermod_engine INTERFACE
     ${ENGINE_MOD_DIR}/math/rectangle.c
     ${ENGINE_MOD_DIR}/debug/engine_debug_module.c
     ${ENGINE_MOD_DIR}/debug/debug_print.c
+    ${ENGINE_MOD_DIR}/debug/engine_debug_profiler.c
+    ${ENGINE_MOD_DIR}/debug/engine_debug_node_profiler.c
     ${ENGINE_MOD_DIR}/utility/linked_list.c
     ${ENGINE_MOD_DIR}/utility/engine_time.c
     ${ENGINE_MOD_DIR}/utility/engine_file.c
@@ -51,11 +53,15 @@ target_sources(usermod_engine INTERFACE
     ${ENGINE_MOD_DIR}/utility/engine_bit_collection.c
     ${ENGINE_MOD_DIR}/engine_object_layers.c
     ${ENGINE_MOD_DIR}/engine_gui.c
+    ${ENGINE_MOD_DIR}/engine_idle.c
     ${ENGINE_MOD_DIR}/display/engine_display.c
     # ${ENGINE_MOD_DIR}/display/engine_display_driver_rp2_st7789.c
     ${ENGINE_MOD_DIR}/display/engine_display_driver_rp2_gc9107.c
     ${ENGINE_MOD_DIR}/display/engine_display_common.c
+    ${ENGINE_MOD_DIR}/display/engine_display_damage.c
     ${ENGINE_MOD_DIR}/draw/engine_display_draw.c
+    ${ENGINE_MOD_DIR}/draw/engine_draw_deferred.c
+    ${ENGINE_MOD_DIR}/draw/engine_draw_static.c
     ${ENGINE_MOD_DIR}/audio/engine_audio_module.c
     ${ENGINE_MOD_DIR}/audio/engine_audio_channel.c
     ${ENGINE_MOD_DIR}/resources/engine_resource_module.c
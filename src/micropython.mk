@@ -38,6 +38,8 @@ SRC_USERMOD += $(ENGINE_MOD_DIR)/math/vector2.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/math/rectangle.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/debug/engine_debug_module.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/debug/debug_print.c
+SRC_USERMOD += $(ENGINE_MOD_DIR)/debug/engine_debug_profiler.c
+SRC_USERMOD += $(ENGINE_MOD_DIR)/debug/engine_debug_node_profiler.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/utility/linked_list.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/utility/engine_time.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/utility/engine_file.c
@@ -45,10 +47,14 @@ SRC_USERMOD += $(ENGINE_MOD_DIR)/utility/engine_mp.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/utility/engine_bit_collection.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/engine_object_layers.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/engine_gui.c
+SRC_USERMOD += $(ENGINE_MOD_DIR)/engine_idle.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/display/engine_display.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/display/engine_display_driver_unix_sdl.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/display/engine_display_common.c
+SRC_USERMOD += $(ENGINE_MOD_DIR)/display/engine_display_damage.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/draw/engine_display_draw.c
+SRC_USERMOD += $(ENGINE_MOD_DIR)/draw/engine_draw_deferred.c
+SRC_USERMOD += $(ENGINE_MOD_DIR)/draw/engine_draw_static.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/audio/engine_audio_module.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/audio/engine_audio_channel.c
 SRC_USERMOD += $(ENGINE_MOD_DIR)/resources/engine_resource_module.c
@@ -65,14 +65,14 @@ void circle_2d_node_class_draw(mp_obj_t circle_node_base_obj, mp_obj_t camera_no
     circle_radius = circle_radius*scale_radius_by*camera_zoom;
     circle_opacity = inherited.opacity * camera_opacity;
 
-    // Decide which shader to use per-pixel
-    engine_shader_t *shader = NULL;
-    if(circle_opacity < 1.0f){
-        shader = engine_get_builtin_shader(OPACITY_SHADER);
-    }else{
-        shader = engine_get_builtin_shader(EMPTY_SHADER);
+    // Skip shader setup and rasterizing if entirely off screen
+    if(engine_camera_2d_is_on_screen(inherited.px, inherited.py, circle_radius, circle_radius, 0.0f) == false){
+        return;
     }
 
+    // Decide which shader to use per-pixel
+    engine_shader_t *shader = engine_shader_resolve(circle_2d_node->shader, circle_opacity < 1.0f);
+
     if(circle_outlined == false){
         engine_draw_filled_circle(circle_color->value, floorf(inherited.px), floorf(inherited.py), circle_radius, circle_opacity, shader);
     }else{
@@ -81,6 +81,12 @@ void circle_2d_node_class_draw(mp_obj_t circle_node_base_obj, mp_obj_t camera_no
 }
 
 
+void circle_2d_node_class_tick(engine_node_base_t *circle_node_base, mp_obj_t dt_s_obj){
+    engine_circle_2d_node_class_obj_t *circle_2d_node = circle_node_base->node;
+    node_base_call_tick_cb(circle_node_base, circle_2d_node->tick_cb, dt_s_obj);
+}
+
+
 // Return `true` if handled loading the attr from internal structure, `false` otherwise
 bool circle_2d_node_load_attr(engine_node_base_t *self_node_base, qstr attribute, mp_obj_t *destination){
     // Get the underlying structure
@@ -116,6 +122,10 @@ bool circle_2d_node_load_attr(engine_node_base_t *self_node_base, qstr attribute
             destination[0] = self->opacity;
             return true;
         break;
+        case MP_QSTR_shader:
+            destination[0] = self->shader;
+            return true;
+        break;
         case MP_QSTR_scale:
             destination[0] = self->scale;
             return true;
@@ -160,6 +170,10 @@ bool circle_2d_node_store_attr(engine_node_base_t *self_node_base, qstr attribut
             self->opacity = destination[1];
             return true;
         break;
+        case MP_QSTR_shader:
+            self->shader = engine_shader_class_verify_opt(destination[1]);
+            return true;
+        break;
         case MP_QSTR_scale:
             self->scale = destination[1];
             return true;
@@ -199,6 +213,7 @@ static mp_attr_fun_t circle_2d_node_class_attr(mp_obj_t self_in, qstr attribute,
    PARAM:   [type=bool]                             [name=inherit_opacity]                               [value=True or False]
    PARAM:   [type=bool]                             [name=inherit_rotation]                              [value=True or False]
    PARAM:   [type=bool]                             [name=inherit_scale]                                 [value=True or False]
+   PARAM:   [type={ref_link:Shader}]                [name=shader]                                        [value={ref_link:Shader} or None]
    ATTR:    [type=function]                         [name={ref_link:add_child}]                          [value=function]
    ATTR:    [type=function]                         [name={ref_link:get_child}]                          [value=function]
    ATTR:    [type=function]                         [name={ref_link:get_child_count}]                    [value=function]
@@ -214,6 +229,7 @@ static mp_attr_fun_t circle_2d_node_class_attr(mp_obj_t self_in, qstr attribute,
    ATTR:    [type=float]                            [name=rotation]                                      [value=any]
    ATTR:    [type={ref_link:Color}|int (RGB565)]    [name=color]                                         [value=color]
    ATTR:    [type=float]                            [name=opacity]                                       [value=0 ~ 1.0]
+   ATTR:    [type={ref_link:Shader}]                [name=shader]                                        [value={ref_link:Shader} or None]
    ATTR:    [type=float]                            [name=scale]                                         [value=any]
    ATTR:    [type=bool]                             [name=outline]                                       [value=True or False]
    ATTR:    [type=int]                              [name=layer]                                         [value=0 ~ 127]
@@ -240,9 +256,10 @@ mp_obj_t circle_2d_node_class_new(const mp_obj_type_t *type, size_t n_args, size
         { MP_QSTR_inherit_opacity,   MP_ARG_BOOL, {.u_bool = true} },
         { MP_QSTR_inherit_rotation,  MP_ARG_BOOL, {.u_bool = true} },
         { MP_QSTR_inherit_scale,     MP_ARG_BOOL, {.u_bool = true} },
+        { MP_QSTR_shader,            MP_ARG_OBJ,  {.u_obj = mp_const_none} },
     };
     mp_arg_val_t parsed_args[MP_ARRAY_SIZE(allowed_args)];
-    enum arg_ids {child_class, position, radius, color, opacity, outline, rotation, scale, layer, inherit_position, inherit_opacity, inherit_rotation, inherit_scale};
+    enum arg_ids {child_class, position, radius, color, opacity, outline, rotation, scale, layer, inherit_position, inherit_opacity, inherit_rotation, inherit_scale, shader};
     bool inherited = false;
 
     // If there is one positional argument and it isn't the first
@@ -275,6 +292,7 @@ mp_obj_t circle_2d_node_class_new(const mp_obj_type_t *type, size_t n_args, size
     circle_2d_node->rotation = parsed_args[rotation].u_obj;
     circle_2d_node->color = engine_color_wrap(parsed_args[color].u_obj);
     circle_2d_node->opacity = parsed_args[opacity].u_obj;
+    circle_2d_node->shader = engine_shader_class_verify_opt(parsed_args[shader].u_obj);
     circle_2d_node->scale = parsed_args[scale].u_obj;
     circle_2d_node->outline = parsed_args[outline].u_obj;
     node_base_set_inherit_position(node_base, parsed_args[inherit_position].u_bool);
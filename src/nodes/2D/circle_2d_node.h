@@ -14,11 +14,13 @@ typedef struct{
     mp_obj_t opacity;
     mp_obj_t scale;     // float: how much to scale radius by, 1.0f by default
     mp_obj_t outline;   // bool: if true, circle is drawn as an outline, false by default
+    mp_obj_t shader;    // Shader or None: per-pixel effects
     mp_obj_t tick_cb;
 }engine_circle_2d_node_class_obj_t;
 
 extern const mp_obj_type_t engine_circle_2d_node_class_type;
 void circle_2d_node_class_draw(mp_obj_t circle_node_base_obj, mp_obj_t camera_node);
+void circle_2d_node_class_tick(engine_node_base_t *circle_node_base, mp_obj_t dt_s_obj);
 
 
 #endif  // CIRCLE_2D_NODE_H
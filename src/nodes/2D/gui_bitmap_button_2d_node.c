@@ -104,14 +104,8 @@ void gui_bitmap_button_2d_node_class_draw(mp_obj_t button_node_base_obj, mp_obj_
         if(text_color == mp_const_none){
             text_shader = engine_get_builtin_shader(EMPTY_SHADER);
         }else{
-            text_shader = engine_get_builtin_shader(BLEND_OPACITY_SHADER);
-
-            float t = 1.0f;
-
-            text_shader->program[1] = (text_color->value >> 8) & 0b11111111;
-            text_shader->program[2] = (text_color->value >> 0) & 0b11111111;
-
-            memcpy(text_shader->program+3, &t, sizeof(float));
+            text_shader = &button->text_shader;
+            engine_shader_compile_tint(text_shader, text_color->value, 1.0f);
         }
 
         engine_draw_text(font, button->text,
@@ -152,6 +146,55 @@ mp_obj_t gui_bitmap_button_2d_node_class_del(mp_obj_t self_in){
 static MP_DEFINE_CONST_FUN_OBJ_1(gui_bitmap_button_2d_node_class_del_obj, gui_bitmap_button_2d_node_class_del);
 
 
+void gui_bitmap_button_2d_node_class_tick(engine_node_base_t *button_node_base, mp_obj_t dt_s_obj){
+    engine_gui_bitmap_button_2d_node_class_obj_t *bitmap_button_2d_node = button_node_base->node;
+    node_base_call_tick_cb(button_node_base, bitmap_button_2d_node->tick_cb, dt_s_obj);
+
+    mp_obj_t exec[2];
+    exec[1] = button_node_base->attr_accessor;
+
+    if(bitmap_button_2d_node->on_focused_cb != mp_const_none && bitmap_button_2d_node->focused == true){
+        exec[0] = bitmap_button_2d_node->on_focused_cb;
+        mp_call_method_n_kw(0, 0, exec);
+    }
+
+    if(bitmap_button_2d_node->on_just_focused_cb != mp_const_none && bitmap_button_2d_node->last_focused == false && bitmap_button_2d_node->focused == true){
+        exec[0] = bitmap_button_2d_node->on_just_focused_cb;
+        mp_call_method_n_kw(0, 0, exec);
+    }
+
+    if(bitmap_button_2d_node->on_just_unfocused_cb != mp_const_none && bitmap_button_2d_node->last_focused == true && bitmap_button_2d_node->focused == false){
+        exec[0] = bitmap_button_2d_node->on_just_unfocused_cb;
+        mp_call_method_n_kw(0, 0, exec);
+    }
+
+    if(bitmap_button_2d_node->on_pressed_cb != mp_const_none && bitmap_button_2d_node->pressed == true){
+        exec[0] = bitmap_button_2d_node->on_pressed_cb;
+        mp_call_method_n_kw(0, 0, exec);
+    }
+
+    if(bitmap_button_2d_node->on_just_pressed_cb != mp_const_none && bitmap_button_2d_node->last_pressed == false && bitmap_button_2d_node->pressed == true){
+        exec[0] = bitmap_button_2d_node->on_just_pressed_cb;
+        mp_call_method_n_kw(0, 0, exec);
+    }
+
+    if(bitmap_button_2d_node->on_just_released_cb != mp_const_none && bitmap_button_2d_node->last_pressed == true && bitmap_button_2d_node->pressed == false){
+        exec[0] = bitmap_button_2d_node->on_just_released_cb;
+        mp_call_method_n_kw(0, 0, exec);
+    }
+
+    // Save the state for tracking for callbacks
+    bitmap_button_2d_node->last_pressed = bitmap_button_2d_node->pressed;
+    bitmap_button_2d_node->last_focused = bitmap_button_2d_node->focused;
+
+    // After ticking, set pressed back to false. After all node
+    // callbacks are done, the gui tick is done again and it
+    // may be found that the button is still pressed but
+    // set to false anyways
+    bitmap_button_2d_node->pressed = false;
+}
+
+
 // Return `true` if handled loading the attr from internal structure, `false` otherwise
 bool bitmap_button_2d_node_load_attr(engine_node_base_t *self_node_base, qstr attribute, mp_obj_t *destination){
     // Get the underlying structure
@@ -641,6 +684,8 @@ mp_obj_t gui_bitmap_button_2d_node_class_new(const mp_obj_type_t *type, size_t n
     node_base->node = gui_bitmap_button_2d_node;
     node_base->attr_accessor = node_base;
 
+    engine_shader_compile(&gui_bitmap_button_2d_node->text_shader, NULL, 0);
+
     gui_bitmap_button_2d_node->gui_list_node = engine_collections_track_gui(node_base);
 
     gui_bitmap_button_2d_node->tick_cb = mp_const_none;
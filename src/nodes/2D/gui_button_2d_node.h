@@ -6,6 +6,7 @@
 #include "nodes/node_base.h"
 #include "utility/linked_list.h"
 #include "io/engine_io_buttons.h"
+#include "draw/engine_shader.h"
 
 typedef struct{
     mp_obj_t position;
@@ -56,10 +57,13 @@ typedef struct{
     float width_outline;
     float height_outline;
 
+    engine_shader_t text_shader;    // Compiled tint for `text_color`, owned by this node
+
     linked_list_node *gui_list_node;
 }engine_gui_button_2d_node_class_obj_t;
 
 extern const mp_obj_type_t engine_gui_button_2d_node_class_type;
 void gui_button_2d_node_class_draw(mp_obj_t button_node_base_obj, mp_obj_t camera_node);
+void gui_button_2d_node_class_tick(engine_node_base_t *button_node_base, mp_obj_t dt_s_obj);
 
 #endif  // GUI_BUTTON_2D_NODE_H
\ No newline at end of file
@@ -69,46 +69,45 @@ void line_2d_node_class_draw(mp_obj_t line_node_base_obj, mp_obj_t camera_node){
         line_thickness = 1.0f;
     }
 
-    // Decide which shader to use per-pixel
-    engine_shader_t *shader = NULL;
-    if(line_opacity < 1.0f){
-        shader = engine_get_builtin_shader(OPACITY_SHADER);
-    }else{
-        shader = engine_get_builtin_shader(EMPTY_SHADER);
+    // Skip shader setup and rasterizing if entirely off screen
+    if(engine_camera_2d_is_on_screen(inherited.px, inherited.py, line_thickness/2.0f, line_length/2.0f, inherited.rotation) == false){
+        return;
     }
 
-    if(line_outlined == false){
-        engine_draw_rect(line_color->value,
-                         floorf(inherited.px), floorf(inherited.py),
-                         (int32_t)line_thickness, (int32_t)line_length,
-                         1.0f, 1.0f,
-                        -inherited.rotation,
-                         line_opacity,
-                         shader);
-    }else{
-        float line_half_width = line_thickness/2.0f;
-        float line_half_height = line_length/2.0f;
+    // Decide which shader to use per-pixel
+    engine_shader_t *shader = engine_shader_resolve(line_2d->shader, line_opacity < 1.0f);
 
-        // Calculate the coordinates of the 4 corners of the line, not rotated
-        // NOTE: positive y is down
-        float tlx = floorf(inherited.px - line_half_width);
-        float tly = floorf(inherited.py - line_half_height);
+    float line_half_width = line_thickness/2.0f;
+    float line_half_height = line_length/2.0f;
 
-        float trx = floorf(inherited.px + line_half_width);
-        float try = floorf(inherited.py - line_half_height);
+    // Calculate the coordinates of the 4 corners of the line, not rotated
+    // NOTE: positive y is down
+    float tlx = inherited.px - line_half_width;
+    float tly = inherited.py - line_half_height;
 
-        float brx = floorf(inherited.px + line_half_width);
-        float bry = floorf(inherited.py + line_half_height);
+    float trx = inherited.px + line_half_width;
+    float try = inherited.py - line_half_height;
 
-        float blx = floorf(inherited.px - line_half_width);
-        float bly = floorf(inherited.py + line_half_height);
+    float brx = inherited.px + line_half_width;
+    float bry = inherited.py + line_half_height;
 
-        // Rotate the points and then draw lines between them
-        engine_math_rotate_point(&tlx, &tly, inherited.px, inherited.py, inherited.py);
-        engine_math_rotate_point(&trx, &try, inherited.px, inherited.py, inherited.py);
-        engine_math_rotate_point(&brx, &bry, inherited.px, inherited.py, inherited.py);
-        engine_math_rotate_point(&blx, &bly, inherited.px, inherited.py, inherited.py);
+    float blx = inherited.px - line_half_width;
+    float bly = inherited.py + line_half_height;
 
+    // Rotate the points the same way 'engine_draw_rect()' would have
+    engine_math_rotate_point(&tlx, &tly, inherited.px, inherited.py, inherited.rotation);
+    engine_math_rotate_point(&trx, &try, inherited.px, inherited.py, inherited.rotation);
+    engine_math_rotate_point(&brx, &bry, inherited.px, inherited.py, inherited.rotation);
+    engine_math_rotate_point(&blx, &bly, inherited.px, inherited.py, inherited.rotation);
+
+    if(line_outlined == false){
+        // Thick lines are two triangles filled a row span at a time
+        // instead of a rotated rectangle that maps every pixel of its
+        // bounding box back to check if it's inside. Triangles sharing
+        // the diagonal don't blend it twice
+        engine_draw_filled_triangle(line_color->value, tlx, tly, trx, try, brx, bry, line_opacity, shader);
+        engine_draw_filled_triangle(line_color->value, tlx, tly, brx, bry, blx, bly, line_opacity, shader);
+    }else{
         engine_draw_line(line_color->value, tlx, tly, trx, try, camera_node, line_opacity, shader);
         engine_draw_line(line_color->value, trx, try, brx, bry, camera_node, line_opacity, shader);
         engine_draw_line(line_color->value, brx, bry, blx, bly, camera_node, line_opacity, shader);
@@ -152,6 +151,12 @@ void line_2d_translate_endpoints(void *line_obj, float nx, float ny){
 }
 
 
+void line_2d_node_class_tick(engine_node_base_t *line_node_base, mp_obj_t dt_s_obj){
+    engine_line_2d_node_class_obj_t *line_2d_node = line_node_base->node;
+    node_base_call_tick_cb(line_node_base, line_2d_node->tick_cb, dt_s_obj);
+}
+
+
 // Return `true` if handled loading the attr from internal structure, `false` otherwise
 bool line_2d_load_attr(engine_node_base_t *self_node_base, qstr attribute, mp_obj_t *destination){
     // Get the underlying structure
@@ -187,6 +192,10 @@ bool line_2d_load_attr(engine_node_base_t *self_node_base, qstr attribute, mp_ob
             destination[0] = self->opacity;
             return true;
         break;
+        case MP_QSTR_shader:
+            destination[0] = self->shader;
+            return true;
+        break;
         case MP_QSTR_outline:
             destination[0] = self->outline;
             return true;
@@ -235,6 +244,10 @@ bool line_2d_store_attr(engine_node_base_t *self_node_base, qstr attribute, mp_o
             self->opacity = destination[1];
             return true;
         break;
+        case MP_QSTR_shader:
+            self->shader = engine_shader_class_verify_opt(destination[1]);
+            return true;
+        break;
         case MP_QSTR_outline:
             self->outline = destination[1];
             return true;
@@ -269,6 +282,7 @@ static mp_attr_fun_t line_2d_node_class_attr(mp_obj_t self_in, qstr attribute, m
     PARAM:  [type=bool]                             [name=inherit_opacity]                              [value=True or False]
     PARAM:  [type=bool]                             [name=inherit_rotation]                             [value=True or False]
     PARAM:  [type=bool]                             [name=inherit_scale]                                [value=True or False]
+    PARAM:  [type={ref_link:Shader}]                [name=shader]                                       [value={ref_link:Shader} or None]
     ATTR:   [type=function]                         [name={ref_link:add_child}]                         [value=function]
     ATTR:   [type=function]                         [name={ref_link:get_child}]                         [value=function]
     ATTR:   [type=function]                         [name={ref_link:get_child_count}]                   [value=function]
@@ -285,6 +299,7 @@ static mp_attr_fun_t line_2d_node_class_attr(mp_obj_t self_in, qstr attribute, m
     ATTR:   [type=float]                            [name=thickness]                                    [value=any]
     ATTR:   [type={ref_link:Color}|int (RGB565)]    [name=color]                                        [value=color]
     ATTR:   [type=float]                            [name=opacity]                                      [value=0 ~ 1.0]
+    ATTR:   [type={ref_link:Shader}]                [name=shader]                                       [value={ref_link:Shader} or None]
     ATTR:   [type=bool]                             [name=outline]                                      [value=True or False]
     ATTR:   [type=int]                              [name=layer]                                        [value=0 ~ 127]
     ATTR:   [type=bool]                             [name=inherit_position]                             [value=True or False]
@@ -309,9 +324,10 @@ mp_obj_t line_2d_node_class_new(const mp_obj_type_t *type, size_t n_args, size_t
         { MP_QSTR_inherit_opacity,   MP_ARG_BOOL, {.u_bool = true} },
         { MP_QSTR_inherit_rotation,  MP_ARG_BOOL, {.u_bool = true} },
         { MP_QSTR_inherit_scale,     MP_ARG_BOOL, {.u_bool = true} },
+        { MP_QSTR_shader,            MP_ARG_OBJ,  {.u_obj = mp_const_none} },
     };
     mp_arg_val_t parsed_args[MP_ARRAY_SIZE(allowed_args)];
-    enum arg_ids {child_class, start, end, thickness, color, opacity, outline, layer, inherit_position, inherit_opacity, inherit_rotation, inherit_scale};
+    enum arg_ids {child_class, start, end, thickness, color, opacity, outline, layer, inherit_position, inherit_opacity, inherit_rotation, inherit_scale, shader};
     bool inherited = false;
 
     // If there is one positional argument and it isn't the first
@@ -347,6 +363,7 @@ mp_obj_t line_2d_node_class_new(const mp_obj_type_t *type, size_t n_args, size_t
     line_2d_node->thickness = parsed_args[thickness].u_obj;
     line_2d_node->color = engine_color_wrap(parsed_args[color].u_obj);
     line_2d_node->opacity = parsed_args[opacity].u_obj;
+    line_2d_node->shader = engine_shader_class_verify_opt(parsed_args[shader].u_obj);
     line_2d_node->outline = parsed_args[outline].u_obj;
     node_base_set_inherit_position(node_base, parsed_args[inherit_position].u_bool);
     node_base_set_inherit_opacity(node_base, parsed_args[inherit_opacity].u_bool);
@@ -14,10 +14,12 @@ typedef struct{
     mp_obj_t color;     // int The color of this line
     mp_obj_t opacity;
     mp_obj_t outline;   // bool: if true, line is drawn as an outline, false by default
+    mp_obj_t shader;    // Shader or None: per-pixel effects
     mp_obj_t tick_cb;
 }engine_line_2d_node_class_obj_t;
 
 extern const mp_obj_type_t engine_line_2d_node_class_type;
 void line_2d_node_class_draw(mp_obj_t line_node_base_obj, mp_obj_t camera_node);
+void line_2d_node_class_tick(engine_node_base_t *line_node_base, mp_obj_t dt_s_obj);
 
 #endif  // LINE_2D_NODE_H
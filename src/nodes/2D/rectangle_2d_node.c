@@ -54,14 +54,17 @@ void rectangle_2d_node_class_draw(mp_obj_t rectangle_node_base_obj, mp_obj_t cam
 
     rectangle_opacity = inherited.opacity * camera_opacity;
 
-    // Decide which shader to use per-pixel
-    engine_shader_t *shader = NULL;
-    if(rectangle_opacity < 1.0f){
-        shader = engine_get_builtin_shader(OPACITY_SHADER);
-    }else{
-        shader = engine_get_builtin_shader(EMPTY_SHADER);
+    // Skip shader setup and rasterizing if entirely off screen
+    float rectangle_half_width = (rectangle_width/2.0f)*inherited.sx*camera_zoom;
+    float rectangle_half_height = (rectangle_height/2.0f)*inherited.sy*camera_zoom;
+
+    if(engine_camera_2d_is_on_screen(inherited.px, inherited.py, rectangle_half_width, rectangle_half_height, inherited.rotation) == false){
+        return;
     }
 
+    // Decide which shader to use per-pixel
+    engine_shader_t *shader = engine_shader_resolve(rectangle_2d_node->shader, rectangle_opacity < 1.0f);
+
     if(rectangle_outlined == false){
         engine_draw_rect(rectangle_color->value,
                          floorf(inherited.px), floorf(inherited.py),
@@ -71,9 +74,6 @@ void rectangle_2d_node_class_draw(mp_obj_t rectangle_node_base_obj, mp_obj_t cam
                          rectangle_opacity,
                          shader);
     }else{
-        float rectangle_half_width = (rectangle_width/2.0f)*inherited.sx*camera_zoom;
-        float rectangle_half_height = (rectangle_height/2.0f)*inherited.sy*camera_zoom;
-
         // Calculate the coordinates of the 4 corners of the rectangle, not rotated
         // NOTE: positive y is down
         float tlx = floorf(inherited.px - rectangle_half_width);
@@ -102,6 +102,12 @@ void rectangle_2d_node_class_draw(mp_obj_t rectangle_node_base_obj, mp_obj_t cam
 }
 
 
+void rectangle_2d_node_class_tick(engine_node_base_t *rectangle_node_base, mp_obj_t dt_s_obj){
+    engine_rectangle_2d_node_class_obj_t *rectangle_2d_node = rectangle_node_base->node;
+    node_base_call_tick_cb(rectangle_node_base, rectangle_2d_node->tick_cb, dt_s_obj);
+}
+
+
 // Return `true` if handled loading the attr from internal structure, `false` otherwise
 bool rectangle_2d_node_load_attr(engine_node_base_t *self_node_base, qstr attribute, mp_obj_t *destination){
     // Get the underlying structure
@@ -133,6 +139,10 @@ bool rectangle_2d_node_load_attr(engine_node_base_t *self_node_base, qstr attrib
             destination[0] = self->opacity;
             return true;
         break;
+        case MP_QSTR_shader:
+            destination[0] = self->shader;
+            return true;
+        break;
         case MP_QSTR_outline:
             destination[0] = self->outline;
             return true;
@@ -181,6 +191,10 @@ bool rectangle_2d_node_store_attr(engine_node_base_t *self_node_base, qstr attri
             self->opacity = destination[1];
             return true;
         break;
+        case MP_QSTR_shader:
+            self->shader = engine_shader_class_verify_opt(destination[1]);
+            return true;
+        break;
         case MP_QSTR_outline:
             self->outline = destination[1];
             return true;
@@ -225,6 +239,7 @@ static mp_attr_fun_t rectangle_2d_node_class_attr(mp_obj_t self_in, qstr attribu
     PARAM:  [type=bool]                             [name=inherit_opacity]                              [value=True or False]
     PARAM:  [type=bool]                             [name=inherit_rotation]                             [value=True or False]
     PARAM:  [type=bool]                             [name=inherit_scale]                                [value=True or False]
+    PARAM:  [type={ref_link:Shader}]                [name=shader]                                       [value={ref_link:Shader} or None]
     ATTR:   [type=function]                         [name={ref_link:add_child}]                         [value=function]
     ATTR:   [type=function]                         [name={ref_link:get_child}]                         [value=function]
     ATTR:   [type=function]                         [name={ref_link:get_child_count}]                   [value=function]
@@ -240,6 +255,7 @@ static mp_attr_fun_t rectangle_2d_node_class_attr(mp_obj_t self_in, qstr attribu
     ATTR:   [type=float]                            [name=height]                                       [value=any]
     ATTR:   [type={ref_link:Color}|int (RGB565)]    [name=color]                                        [value=color]
     ATTR:   [type=float]                            [name=opacity]                                      [value=0 ~ 1.0]
+    ATTR:   [type={ref_link:Shader}]                [name=shader]                                       [value={ref_link:Shader} or None]
     ATTR:   [type=bool]                             [name=outline]                                      [value=True or False]
     ATTR:   [type=float]                            [name=rotation]                                     [value=any (radians)]
     ATTR:   [type={ref_link:Vector2}]               [name=scale]                                        [value={ref_link:Vector2}]
@@ -268,9 +284,10 @@ mp_obj_t rectangle_2d_node_class_new(const mp_obj_type_t *type, size_t n_args, s
         { MP_QSTR_inherit_opacity,   MP_ARG_BOOL, {.u_bool = true} },
         { MP_QSTR_inherit_rotation,  MP_ARG_BOOL, {.u_bool = true} },
         { MP_QSTR_inherit_scale,     MP_ARG_BOOL, {.u_bool = true} },
+        { MP_QSTR_shader,            MP_ARG_OBJ,  {.u_obj = mp_const_none} },
     };
     mp_arg_val_t parsed_args[MP_ARRAY_SIZE(allowed_args)];
-    enum arg_ids {child_class, position, width, height, color, opacity, outline, rotation, scale, layer, inherit_position, inherit_opacity, inherit_rotation, inherit_scale};
+    enum arg_ids {child_class, position, width, height, color, opacity, outline, rotation, scale, layer, inherit_position, inherit_opacity, inherit_rotation, inherit_scale, shader};
     bool inherited = false;
 
     // If there is one positional argument and it isn't the first
@@ -303,6 +320,7 @@ mp_obj_t rectangle_2d_node_class_new(const mp_obj_type_t *type, size_t n_args, s
     rectangle_2d_node->height = parsed_args[height].u_obj;
     rectangle_2d_node->color = engine_color_wrap(parsed_args[color].u_obj);
     rectangle_2d_node->opacity = parsed_args[opacity].u_obj;
+    rectangle_2d_node->shader = engine_shader_class_verify_opt(parsed_args[shader].u_obj);
     rectangle_2d_node->outline = parsed_args[outline].u_obj;
     rectangle_2d_node->rotation = parsed_args[rotation].u_obj;
     rectangle_2d_node->scale = parsed_args[scale].u_obj;
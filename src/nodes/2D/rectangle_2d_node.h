@@ -14,11 +14,13 @@ typedef struct{
     mp_obj_t outline;   // bool: if true, rectangle drawn as outline, if false, drawn filled (false by default)
     mp_obj_t rotation;  // Rectangle rotation in radians
     mp_obj_t scale;     // Vector2: 2d scale of the rectangle
+    mp_obj_t shader;    // Shader or None: per-pixel effects
     mp_obj_t tick_cb;
 }engine_rectangle_2d_node_class_obj_t;
 
 extern const mp_obj_type_t engine_rectangle_2d_node_class_type;
 void rectangle_2d_node_class_draw(mp_obj_t rectangle_node_base_obj, mp_obj_t camera_node);
+void rectangle_2d_node_class_tick(engine_node_base_t *rectangle_node_base, mp_obj_t dt_s_obj);
 
 
 #endif  // RECTANGLE_2D_NODE_H
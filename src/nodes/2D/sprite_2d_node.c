@@ -14,6 +14,7 @@
 #include "utility/engine_time.h"
 #include "draw/engine_color.h"
 #include "draw/engine_shader.h"
+#include "display/engine_display_damage.h"
 #include "py/obj.h"
 
 
@@ -92,27 +93,29 @@ void sprite_2d_node_class_draw(mp_obj_t sprite_node_base_obj, mp_obj_t camera_no
 
     sprite_opacity = inherited.opacity*camera_opacity;
 
-    // Decide which shader to use per-pixel
-    engine_shader_t *shader = NULL;
-    if(sprite_opacity < 1.0f || sprite_texture->alpha_mask != 0){
-        shader = engine_get_builtin_shader(OPACITY_SHADER);
-    }else{
-        shader = engine_get_builtin_shader(EMPTY_SHADER);
+    // Only rasterize if on screen, but keep animating either way
+    float sprite_half_width = sprite_frame_width*inherited.sx*camera_zoom*0.5f;
+    float sprite_half_height = sprite_frame_height*inherited.sy*camera_zoom*0.5f;
+
+    if(engine_camera_2d_is_on_screen(inherited.px, inherited.py, sprite_half_width, sprite_half_height, inherited.rotation)){
+        // Decide which shader to use per-pixel
+        engine_shader_t *shader = engine_shader_resolve(sprite_2d_node->shader, sprite_opacity < 1.0f || sprite_texture->alpha_mask != 0);
+
+        engine_draw_blit(sprite_texture, sprite_frame_fb_start_index,
+                         floorf(inherited.px), floorf(inherited.py),
+                         sprite_frame_width, sprite_frame_height,
+                         sprite_texture->pixel_stride,
+                         inherited.sx*camera_zoom,
+                         inherited.sy*camera_zoom,
+                        -inherited.rotation,
+                         transparent_color->value,
+                         sprite_opacity,
+                         shader);
     }
 
-    engine_draw_blit(sprite_texture, sprite_frame_fb_start_index,
-                     floorf(inherited.px), floorf(inherited.py),
-                     sprite_frame_width, sprite_frame_height,
-                     sprite_texture->pixel_stride,
-                     inherited.sx*camera_zoom,
-                     inherited.sy*camera_zoom,
-                    -inherited.rotation,
-                     transparent_color->value,
-                     sprite_opacity,
-                     shader);
-
-    // After drawing, go to the next frame if it is time to and the animation is playing
-    if(sprite_playing == true){
+    // After drawing, go to the next frame if it is time to and the animation is
+    // playing (only when actually drawing, not when just measuring damage)
+    if(sprite_playing == true && engine_display_damage_is_measuring() == false){
         float sprite_fps = mp_obj_get_float(mp_load_attr(sprite_node_base->attr_accessor, MP_QSTR_fps));
         uint16_t sprite_period = (uint16_t)((1.0f/sprite_fps) * 1000.0f);
 
@@ -153,6 +156,12 @@ void sprite_2d_node_class_draw(mp_obj_t sprite_node_base_obj, mp_obj_t camera_no
 }
 
 
+void sprite_2d_node_class_tick(engine_node_base_t *sprite_node_base, mp_obj_t dt_s_obj){
+    engine_sprite_2d_node_class_obj_t *sprite_2d_node = sprite_node_base->node;
+    node_base_call_tick_cb(sprite_node_base, sprite_2d_node->tick_cb, dt_s_obj);
+}
+
+
 // Return `true` if handled loading the attr from internal structure, `false` otherwise
 bool sprite_2d_node_load_attr(engine_node_base_t *self_node_base, qstr attribute, mp_obj_t *destination){
     // Get the underlying structure
@@ -200,6 +209,10 @@ bool sprite_2d_node_load_attr(engine_node_base_t *self_node_base, qstr attribute
             destination[0] = self->opacity;
             return true;
         break;
+        case MP_QSTR_shader:
+            destination[0] = self->shader;
+            return true;
+        break;
         case MP_QSTR_playing:
             destination[0] = self->playing;
             return true;
@@ -274,6 +287,10 @@ bool sprite_2d_node_store_attr(engine_node_base_t *self_node_base, qstr attribut
             self->opacity = destination[1];
             return true;
         break;
+        case MP_QSTR_shader:
+            self->shader = engine_shader_class_verify_opt(destination[1]);
+            return true;
+        break;
         case MP_QSTR_playing:
             self->playing = destination[1];
             return true;
@@ -330,6 +347,7 @@ static mp_attr_fun_t sprite_2d_node_class_attr(mp_obj_t self_in, qstr attribute,
     PARAM:  [type=bool]                             [name=inherit_opacity]                              [value=True or False]
     PARAM:  [type=bool]                             [name=inherit_rotation]                             [value=True or False]
     PARAM:  [type=bool]                             [name=inherit_scale]                                [value=True or False]
+    PARAM:  [type={ref_link:Shader}]                [name=shader]                                       [value={ref_link:Shader} or None]
     ATTR:   [type=function]                         [name={ref_link:add_child}]                         [value=function]
     ATTR:   [type=function]                         [name={ref_link:get_child}]                         [value=function]
     ATTR:   [type=function]                         [name={ref_link:get_child_count}]                   [value=function]
@@ -349,6 +367,7 @@ static mp_attr_fun_t sprite_2d_node_class_attr(mp_obj_t self_in, qstr attribute,
     ATTR:   [type=float]                            [name=rotation]                                     [value=any (radians)]
     ATTR:   [type={ref_link:Vector2}]               [name=scale]                                        [value={ref_link:Vector2}]
     ATTR:   [type=float]                            [name=opacity]                                      [value=0 ~ 1.0]
+    ATTR:   [type={ref_link:Shader}]                [name=shader]                                       [value={ref_link:Shader} or None]
     ATTR:   [type=boolean]                          [name=playing]                                      [value=boolean]
     ATTR:   [type=boolean]                          [name=loop]                                         [value=boolean]
     ATTR:   [type=int]                              [name=frame_current_x]                              [value=any positive integer]
@@ -381,9 +400,10 @@ mp_obj_t sprite_2d_node_class_new(const mp_obj_type_t *type, size_t n_args, size
         { MP_QSTR_inherit_opacity,      MP_ARG_BOOL, {.u_bool = true} },
         { MP_QSTR_inherit_rotation,     MP_ARG_BOOL, {.u_bool = true} },
         { MP_QSTR_inherit_scale,        MP_ARG_BOOL, {.u_bool = true} },
+        { MP_QSTR_shader,               MP_ARG_OBJ,  {.u_obj = mp_const_none} },
     };
     mp_arg_val_t parsed_args[MP_ARRAY_SIZE(allowed_args)];
-    enum arg_ids {child_class, position, texture, transparent_color, fps, frame_count_x, frame_count_y, rotation, scale, opacity, playing, loop, layer, inherit_position, inherit_opacity, inherit_rotation, inherit_scale};
+    enum arg_ids {child_class, position, texture, transparent_color, fps, frame_count_x, frame_count_y, rotation, scale, opacity, playing, loop, layer, inherit_position, inherit_opacity, inherit_rotation, inherit_scale, shader};
     bool inherited = false;
 
     // If there is one positional argument and it isn't the first
@@ -421,6 +441,7 @@ mp_obj_t sprite_2d_node_class_new(const mp_obj_type_t *type, size_t n_args, size
     sprite_2d_node->rotation = parsed_args[rotation].u_obj;
     sprite_2d_node->scale = parsed_args[scale].u_obj;
     sprite_2d_node->opacity = parsed_args[opacity].u_obj;
+    sprite_2d_node->shader = engine_shader_class_verify_opt(parsed_args[shader].u_obj);
     sprite_2d_node->playing = parsed_args[playing].u_obj;
     sprite_2d_node->loop = parsed_args[loop].u_obj;
     node_base_set_inherit_position(node_base, parsed_args[inherit_position].u_bool);
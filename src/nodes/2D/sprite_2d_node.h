@@ -19,11 +19,13 @@ typedef struct{
     mp_obj_t opacity;
     mp_obj_t playing;               // Bool: is the animation running or not
     mp_obj_t loop;
+    mp_obj_t shader;                // Shader or None: per-pixel effects
     mp_obj_t tick_cb;
     uint32_t time_at_last_animation_update_ms;
 }engine_sprite_2d_node_class_obj_t;
 
 extern const mp_obj_type_t engine_sprite_2d_node_class_type;
 void sprite_2d_node_class_draw(mp_obj_t sprite_node_base_obj, mp_obj_t camera_node);
+void sprite_2d_node_class_tick(engine_node_base_t *sprite_node_base, mp_obj_t dt_s_obj);
 
 #endif  // SPRITE_2D_NODE_H
\ No newline at end of file
@@ -65,25 +65,30 @@ void text_2d_node_class_draw(mp_obj_t text_2d_node_base_obj, mp_obj_t camera_nod
 
     text_opacity = inherited.opacity*camera_opacity;
 
+    // Skip shader setup and rasterizing if entirely off screen (pad
+    // by a glyph since glyphs are blitted centered on the box edges)
+    float text_half_width = (text_box_width + text_font->glyph_height)*inherited.sx*camera_zoom*0.5f;
+    float text_half_height = (text_box_height + text_font->glyph_height)*inherited.sy*camera_zoom*0.5f;
+
+    if(engine_camera_2d_is_on_screen(inherited.px, inherited.py, text_half_width, text_half_height, inherited.rotation) == false){
+        return;
+    }
+
     float text_letter_spacing = mp_obj_get_float(text_2d_node->letter_spacing);
     float text_line_spacing = mp_obj_get_float(text_2d_node->line_spacing);
 
     // Decide which shader to use per-pixel
     engine_shader_t *text_shader = NULL;
 
-    if(text_color != mp_const_none){
-        text_shader = engine_get_builtin_shader(BLEND_OPACITY_SHADER);
-
-        float t = 1.0f;
-
-        text_shader->program[1] = (text_color->value >> 8) & 0b11111111;
-        text_shader->program[2] = (text_color->value >> 0) & 0b11111111;
-
-        memcpy(text_shader->program+3, &t, sizeof(float));
-    }else if(text_opacity < 1.0f || text_font->texture_resource->alpha_mask != 0){
-        text_shader = engine_get_builtin_shader(OPACITY_SHADER);   
+    if(text_2d_node->shader != mp_const_none){
+        // An assigned `Shader` replaces coloring by `color`
+        text_shader = engine_shader_resolve(text_2d_node->shader, true);
+    }else if(text_color != mp_const_none){
+        // Only recompiles when the color changed since the last draw
+        text_shader = &text_2d_node->color_shader;
+        engine_shader_compile_tint(text_shader, text_color->value, 1.0f);
     }else{
-        text_shader = engine_get_builtin_shader(EMPTY_SHADER);
+        text_shader = engine_shader_resolve(mp_const_none, text_opacity < 1.0f || text_font->texture_resource->alpha_mask != 0);
     }
 
     engine_draw_text(text_font,
@@ -147,6 +152,12 @@ mp_obj_t santize(mp_obj_t str_obj){
 }
 
 
+void text_2d_node_class_tick(engine_node_base_t *text_2d_node_base, mp_obj_t dt_s_obj){
+    engine_text_2d_node_class_obj_t *text_2d_node = text_2d_node_base->node;
+    node_base_call_tick_cb(text_2d_node_base, text_2d_node->tick_cb, dt_s_obj);
+}
+
+
 // Return `true` if handled loading the attr from internal structure, `false` otherwise
 bool text_2d_node_load_attr(engine_node_base_t *self_node_base, qstr attribute, mp_obj_t *destination){
     // Get the underlying structure
@@ -182,6 +193,10 @@ bool text_2d_node_load_attr(engine_node_base_t *self_node_base, qstr attribute,
             destination[0] = self->opacity;
             return true;
         break;
+        case MP_QSTR_shader:
+            destination[0] = self->shader;
+            return true;
+        break;
         case MP_QSTR_letter_spacing:
             destination[0] = self->letter_spacing;
             return true;
@@ -246,6 +261,10 @@ bool text_2d_node_store_attr(engine_node_base_t *self_node_base, qstr attribute,
             self->opacity = destination[1];
             return true;
         break;
+        case MP_QSTR_shader:
+            self->shader = engine_shader_class_verify_opt(destination[1]);
+            return true;
+        break;
         case MP_QSTR_letter_spacing:
             self->letter_spacing = destination[1];
             return true;
@@ -299,6 +318,7 @@ static mp_attr_fun_t text_2d_node_class_attr(mp_obj_t self_in, qstr attribute, m
     PARAM:  [type=bool]                             [name=inherit_opacity]                              [value=True or False]
     PARAM:  [type=bool]                             [name=inherit_rotation]                             [value=True or False]
     PARAM:  [type=bool]                             [name=inherit_scale]                                [value=True or False]
+    PARAM:  [type={ref_link:Shader}]                [name=shader]                                       [value={ref_link:Shader} or None]
     ATTR:   [type=function]                         [name={ref_link:add_child}]                         [value=function]
     ATTR:   [type=function]                         [name={ref_link:get_child}]                         [value=function]
     ATTR:   [type=function]                         [name={ref_link:get_child_count}]                   [value=function]
@@ -317,6 +337,7 @@ static mp_attr_fun_t text_2d_node_class_attr(mp_obj_t self_in, qstr attribute, m
     ATTR:   [type=float]                            [name=rotation]                                     [value=any (radians)]
     ATTR:   [type={ref_link:Vector2}]               [name=scale]                                        [value={ref_link:Vector2}]
     ATTR:   [type=float]                            [name=opacity]                                      [value=0 ~ 1.0]
+    ATTR:   [type={ref_link:Shader}]                [name=shader]                                       [value={ref_link:Shader} or None]
     ATTR:   [type=float]                            [name=letter_spacing]                               [value=any]
     ATTR:   [type=float]                            [name=line_spacing]                                 [value=any]
     ATTR:   [type={ref_link:Color}|int (RGB565)]    [name=color]                                        [value=color]
@@ -346,9 +367,10 @@ mp_obj_t text_2d_node_class_new(const mp_obj_type_t *type, size_t n_args, size_t
         { MP_QSTR_inherit_opacity,      MP_ARG_BOOL, {.u_bool = true} },
         { MP_QSTR_inherit_rotation,     MP_ARG_BOOL, {.u_bool = true} },
         { MP_QSTR_inherit_scale,        MP_ARG_BOOL, {.u_bool = true} },
+        { MP_QSTR_shader,               MP_ARG_OBJ,  {.u_obj = mp_const_none} },
     };
     mp_arg_val_t parsed_args[MP_ARRAY_SIZE(allowed_args)];
-    enum arg_ids {child_class, position, font, text, rotation, scale, opacity, letter_spacing, line_spacing, color, layer, inherit_position, inherit_opacity, inherit_rotation, inherit_scale};
+    enum arg_ids {child_class, position, font, text, rotation, scale, opacity, letter_spacing, line_spacing, color, layer, inherit_position, inherit_opacity, inherit_rotation, inherit_scale, shader};
     bool inherited = false;
 
     // If there is one positional argument and it isn't the first
@@ -375,6 +397,8 @@ mp_obj_t text_2d_node_class_new(const mp_obj_type_t *type, size_t n_args, size_t
     node_base->node = text_2d_node;
     node_base->attr_accessor = node_base;
 
+    engine_shader_compile(&text_2d_node->color_shader, NULL, 0);
+
     text_2d_node->tick_cb = mp_const_none;
     text_2d_node->position = parsed_args[position].u_obj;
     text_2d_node->font_resource = parsed_args[font].u_obj;
@@ -382,6 +406,7 @@ mp_obj_t text_2d_node_class_new(const mp_obj_type_t *type, size_t n_args, size_t
     text_2d_node->rotation = parsed_args[rotation].u_obj;
     text_2d_node->scale = parsed_args[scale].u_obj;
     text_2d_node->opacity = parsed_args[opacity].u_obj;
+    text_2d_node->shader = engine_shader_class_verify_opt(parsed_args[shader].u_obj);
     text_2d_node->letter_spacing = parsed_args[letter_spacing].u_obj;
     text_2d_node->line_spacing = parsed_args[line_spacing].u_obj;
     text_2d_node->color = engine_color_wrap_opt(parsed_args[color].u_obj);
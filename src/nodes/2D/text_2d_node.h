@@ -3,6 +3,7 @@
 
 #include "py/obj.h"
 #include "nodes/node_base.h"
+#include "draw/engine_shader.h"
 
 // A basic 2d text node
 typedef struct{
@@ -17,11 +18,15 @@ typedef struct{
     mp_obj_t width;         // Width, in int pixels, of the box containing the text
     mp_obj_t height;        // height, in int pixels, of the box containing the text
     mp_obj_t color;
+    mp_obj_t shader;        // Shader or None: per-pixel effects
     mp_obj_t tick_cb;
+
+    engine_shader_t color_shader;   // Compiled tint for `color`, owned by this node
 }engine_text_2d_node_class_obj_t;
 
 extern const mp_obj_type_t engine_text_2d_node_class_type;
 void text_2d_node_class_draw(mp_obj_t text_2d_node_base_obj, mp_obj_t camera_node);
+void text_2d_node_class_tick(engine_node_base_t *text_2d_node_base, mp_obj_t dt_s_obj);
 mp_obj_t text_2d_node_class_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args);
 
 #endif  // TEXT_2D_NODE_H
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include "math/rectangle.h"
 #include "utility/linked_list.h"
 #include "display/engine_display_common.h"
+#include "display/engine_display_damage.h"
+#include "draw/engine_display_draw.h"
 #include "math/engine_math.h"
 #include "engine_collections.h"
 
@@ -182,6 +184,12 @@ mp_obj_t camera_node_class_del(mp_obj_t self_in){
 static MP_DEFINE_CONST_FUN_OBJ_1(camera_node_class_del_obj, camera_node_class_del);
 
 
+void camera_node_class_tick(engine_node_base_t *camera_node_base, mp_obj_t dt_s_obj){
+    engine_camera_node_class_obj_t *camera_node = camera_node_base->node;
+    node_base_call_tick_cb(camera_node_base, camera_node->tick_cb, dt_s_obj);
+}
+
+
 // Return `true` if handled loading the attr from internal structure, `false` otherwise
 bool camera_node_load_attr(engine_node_base_t *self_node_base, qstr attribute, mp_obj_t *destination){
     // Get the underlying structure
@@ -515,8 +523,11 @@ void engine_camera_draw_for_each(void (*draw_cb)(mp_obj_t, mp_obj_t), engine_nod
 
     while(current_camera_list_node != NULL){
         engine_node_base_t *camera_node_base = current_camera_list_node->object;
-        
-        draw_cb(node_base, camera_node_base);
+
+        // Only used to render into textures
+        if(engine_objects_is_layer_offscreen(camera_node_base->layer) == false){
+            draw_cb(node_base, camera_node_base);
+        }
 
         current_camera_list_node = current_camera_list_node->next;
     }
@@ -547,6 +558,75 @@ void engine_camera_transform_2d(mp_obj_t camera_node, float *px, float *py, floa
 }
 
 
+
+static uint32_t engine_camera_culled_count = 0;
+static uint32_t engine_camera_drawn_count = 0;
+
+
+bool engine_camera_2d_is_on_screen(float px, float py, float half_width, float half_height, float rotation){
+    half_width = fabsf(half_width);
+    half_height = fabsf(half_height);
+
+    // Axis aligned half extents of the rotated box
+    if(engine_math_compare_floats(rotation, 0.0f) == false){
+        float abs_sin = fabsf(sinf(rotation));
+        float abs_cos = fabsf(cosf(rotation));
+        float rotated_half_width  = half_width*abs_cos + half_height*abs_sin;
+        float rotated_half_height = half_width*abs_sin + half_height*abs_cos;
+        half_width = rotated_half_width;
+        half_height = rotated_half_height;
+    }
+
+    // Pad by a pixel to cover flooring the center and the
+    // rasterizers rounding their bounding box outwards
+    half_width += 1.0f;
+    half_height += 1.0f;
+
+    // Only the part of the screen (or texture) being drawn to
+    const engine_draw_clip_t *clip = engine_draw_get_clip();
+
+    bool off_screen = px + half_width < clip->x0 || px - half_width >= clip->x1 ||
+                      py + half_height < clip->y0 || py - half_height >= clip->y1;
+
+    // Damage is only tracked for the screen, not textures being rendered to
+    if(engine_draw_is_offscreen()){
+        return off_screen == false;
+    }
+
+    // While measuring damage only report where the node is, never draw
+    if(engine_display_damage_is_measuring()){
+        if(off_screen == false){
+            engine_display_damage_report(px - half_width, py - half_height, px + half_width, py + half_height);
+        }
+        return false;
+    }
+
+    // Partial frames only redraw what touches the damaged rectangles
+    if(off_screen || engine_display_damage_intersects(px - half_width, py - half_height, px + half_width, py + half_height) == false){
+        engine_camera_culled_count++;
+        return false;
+    }
+
+    engine_camera_drawn_count++;
+    return true;
+}
+
+
+void engine_camera_reset_cull_stats(){
+    engine_camera_culled_count = 0;
+    engine_camera_drawn_count = 0;
+}
+
+
+uint32_t engine_camera_get_culled_count(){
+    return engine_camera_culled_count;
+}
+
+
+uint32_t engine_camera_get_drawn_count(){
+    return engine_camera_drawn_count;
+}
+
 // Class attributes
 static const mp_rom_map_elem_t camera_node_class_locals_dict_table[] = {
 
@@ -49,4 +49,23 @@ void engine_camera_draw_for_each(void (*draw_cb)(mp_obj_t, mp_obj_t), engine_nod
 // Scale passed position and rotation due to camera zoom and rotation
 void engine_camera_transform_2d(mp_obj_t camera_node, float *px, float *py, float *rotation);
 
+// Conservative test if a box centered at 'px, py' in screen space, with
+// half extents already scaled by inherited scale and camera zoom and
+// rotated by 'rotation' radians, touches the screen. 2D nodes call this
+// before rasterizing so that off-screen nodes cost almost nothing.
+// Counts towards the culled/drawn stats of the current draw pass.
+// While measuring damage (see 'display/engine_display_damage.h') it
+// reports the box instead and always returns false. On partial frames
+// boxes that don't touch the damaged rectangles are culled too
+bool engine_camera_2d_is_on_screen(float px, float py, float half_width, float half_height, float rotation);
+
+// Culled/drawn 2D node counters (one count per node per camera).
+// Reset at the start of each draw pass so that between frames they
+// hold the counts of the last drawn frame
+void engine_camera_reset_cull_stats();
+uint32_t engine_camera_get_culled_count();
+uint32_t engine_camera_get_drawn_count();
+
+void camera_node_class_tick(engine_node_base_t *camera_node_base, mp_obj_t dt_s_obj);
+
 #endif  // CAMERA_NODE_H
\ No newline at end of file
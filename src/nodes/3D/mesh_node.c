@@ -375,6 +375,12 @@ void mesh_node_class_draw(mp_obj_t mesh_node_base_obj, mp_obj_t camera_node){
 }
 
 
+void mesh_node_class_tick(engine_node_base_t *mesh_node_base, mp_obj_t dt_s_obj){
+    engine_mesh_node_class_obj_t *mesh_node = mesh_node_base->node;
+    node_base_call_tick_cb(mesh_node_base, mesh_node->tick_cb, dt_s_obj);
+}
+
+
 // Return `true` if handled loading the attr from internal structure, `false` otherwise
 bool mesh_load_attr(engine_node_base_t *self_node_base, qstr attribute, mp_obj_t *destination){
     // Get the underlying structure
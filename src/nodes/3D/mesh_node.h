@@ -32,5 +32,6 @@ typedef struct{
 
 extern const mp_obj_type_t engine_mesh_node_class_type;
 void mesh_node_class_draw(mp_obj_t mesh_node_base_obj, mp_obj_t camera_node);
+void mesh_node_class_tick(engine_node_base_t *mesh_node_base, mp_obj_t dt_s_obj);
 
 #endif  // MESH_NODE_H
\ No newline at end of file
@@ -32,6 +32,9 @@ void voxelspace_node_class_draw(mp_obj_t voxelspace_node_base_obj, mp_obj_t came
 
     engine_voxelspace_node_class_obj_t *voxelspace_node = voxelspace_node_base->node;
 
+    // Drawn from the camera's position, moving it doesn't move what's drawn
+    engine_draw_set_not_shift_exact();
+
     texture_resource_class_obj_t *texture = voxelspace_node->texture_resource;
     texture_resource_class_obj_t *heightmap = voxelspace_node->heightmap_resource;
 
@@ -282,6 +285,12 @@ static mp_obj_t voxelspace_node_class_get_abs_height(mp_obj_t self, mp_obj_t x_o
 MP_DEFINE_CONST_FUN_OBJ_3(voxelspace_node_class_get_abs_height_obj, voxelspace_node_class_get_abs_height);
 
 
+void voxelspace_node_class_tick(engine_node_base_t *voxelspace_node_base, mp_obj_t dt_s_obj){
+    engine_voxelspace_node_class_obj_t *voxelspace_node = voxelspace_node_base->node;
+    node_base_call_tick_cb(voxelspace_node_base, voxelspace_node->tick_cb, dt_s_obj);
+}
+
+
 // Return `true` if handled loading the attr from internal structure, `false` otherwise
 bool voxelspace_node_load_attr(engine_node_base_t *self_node_base, qstr attribute, mp_obj_t *destination){
     // Get the underlying structure
@@ -21,5 +21,6 @@ typedef struct{
 
 extern const mp_obj_type_t engine_voxelspace_node_class_type;
 void voxelspace_node_class_draw(mp_obj_t voxelspace_node_base_obj, mp_obj_t camera_node);
+void voxelspace_node_class_tick(engine_node_base_t *voxelspace_node_base, mp_obj_t dt_s_obj);
 
 #endif  // VOXELSPACE_NODE_H
\ No newline at end of file
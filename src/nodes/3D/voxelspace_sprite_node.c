@@ -269,6 +269,12 @@ void voxelspace_sprite_node_class_draw(mp_obj_t sprite_node_base_obj, mp_obj_t c
 }
 
 
+void voxelspace_sprite_node_class_tick(engine_node_base_t *sprite_node_base, mp_obj_t dt_s_obj){
+    engine_voxelspace_sprite_node_class_obj_t *voxelspace_sprite_node = sprite_node_base->node;
+    node_base_call_tick_cb(sprite_node_base, voxelspace_sprite_node->tick_cb, dt_s_obj);
+}
+
+
 // Return `true` if handled loading the attr from internal structure, `false` otherwise
 bool voxelspace_sprite_node_load_attr(engine_node_base_t *self_node_base, qstr attribute, mp_obj_t *destination){
     // Get the underlying structure
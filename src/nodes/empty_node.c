@@ -7,6 +7,12 @@
 #include "math/vector3.h"
 
 
+void empty_node_class_tick(engine_node_base_t *empty_node_base, mp_obj_t dt_s_obj){
+    engine_empty_node_class_obj_t *empty_node = empty_node_base->node;
+    node_base_call_tick_cb(empty_node_base, empty_node->tick_cb, dt_s_obj);
+}
+
+
 // Return `true` if handled loading the attr from internal structure, `false` otherwise
 bool empty_node_load_attr(engine_node_base_t *self_node_base, qstr attribute, mp_obj_t *destination){
     engine_empty_node_class_obj_t *self = self_node_base->node;
@@ -2,6 +2,7 @@
 #define EMPTY_NODE_H
 
 #include "py/obj.h"
+#include "nodes/node_base.h"
 
 // A node that doesn't do anything or has a position.
 // This can be used in games when there is only a need
@@ -14,4 +15,6 @@ typedef struct{
 
 extern const mp_obj_type_t engine_empty_node_class_type;
 
+void empty_node_class_tick(engine_node_base_t *empty_node_base, mp_obj_t dt_s_obj);
+
 #endif  // EMPTY_NODE_H
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "utility/engine_mp.h"
 #include "py/misc.h"
 #include "engine_collections.h"
+#include "draw/engine_draw_static.h"
 
 
 /*  --- doc ---
@@ -29,13 +30,29 @@
 void (*default_instance_attr_func)(mp_obj_t self_in, qstr attribute, mp_obj_t *destination) = NULL;
 
 
-void node_base_init(engine_node_base_t *node_base, const mp_obj_type_t *mp_type, uint8_t node_type, uint8_t layer){
+// Layers are stored as `uint8_t`, check before a layer like 300 becomes 44
+static void node_base_check_layer(mp_int_t layer){
+    if(layer < 0 || layer >= engine_objects_get_layer_count()){
+        mp_raise_msg_varg(&mp_type_ValueError, MP_ERROR_TEXT("Layer must be between 0 and %d"), engine_objects_get_layer_count()-1);
+    }
+}
+
+
+void node_base_init(engine_node_base_t *node_base, const mp_obj_type_t *mp_type, uint8_t node_type, mp_int_t layer){
+    node_base_check_layer(layer);
+
     node_base->base.type = mp_type;
     node_base->layer = layer;
     node_base->type = node_type;
     node_base->object_list_node = engine_add_object_to_layer(node_base, node_base->layer);
     node_base->deletable_list_node = NULL;
     node_base->parent_node_base = NULL;
+    node_base->local_2d_epoch = 0;
+    node_base->world_2d_epoch = 0;
+    node_base->drawn_bounds = (engine_display_rect_t){0, 0, 0, 0};
+    node_base->drawn_opacity = 0.0f;
+    node_base->drawn_world_2d = (engine_inheritable_2d_t){0};
+    node_base->damaged = true;
     node_base_set_if_visible(node_base, true);
     node_base_set_if_disabled(node_base, false);
     node_base_set_if_just_added(node_base, true);
@@ -197,6 +214,9 @@ mp_obj_t node_base_del(mp_obj_t self_in){
         }
     }
 
+    // Whatever was drawn there last needs to be cleared
+    engine_display_damage_add(node_base->drawn_bounds);
+
     engine_remove_object_from_layer(node_base->object_list_node, node_base->layer);
     engine_collections_untrack_deletable(node_base->deletable_list_node);
 
@@ -378,77 +398,140 @@ mp_obj_t node_base_get_parent(mp_obj_t self_in){
 }
 
 
-void node_base_set_layer(engine_node_base_t *node_base, uint8_t layer){
+void node_base_set_layer(engine_node_base_t *node_base, mp_int_t layer){
+    node_base_check_layer(layer);
+
+    // Add to the new layer first so that the node stays tracked
+    // in its old layer if the new layer index is out of bounds
+    linked_list_node *object_list_node = engine_add_object_to_layer(node_base, layer);
     engine_remove_object_from_layer(node_base->object_list_node, node_base->layer);
     node_base->layer = layer;
-    node_base->object_list_node = engine_add_object_to_layer(node_base, node_base->layer);
+    node_base->object_list_node = object_list_node;
 }
 
 
-void node_base_inherit_2d(mp_obj_t child_node_base, engine_inheritable_2d_t *inheritable){
-    engine_node_base_t *node_base = child_node_base;
+void node_base_call_tick_cb(engine_node_base_t *node_base, mp_obj_t tick_cb, mp_obj_t dt_s_obj){
+    if(tick_cb != mp_const_none){
+        mp_obj_t exec[3];
+        exec[0] = tick_cb;
+        exec[1] = node_base->attr_accessor;
+        exec[2] = dt_s_obj;
+        mp_call_method_n_kw(1, 0, exec);
+    }
+}
+
+
+// Incremented at the start of every draw pass. Nodes start with an
+// epoch of 0 so their caches are never valid until resolved once
+static uint32_t node_base_transform_cache_epoch = 0;
+static bool node_base_transform_cache_active = false;
+
+
+void node_base_transform_cache_begin(){
+    node_base_transform_cache_epoch++;
 
-    // Init structure
-    mp_obj_t child_position = mp_load_attr(node_base->attr_accessor, MP_QSTR_position);
-    mp_obj_t child_rotation = engine_mp_load_attr_maybe(node_base->attr_accessor, MP_QSTR_rotation);
-    mp_obj_t child_scale =    engine_mp_load_attr_maybe(node_base->attr_accessor, MP_QSTR_scale);
-
-    // Setup initial position (no nodes have 1D position)
-    if(mp_obj_is_type(child_position, &vector3_class_type)){
-        inheritable->px = ((vector3_class_obj_t*)child_position)->x.value;
-        inheritable->py = ((vector3_class_obj_t*)child_position)->y.value;
-    }else if(mp_obj_is_type(child_position, &vector2_class_type)){
-        inheritable->px = ((vector2_class_obj_t*)child_position)->x.value;
-        inheritable->py = ((vector2_class_obj_t*)child_position)->y.value;
+    if(node_base_transform_cache_epoch == 0){
+        node_base_transform_cache_epoch = 1;
+    }
+
+    node_base_transform_cache_active = true;
+}
+
+
+void node_base_transform_cache_end(){
+    node_base_transform_cache_active = false;
+}
+
+
+// Decodes only this node's own position, rotation, scale,
+// and opacity attributes (nothing from parents)
+static void node_base_decode_local_2d(engine_node_base_t *node_base, engine_inheritable_2d_t *local){
+    mp_obj_t position = mp_load_attr(node_base->attr_accessor, MP_QSTR_position);
+    mp_obj_t rotation = engine_mp_load_attr_maybe(node_base->attr_accessor, MP_QSTR_rotation);
+    mp_obj_t scale =    engine_mp_load_attr_maybe(node_base->attr_accessor, MP_QSTR_scale);
+
+    // Position (no nodes have 1D position, use projection
+    // of 3D position for respective 2D position)
+    if(mp_obj_is_type(position, &vector3_class_type)){
+        local->px = ((vector3_class_obj_t*)position)->x.value;
+        local->py = ((vector3_class_obj_t*)position)->y.value;
+    }else if(mp_obj_is_type(position, &vector2_class_type)){
+        local->px = ((vector2_class_obj_t*)position)->x.value;
+        local->py = ((vector2_class_obj_t*)position)->y.value;
     }else{
-        mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("NodeBase: Error: Do not know how to set initial inherit 2D position for this `position `object type!, got %s"), mp_obj_get_type_str(child_position));
-    }
-
-    // Setup initial rotation (no nodes have 2D rotation)
-    if(child_rotation == MP_OBJ_NULL){
-        inheritable->rotation = 0.0f;
-    }else if(mp_obj_is_type(child_rotation, &vector3_class_type)){
-        inheritable->rotation = ((vector3_class_obj_t*)child_rotation)->z.value;
-    }else if(mp_obj_is_float(child_rotation)){
-        inheritable->rotation = (float)mp_obj_get_float(child_rotation);
-    }else if(mp_obj_is_int(child_rotation)){
-        inheritable->rotation = (float)mp_obj_get_int(child_rotation);
+        mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("NodeBase: Error: Do not know how to get inherit 2D position for this `position `object type!, got %s"), mp_obj_get_type_str(position));
+    }
+
+    // Rotation (no nodes have 2D rotation, use z-axis rotation of 3D nodes)
+    if(rotation == MP_OBJ_NULL){
+        local->rotation = 0.0f;
+    }else if(mp_obj_is_type(rotation, &vector3_class_type)){
+        local->rotation = ((vector3_class_obj_t*)rotation)->z.value;
+    }else if(mp_obj_is_float(rotation)){
+        local->rotation = (float)mp_obj_get_float(rotation);
+    }else if(mp_obj_is_int(rotation)){
+        local->rotation = (float)mp_obj_get_int(rotation);
     }else{
-        mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("NodeBase: Error: Do not know how to set initial inherit 2D rotation for this `rotation` object type!, got %s"), mp_obj_get_type_str(child_rotation));
-    }
-
-    // Setup initial scale (some nodes, like circles, have 1D scale)
-    if(child_scale == MP_OBJ_NULL){
-        inheritable->sx = 1.0f;
-        inheritable->sy = 1.0f;
-    }else if(mp_obj_is_type(child_scale, &vector3_class_type)){
-        inheritable->sx = ((vector3_class_obj_t*)child_scale)->x.value;
-        inheritable->sy = ((vector3_class_obj_t*)child_scale)->y.value;
-    }else if(mp_obj_is_type(child_scale, &vector2_class_type)){
-        inheritable->sx = ((vector2_class_obj_t*)child_scale)->x.value;
-        inheritable->sy = ((vector2_class_obj_t*)child_scale)->y.value;
-    }else if(mp_obj_is_float(child_scale)){
-        float scale = mp_obj_get_float(child_scale);
-        inheritable->sx = scale;
-        inheritable->sy = scale;
-    }else if(mp_obj_is_int(child_scale)){
-        float scale = (float)mp_obj_get_int(child_scale);
-        inheritable->sx = scale;
-        inheritable->sy = scale;
+        mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("NodeBase: Error: Do not know how to get inherit 2D rotation for this `rotation` object type!, got %s"), mp_obj_get_type_str(rotation));
+    }
+
+    // Scale (some nodes, like circles, have 1D scale, use xy of 3D scale)
+    if(scale == MP_OBJ_NULL){
+        local->sx = 1.0f;
+        local->sy = 1.0f;
+    }else if(mp_obj_is_type(scale, &vector3_class_type)){
+        local->sx = ((vector3_class_obj_t*)scale)->x.value;
+        local->sy = ((vector3_class_obj_t*)scale)->y.value;
+    }else if(mp_obj_is_type(scale, &vector2_class_type)){
+        local->sx = ((vector2_class_obj_t*)scale)->x.value;
+        local->sy = ((vector2_class_obj_t*)scale)->y.value;
+    }else if(mp_obj_is_float(scale)){
+        float uniform_scale = mp_obj_get_float(scale);
+        local->sx = uniform_scale;
+        local->sy = uniform_scale;
+    }else if(mp_obj_is_int(scale)){
+        float uniform_scale = (float)mp_obj_get_int(scale);
+        local->sx = uniform_scale;
+        local->sy = uniform_scale;
     }else{
-        mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("NodeBase: Error: Do not know how to set initial inherit 2D scale for this `scale `object type, got %s!"), mp_obj_get_type_str(child_scale));
+        mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("NodeBase: Error: Do not know how to get inherit 2D scale for this `scale `object type, got %s!"), mp_obj_get_type_str(scale));
     }
 
-    // Setup initial opacity and `is camera child`
-    // flag (most nodes use single float for opacity,
+    // Opacity (most nodes use single float for opacity,
     // except for things like physics and voxelspace)
-    mp_obj_t child_opacity_obj = engine_mp_load_attr_maybe(node_base->attr_accessor, MP_QSTR_opacity);
-    inheritable->opacity = 1.0f;
-    if(child_opacity_obj != MP_OBJ_NULL){
-        inheritable->opacity = mp_obj_get_float(child_opacity_obj);
+    mp_obj_t opacity = engine_mp_load_attr_maybe(node_base->attr_accessor, MP_QSTR_opacity);
+    local->opacity = 1.0f;
+    if(opacity != MP_OBJ_NULL){
+        local->opacity = mp_obj_get_float(opacity);
     }
-    
-    inheritable->is_camera_child = false;
+
+    local->is_camera_child = false;
+}
+
+
+// Returns this node's decoded attributes, from the node's cache if
+// they were already decoded this draw pass, otherwise into 'scratch'
+// (or into the cache during a draw pass)
+static engine_inheritable_2d_t *node_base_get_local_2d(engine_node_base_t *node_base, engine_inheritable_2d_t *scratch){
+    if(node_base_transform_cache_active == false){
+        node_base_decode_local_2d(node_base, scratch);
+        return scratch;
+    }
+
+    if(node_base->local_2d_epoch != node_base_transform_cache_epoch){
+        node_base_decode_local_2d(node_base, &node_base->local_2d);
+        node_base->local_2d_epoch = node_base_transform_cache_epoch;
+    }
+
+    return &node_base->local_2d;
+}
+
+
+static void node_base_resolve_2d(engine_node_base_t *node_base, engine_inheritable_2d_t *inheritable){
+    // Setup initial position, rotation, scale, opacity
+    // and `is camera child` flag from the child itself
+    engine_inheritable_2d_t scratch;
+    *inheritable = *node_base_get_local_2d(node_base, &scratch);
 
     // Before doing anything else, check if this child
     // even has a parent (still needed to ensure struct
@@ -508,85 +591,17 @@ void node_base_inherit_2d(mp_obj_t child_node_base, engine_inheritable_2d_t *inh
             break;
         }
 
-        // Setup temps that are re-used in multiple ways
-        float temp_parent_pos_x = 0.0f;
-        float temp_parent_pos_y = 0.0f;
-        float temp_parent_rot = 0.0f;
-        float temp_parent_scale_x = 1.0f;
-        float temp_parent_scale_y = 1.0f;
-        float temp_parent_opacity = 1.0f;
-
-        // Get position from parent
-        if(stop_inheriting_position == false){
-            mp_obj_t parent_position = mp_load_attr(parent_node_base->attr_accessor, MP_QSTR_position);
-
-            // Decode parent position (use projection of 3D position
-            // for respective 2D position that child will rotate around)
-            if(mp_obj_is_type(parent_position, &vector3_class_type)){
-                temp_parent_pos_x = ((vector3_class_obj_t*)parent_position)->x.value;
-                temp_parent_pos_y = ((vector3_class_obj_t*)parent_position)->y.value;
-            }else if(mp_obj_is_type(parent_position, &vector2_class_type)){
-                temp_parent_pos_x = ((vector2_class_obj_t*)parent_position)->x.value;
-                temp_parent_pos_y = ((vector2_class_obj_t*)parent_position)->y.value;
-            }else{
-                mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("NodeBase: Error: Do not know how to get inherited 2D position for this `position `object type! got, %s"), mp_obj_get_type_str(parent_position));
-            }
-        }
-
-        // Get rotation from parent
-        if(stop_inheriting_rotation == false){
-            mp_obj_t parent_rotation = engine_mp_load_attr_maybe(parent_node_base->attr_accessor, MP_QSTR_rotation);
-
-            // Decode parent rotation (use z-axis rotation of 3D node
-            // for rotation around parent for 2D child node)
-            if(parent_rotation == MP_OBJ_NULL){
-                temp_parent_rot = 0.0f;
-            }else if(mp_obj_is_type(parent_rotation, &vector3_class_type)){
-                temp_parent_rot = ((vector3_class_obj_t*)parent_rotation)->z.value;
-            }else if(mp_obj_is_float(parent_rotation)){
-                temp_parent_rot = mp_obj_get_float(parent_rotation);
-            }else if(mp_obj_is_int(parent_rotation)){
-                inheritable->rotation = (float)mp_obj_get_int(parent_rotation);
-            }else{
-                mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("NodeBase: Error: Do not know how to get inherited 2D rotation for this `rotation `object type! got, %s"), mp_obj_get_type_str(parent_rotation));
-            }
-        }
-
-        // Get scale from parent
-        if(stop_inheriting_scale == false){
-            mp_obj_t parent_scale = engine_mp_load_attr_maybe(parent_node_base->attr_accessor, MP_QSTR_scale);
-
-            // Decode parent scale (use xy of 3D for 2D scale)
-            if(parent_scale == MP_OBJ_NULL){
-                temp_parent_scale_x = 1.0f;
-                temp_parent_scale_y = 1.0f;
-            }else if(mp_obj_is_type(parent_scale, &vector3_class_type)){
-                temp_parent_scale_x = ((vector3_class_obj_t*)parent_scale)->x.value;
-                temp_parent_scale_y = ((vector3_class_obj_t*)parent_scale)->y.value;
-            }else if(mp_obj_is_type(parent_scale, &vector2_class_type)){
-                temp_parent_scale_x = ((vector2_class_obj_t*)parent_scale)->x.value;
-                temp_parent_scale_y = ((vector2_class_obj_t*)parent_scale)->y.value;
-            }else if(mp_obj_is_float(parent_scale)){
-                float scale = mp_obj_get_float(parent_scale);
-                temp_parent_scale_x = scale;
-                temp_parent_scale_y = scale;
-            }else if(mp_obj_is_int(parent_scale)){
-                float scale = (float)mp_obj_get_int(parent_scale);
-                temp_parent_scale_x = scale;
-                temp_parent_scale_y = scale;
-            }else{
-                mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("NodeBase: Error: Do not know how to get inherited 2D scale for this `scale `object type! got, %s"), mp_obj_get_type_str(parent_scale));
-            }
-        }
-
-        // Get opacity from parent
-        if(stop_inheriting_opacity == false){
-            mp_obj_t parent_opacity_obj = engine_mp_load_attr_maybe(parent_node_base->attr_accessor, MP_QSTR_opacity);
+        // Parent attributes (decoded once per draw pass when
+        // shared by many children), ignoring those not inherited
+        engine_inheritable_2d_t parent_scratch;
+        engine_inheritable_2d_t *parent_local = node_base_get_local_2d(parent_node_base, &parent_scratch);
 
-            if(parent_opacity_obj != MP_OBJ_NULL){
-                temp_parent_opacity = mp_obj_get_float(parent_opacity_obj);
-            }
-        }
+        float temp_parent_pos_x =   stop_inheriting_position ? 0.0f : parent_local->px;
+        float temp_parent_pos_y =   stop_inheriting_position ? 0.0f : parent_local->py;
+        float temp_parent_rot =     stop_inheriting_rotation ? 0.0f : parent_local->rotation;
+        float temp_parent_scale_x = stop_inheriting_scale    ? 1.0f : parent_local->sx;
+        float temp_parent_scale_y = stop_inheriting_scale    ? 1.0f : parent_local->sy;
+        float temp_parent_opacity = stop_inheriting_opacity  ? 1.0f : parent_local->opacity;
 
         // Scale transformation due to parent scale
         engine_math_scale_point(&inheritable->px, &inheritable->py, 0, 0, temp_parent_scale_x, temp_parent_scale_y);
@@ -606,6 +621,26 @@ void node_base_inherit_2d(mp_obj_t child_node_base, engine_inheritable_2d_t *inh
 }
 
 
+void node_base_inherit_2d(mp_obj_t child_node_base, engine_inheritable_2d_t *inheritable){
+    engine_node_base_t *node_base = child_node_base;
+
+    // Nothing can move during a draw pass, so a node drawn by
+    // multiple cameras or a camera used to transform every node
+    // only needs to be resolved once
+    if(node_base_transform_cache_active == false){
+        node_base_resolve_2d(node_base, inheritable);
+        return;
+    }
+
+    if(node_base->world_2d_epoch != node_base_transform_cache_epoch){
+        node_base_resolve_2d(node_base, &node_base->world_2d);
+        node_base->world_2d_epoch = node_base_transform_cache_epoch;
+    }
+
+    *inheritable = node_base->world_2d;
+}
+
+
 void node_base_set_attr_handler_default(mp_obj_t node_instance){
     if(default_instance_attr_func != NULL) MP_OBJ_TYPE_SET_SLOT((mp_obj_type_t*)((mp_obj_base_t*)node_instance)->type, attr, default_instance_attr_func, 5);
 }
@@ -771,7 +806,18 @@ void node_base_attr_handler(mp_obj_t self, qstr attr, mp_obj_t *dest,
         // If handled, stop
         if(attr_handled){
             // If this was a store operation, mark it as a success
-            if(is_store) dest[0] = MP_OBJ_NULL;
+            // and redraw the node next frame (cameras change everything)
+            if(is_store){
+                dest[0] = MP_OBJ_NULL;
+                node_base->damaged = true;
+
+                if(node_base->type == NODE_TYPE_CAMERA){
+                    engine_display_damage_invalidate();
+                }else if(engine_objects_is_layer_static(node_base->layer)){
+                    // The static layer cache notices cameras moving on its own
+                    engine_draw_static_invalidate();
+                }
+            }
             return;
         }
     }
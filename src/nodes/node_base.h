@@ -4,6 +4,7 @@
 #include "py/obj.h"
 #include "utility/bits.h"
 #include "utility/linked_list.h"
+#include "display/engine_display_damage.h"
 
 #define NODE_BASE_VISIBLE_BIT_INDEX 0
 #define NODE_BASE_DISABLED_BIT_INDEX 1
@@ -14,6 +15,21 @@
 #define NODE_BASE_INHERIT_POSITION_BIT_INDEX 6
 #define NODE_BASE_INHERIT_ROTATION_BIT_INDEX 7
 
+// Common data that 2D nodes inherit
+typedef struct{
+    float px;
+    float py;
+
+    float rotation;
+
+    float sx;
+    float sy;
+
+    float opacity;
+    bool is_camera_child;
+}engine_inheritable_2d_t;
+
+
 typedef struct{
     mp_obj_base_t base;                     // All nodes get defined by what is placed in this
     linked_list_node *object_list_node;     // Pointer to where this node is stored in the layers of linked lists the engine tracks (used for easy linked list deletion)
@@ -27,25 +43,20 @@ typedef struct{
     linked_list children_node_bases;                // Linked list of child node_bases
     void *parent_node_base;                         // If this is a child, pointer to parent node_base (can only have one parent)
     linked_list_node *location_in_parents_children; // The location of this node in the parents linked list of children (used for easy deletion upon garbage collection of this node)
-}engine_node_base_t;
 
+    uint32_t local_2d_epoch;                // Draw pass 'local_2d' was decoded in (see 'node_base_transform_cache_begin()')
+    uint32_t world_2d_epoch;                // Draw pass 'world_2d' was resolved in
+    engine_inheritable_2d_t local_2d;       // This node's own decoded 2D position, rotation, scale, and opacity (no parents)
+    engine_inheritable_2d_t world_2d;       // Result of 'node_base_inherit_2d()' for this node
 
-// Common data that 2D nodes inherit
-typedef struct{
-    float px;
-    float py;
-
-    float rotation;
-
-    float sx;
-    float sy;
-
-    float opacity;
-    bool is_camera_child;
-}engine_inheritable_2d_t;
+    engine_display_rect_t drawn_bounds;     // Screen area this node covered last measured frame (see 'engine_display_damage.h')
+    float drawn_opacity;                    // Inherited opacity this node had last measured frame
+    engine_inheritable_2d_t drawn_world_2d; // 'world_2d' this node had last measured frame (where the world origin was on screen for cameras)
+    bool damaged;                           // Set when an attribute is stored so the node is redrawn even if its bounds didn't change
+}engine_node_base_t;
 
 
-void node_base_init(engine_node_base_t *node_base, const mp_obj_type_t *mp_type, uint8_t node_type, uint8_t layer);
+void node_base_init(engine_node_base_t *node_base, const mp_obj_type_t *mp_type, uint8_t node_type, mp_int_t layer);
 
 bool node_base_is_visible(engine_node_base_t *node_base);
 void node_base_set_if_visible(engine_node_base_t *node_base, bool is_visible);
@@ -102,9 +113,25 @@ static MP_DEFINE_CONST_FUN_OBJ_2(node_base_remove_child_obj, node_base_remove_ch
 mp_obj_t node_base_get_parent(mp_obj_t self_in);
 static MP_DEFINE_CONST_FUN_OBJ_1(node_base_get_parent_obj, node_base_get_parent);
 
-// Fills 'inheritable' with data from parents and child
+// Fills 'inheritable' with data from parents and child. Outside of a
+// draw pass this loads the attributes of the node and every ancestor
+// again on every call
 void node_base_inherit_2d(mp_obj_t child_node_base, engine_inheritable_2d_t *inheritable);
 
+// Between these calls, 'node_base_inherit_2d()' decodes each node's
+// attributes once and resolves each node's world transform once, shared
+// by every camera and by the damage measuring and drawing passes. Only
+// valid while no Python code can move nodes (the draw pass). Nothing is
+// kept across frames: every node (and ancestor) is decoded again in each
+// draw pass even if it didn't move, nodes are never marked dirty since
+// positions change in place through shared vectors, physics and tweens
+void node_base_transform_cache_begin();
+void node_base_transform_cache_end();
+
+// Calls the node's overridable `tick(self, dt)` callback, if one is set.
+// `dt_s_obj` is the float object shared by all nodes for this frame
+void node_base_call_tick_cb(engine_node_base_t *node_base, mp_obj_t tick_cb, mp_obj_t dt_s_obj);
+
 void node_base_set_attr_handler_default(mp_obj_t node_instance);
 void node_base_use_default_attr_handler(mp_obj_t self_in, qstr attribute, mp_obj_t *destination);
 
@@ -21,4 +21,7 @@
 #define NODE_TYPE_GUI_BUTTON_2D         12
 #define NODE_TYPE_GUI_BITMAP_BUTTON_2D  13
 
+// Number of node types above (size of per-type tables indexed by `NODE_TYPE_*`)
+#define NODE_TYPE_COUNT                 14
+
 #endif  // NODE_TYPES_H
\ No newline at end of file
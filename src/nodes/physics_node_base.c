@@ -62,6 +62,12 @@ mp_obj_t physics_node_base_disable_layer(mp_obj_t self_in, mp_obj_t layer_in){
 static MP_DEFINE_CONST_FUN_OBJ_2(physics_node_base_disable_layer_obj, physics_node_base_disable_layer);
 
 
+void physics_node_base_class_tick(engine_node_base_t *node_base, mp_obj_t dt_s_obj){
+    engine_physics_node_base_t *physics_node_base = node_base->node;
+    node_base_call_tick_cb(node_base, physics_node_base->tick_cb, dt_s_obj);
+}
+
+
 // Return `true` if handled loading the attr from internal structure, `false` otherwise
 bool physics_node_base_load_attr(engine_node_base_t *self_node_base, qstr attribute, mp_obj_t *destination){
     engine_physics_node_base_t *self = self_node_base->node;
@@ -58,5 +58,8 @@ bool physics_node_base_load_attr(engine_node_base_t *self_node_base, qstr attrib
 // Return `true` if handled storing the attr from internal structure, `false` otherwise
 bool physics_node_base_store_attr(engine_node_base_t *self_node_base, qstr attribute, mp_obj_t *destination);
 
+// Shared `tick` callback dispatch for all physics node types
+void physics_node_base_class_tick(engine_node_base_t *node_base, mp_obj_t dt_s_obj);
+
 
 #endif  // PHYSICS_NODE_BASE_H
\ No newline at end of file
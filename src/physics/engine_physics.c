@@ -14,6 +14,7 @@
 #include "utility/engine_time.h"
 #include "engine.h"
 #include "engine_collections.h"
+#include "engine_main.h"
 #include "engine_physics_module.h"
 
 // Bit array/collection to track nodes that have collided. In the `init` function
@@ -26,14 +27,14 @@ const float slop = 0.1f;   // usually 0.01 to 0.1
 
 // https://code.tutsplus.com/how-to-create-a-custom-2d-physics-engine-the-core-engine--gamedev-7493t#timestepping:~:text=Here%20is%20a%20full%20example%3A
 float time_accumulator = 0.0f;
-uint32_t frame_start_ms = 0;
+uint32_t frame_start_us = 0;
 
 
 void engine_physics_init(){
     ENGINE_INFO_PRINTF("EnginePhysics: Starting...")
     engine_physics_ids_init();
     engine_bit_collection_create(&collided_physics_nodes, engine_physics_ids_get_pair_index(PHYSICS_ID_MAX, PHYSICS_ID_MAX));
-    frame_start_ms = millis();
+    frame_start_us = micros();
 }
 
 
@@ -385,7 +386,7 @@ void engine_physics_update(float dt){
 }
 
 
-void engine_physics_physics_tick(float dt_s){
+void engine_physics_physics_tick(mp_obj_t dt_obj){
     mp_obj_t exec[3];
 
     // Loop through all nodes and call their physics_tick callbacks
@@ -398,7 +399,7 @@ void engine_physics_physics_tick(float dt_s){
         if(physics_node_base->physics_tick_cb != mp_const_none){
             exec[0] = physics_node_base->physics_tick_cb;
             exec[1] = node_base->attr_accessor;
-            exec[2] = mp_obj_new_float(dt_s);
+            exec[2] = dt_obj;
             mp_call_method_n_kw(1, 0, exec);
         }
 
@@ -420,13 +421,21 @@ void engine_physics_tick(){
 
     const float alpha = time_accumulator / engine_fps_limit_period_ms;
 
-    const uint32_t current_time_ms = millis();
+    const uint32_t current_time_us = micros();
 
     // Store the time elapsed since the last frame began
-    time_accumulator += millis_diff(current_time_ms, frame_start_ms);
+    #if defined(__unix__)
+        if(engine_headless){
+            time_accumulator += engine_headless_dt_ms;
+        }else{
+            time_accumulator += (float)micros_diff(current_time_us, frame_start_us) * 0.001f;
+        }
+    #else
+        time_accumulator += (float)micros_diff(current_time_us, frame_start_us) * 0.001f;
+    #endif
 
     // Record the starting of this frame
-    frame_start_ms = current_time_ms;
+    frame_start_us = current_time_us;
 
     // Avoid spiral of death and clamp dt, thus clamping
     // how many times the update physics can be called in
@@ -435,9 +444,17 @@ void engine_physics_tick(){
         time_accumulator = 30.0f;
     }
 
+    // The step is fixed, only create the float object passed to
+    // every `physics_tick()` once and only if stepping at all
+    mp_obj_t physics_dt_obj = mp_const_none;
+
     while(time_accumulator > engine_fps_limit_period_ms){
+        if(physics_dt_obj == mp_const_none){
+            physics_dt_obj = mp_obj_new_float(engine_fps_limit_period_ms);
+        }
+
         // Call the physics_tick callbacks on all physics nodes first
-        engine_physics_physics_tick(engine_fps_limit_period_ms);
+        engine_physics_physics_tick(physics_dt_obj);
 
         engine_physics_update(engine_fps_limit_period_ms);
         time_accumulator -= engine_fps_limit_period_ms;
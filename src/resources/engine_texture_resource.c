@@ -347,6 +347,7 @@ void create_blank_from_params(texture_resource_class_obj_t *self, mp_obj_t width
     self->data = data;
     self->colors = colors;
     self->bit_depth = blank_bit_depth;
+    self->in_ram = true;
     self->red_mask   = 0b1111100000000000;
     self->green_mask = 0b0000011111100000;
     self->blue_mask  = 0b0000000000011111;
@@ -112,6 +112,27 @@ uint32_t millis_add(uint32_t millis, int32_t delta) {
 }
 
 
+uint32_t micros(){
+    #if defined(__EMSCRIPTEN__)
+        gettimeofday(&tv, NULL);
+        return (uint32_t)(tv.tv_sec * 1000000LL + tv.tv_usec);
+    #elif defined(__unix__)
+        // Monotonic since only used for measuring durations
+        clock_gettime(CLOCK_MONOTONIC, &tp);
+        return (uint32_t)(tp.tv_sec * 1000000LL + tp.tv_nsec / 1000);
+    #elif defined(__arm__)
+        return time_us_32();
+    #endif
+}
+
+
+// Unsigned subtraction handles the wrap around (as long as
+// the two values are less than ~71 minutes apart)
+uint32_t micros_diff(uint32_t end, uint32_t start){
+    return end - start;
+}
+
+
 void cycles_start(){
     #ifdef __unix__
         // Not implemented
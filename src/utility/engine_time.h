@@ -14,6 +14,11 @@ uint32_t millis();
 int32_t millis_diff(uint32_t end, uint32_t start);
 uint32_t millis_add(uint32_t millis, int32_t delta);
 
+// Returns microseconds since some time, wraps around at 2^32. Use
+// `micros_diff()` to get the time between two values
+uint32_t micros();
+uint32_t micros_diff(uint32_t end, uint32_t start);
+
 void cycles_start();
 uint32_t cycles_stop();
 
@@ -2,6 +2,76 @@
 #include "py/obj.h"
 #include "py/misc.h"
 
+// Nodes for all lists come from chunks of `LINKED_LIST_POOL_CHUNK_SIZE`
+// nodes and are recycled through this free list instead of calling
+// malloc/free every time an object is added/removed (e.g. nodes being
+// created and deleted every frame). Chunks are never freed. Free
+// nodes are linked through `previous`
+static linked_list_node *linked_list_free_nodes = NULL;
+
+// Nodes removed while the pool is held (see `linked_list_pool_hold()`)
+// wait here instead of going back on the free list. That way a removed
+// node is not handed out again (and its `next` overwritten) while a loop
+// that is currently on that node still has to step off of it
+static linked_list_node *linked_list_held_nodes = NULL;
+static linked_list_node *linked_list_held_nodes_last = NULL;
+static bool linked_list_pool_held = false;
+
+
+static linked_list_node *linked_list_pool_take(){
+    if(linked_list_free_nodes == NULL){
+        linked_list_node *chunk = malloc(sizeof(linked_list_node) * LINKED_LIST_POOL_CHUNK_SIZE);
+
+        if(chunk == NULL){
+            mp_raise_msg(&mp_type_MemoryError, MP_ERROR_TEXT("Linked List: Could not allocate more list nodes"));
+        }
+
+        // Push in reverse so that nodes are handed out in address order
+        for(int16_t inx=LINKED_LIST_POOL_CHUNK_SIZE-1; inx>=0; inx--){
+            chunk[inx].previous = linked_list_free_nodes;
+            linked_list_free_nodes = &chunk[inx];
+        }
+    }
+
+    linked_list_node *node = linked_list_free_nodes;
+    linked_list_free_nodes = node->previous;
+    return node;
+}
+
+
+static void linked_list_pool_give(linked_list_node *node){
+    if(linked_list_pool_held){
+        if(linked_list_held_nodes == NULL){
+            linked_list_held_nodes_last = node;
+        }
+
+        node->previous = linked_list_held_nodes;
+        linked_list_held_nodes = node;
+    }else{
+        node->previous = linked_list_free_nodes;
+        linked_list_free_nodes = node;
+    }
+}
+
+
+void linked_list_pool_hold(){
+    linked_list_pool_held = true;
+}
+
+
+void linked_list_pool_release(){
+    linked_list_pool_held = false;
+
+    if(linked_list_held_nodes != NULL){
+        linked_list_held_nodes_last->previous = linked_list_free_nodes;
+        linked_list_free_nodes = linked_list_held_nodes;
+
+        linked_list_held_nodes = NULL;
+        linked_list_held_nodes_last = NULL;
+    }
+}
+
+
 void linked_list_init(linked_list *list) {
     list->start = list->end = NULL;
     list->count = 0;
@@ -11,9 +81,8 @@ void linked_list_init(linked_list *list) {
 
 // Internal function for creating a new 'linked_list_node'
 linked_list_node *setup_new_node(linked_list *list){
-    // Allocate a new node, set defaults
-    linked_list_node *new_node = list->end->next;
-    new_node = malloc(sizeof(linked_list_node));
+    // Get a new node from the pool, set defaults
+    linked_list_node *new_node = linked_list_pool_take();
     new_node->next = NULL;
     new_node->previous = NULL;
     new_node->object = NULL;
@@ -54,7 +123,7 @@ linked_list_node *linked_list_add_obj(linked_list *list, void *obj){
 }
 
 
-// Remove a node from the list and free it
+// Remove a node from the list and give it back to the pool
 void linked_list_del_list_node(linked_list *list, linked_list_node *node){
     ENGINE_INFO_PRINTF("Linked List: removing object");
 
@@ -83,7 +152,7 @@ void linked_list_del_list_node(linked_list *list, linked_list_node *node){
             node->next->previous = node->previous;
         }
 
-        free(node);
+        linked_list_pool_give(node);
     }
 
     // Decrease the count of elemets in this linked list
@@ -6,6 +6,9 @@
 
 #include "debug/debug_print.h"
 
+// How many list nodes are allocated at once when the node pool runs out
+#define LINKED_LIST_POOL_CHUNK_SIZE 64
+
 
 typedef struct linked_list_node{
     void *object;
@@ -28,5 +31,11 @@ linked_list_node *linked_list_add_obj(linked_list *list, void *obj);
 void linked_list_del_list_node(linked_list *list, linked_list_node *node);
 void linked_list_clear(linked_list *list);
 
+// Removed nodes are not reused until `linked_list_pool_release()`, call
+// around passes that follow `next` while running callbacks that may
+// remove (and add) nodes, like everything `engine_tick()` runs
+void linked_list_pool_hold();
+void linked_list_pool_release();
+
 
 #endif  // LINKED_LIST_H